@@ -0,0 +1,1091 @@
+#include <spine/Debug.h>
+#include <spine/spine.h>
+
+#include <chrono>
+#include <stdio.h>
+
+#ifdef MSVC
+#pragma warning(disable : 4710)
+#endif
+
+using namespace spine;
+
+static double nowMs() {
+	using namespace std::chrono;
+	return duration<double, std::milli>(high_resolution_clock::now().time_since_epoch()).count();
+}
+
+/// Generates a skeleton with a chain of numBones bones and numAnimations animations, each of which keys
+/// rotate, translate, scale and shear on every bone.
+static String generateRig(int numBones, int numAnimations, int numKeys) {
+	String json("{\"skeleton\":{\"spine\":\"4.1.00\"},\"bones\":[{\"name\":\"root\"}");
+	char buffer[256];
+	for (int i = 1; i < numBones; i++) {
+		char parent[32];
+		if (i == 1) snprintf(parent, sizeof(parent), "root");
+		else
+			snprintf(parent, sizeof(parent), "b%i", i - 1);
+		snprintf(buffer, sizeof(buffer), ",{\"name\":\"b%i\",\"parent\":\"%s\",\"length\":10,\"x\":10}", i, parent);
+		json.append(buffer);
+	}
+	json.append("],\"animations\":{");
+	for (int a = 0; a < numAnimations; a++) {
+		snprintf(buffer, sizeof(buffer), "%s\"a%i\":{\"bones\":{", a == 0 ? "" : ",", a);
+		json.append(buffer);
+		for (int i = 1; i < numBones; i++) {
+			snprintf(buffer, sizeof(buffer), "%s\"b%i\":{", i == 1 ? "" : ",", i);
+			json.append(buffer);
+			const char *timelines[] = {"rotate", "translate", "scale", "shear"};
+			for (int t = 0; t < 4; t++) {
+				snprintf(buffer, sizeof(buffer), "%s\"%s\":[", t == 0 ? "" : ",", timelines[t]);
+				json.append(buffer);
+				for (int k = 0; k < numKeys; k++) {
+					float time = k / 30.0f, value = (float) ((k * 7 + i + a) % 45);
+					if (t == 0)
+						snprintf(buffer, sizeof(buffer), "%s{\"time\":%f,\"value\":%f}", k == 0 ? "" : ",", time, value);
+					else
+						snprintf(buffer, sizeof(buffer), "%s{\"time\":%f,\"x\":%f,\"y\":%f}", k == 0 ? "" : ",", time,
+								 t == 2 ? 1 + value / 90 : value, t == 2 ? 1 - value / 90 : value);
+					json.append(buffer);
+				}
+				json.append("]");
+			}
+			json.append("}");
+		}
+		json.append("}}");
+	}
+	json.append("}}");
+	return json;
+}
+
+/// Plays a 300 bone rig on 4 tracks and switches the animation on one of the tracks every 10 frames. Reports the
+/// average frame and the worst frame, which is dominated by AnimationState::animationsChanged after setAnimation.
+static void benchmarkSetAnimation() {
+	const int numBones = 300, numAnimations = 8, numFrames = 600;
+	String json = generateRig(numBones, numAnimations, 4);
+	SkeletonJson reader((Atlas *) NULL);
+	SkeletonData *skeletonData = reader.readSkeletonData(json.buffer());
+	assert(skeletonData);
+	Skeleton skeleton(skeletonData);
+	AnimationStateData stateData(skeletonData);
+	stateData.setDefaultMix(0.2f);
+	AnimationState state(&stateData);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	for (int track = 0; track < 4; track++) {
+		state.setAnimation(track, animations[track], true)->setAlpha(0.5f);
+	}
+
+	double total = 0, worst = 0, totalSwitch = 0;
+	int switches = 0;
+	for (int frame = 0; frame < numFrames; frame++) {
+		double start = nowMs();
+		if (frame % 10 == 0) {
+			state.setAnimation(frame % 4, animations[(frame / 10) % numAnimations], true);
+		}
+		state.update(1 / 60.0f);
+		state.apply(skeleton);
+		skeleton.updateWorldTransform();
+		double elapsed = nowMs() - start;
+		total += elapsed;
+		if (elapsed > worst) worst = elapsed;
+		if (frame % 10 == 0) {
+			totalSwitch += elapsed;
+			switches++;
+		}
+	}
+	printf("setAnimation, %i bones, %i timelines per animation: avg frame %.3f ms, avg switch frame %.3f ms, worst frame %.3f ms\n",
+		   numBones, (int) animations[0]->getTimelines().size(), total / numFrames, totalSwitch / switches, worst);
+
+	delete skeletonData;
+}
+
+/// Switches the animations of all 8 tracks of a 300 bone rig every frame, so each track mixes from several entries.
+/// Reports the cost of AnimationState::animationsChanged, which decides how every timeline of every entry is mixed, as
+/// the extra time of the first apply after the switch.
+static void benchmarkTracks() {
+	const int numBones = 300, numAnimations = 8, numTracks = 8, numSwitches = 300;
+	String json = generateRig(numBones, numAnimations, 4);
+	SkeletonJson reader((Atlas *) NULL);
+	SkeletonData *skeletonData = reader.readSkeletonData(json.buffer());
+	assert(skeletonData);
+	Skeleton skeleton(skeletonData);
+	AnimationStateData stateData(skeletonData);
+	stateData.setDefaultMix(0.2f);
+	AnimationState state(&stateData);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+
+	double changed = 0, apply = 0;
+	for (int i = 0; i < numSwitches; i++) {
+		for (int track = 0; track < numTracks; track++)
+			state.setAnimation(track, animations[(i + track) % numAnimations], true)->setAlpha(0.5f);
+		state.update(1 / 60.0f);
+		double start = nowMs();
+		state.apply(skeleton);
+		double middle = nowMs();
+		state.apply(skeleton);
+		double end = nowMs();
+		changed += middle - start;
+		apply += end - middle;
+	}
+	printf("%i tracks, %i timelines per animation: avg apply %.3f ms, avg hold computation %.3f ms\n", numTracks,
+		   (int) animations[0]->getTimelines().size(), apply / numSwitches, (changed - apply) / numSwitches);
+
+	delete skeletonData;
+}
+
+/// Switches between two skins of a rig with hundreds of IK constraints in reverse order, half of which are only active
+/// for one of the skins. Every switch sorts the update cache again.
+static void benchmarkSetSkin() {
+	const int numBones = 400, numConstraints = 300, numSwitches = 1000;
+	String json("{\"skeleton\":{\"spine\":\"4.1.00\"},\"bones\":[{\"name\":\"root\"}");
+	char buffer[256];
+	for (int i = 1; i < numBones; i++) {
+		char parent[32];
+		if (i == 1) snprintf(parent, sizeof(parent), "root");
+		else
+			snprintf(parent, sizeof(parent), "b%i", i - 1);
+		snprintf(buffer, sizeof(buffer), ",{\"name\":\"b%i\",\"parent\":\"%s\",\"length\":10,\"x\":10}", i, parent);
+		json.append(buffer);
+	}
+	json.append("],\"ik\":[");
+	for (int i = 0; i < numConstraints; i++) {
+		snprintf(buffer, sizeof(buffer),
+				 "%s{\"name\":\"ik%i\",\"order\":%i,\"skin\":%s,\"bones\":[\"b%i\"],\"target\":\"b%i\"}",
+				 i == 0 ? "" : ",", i, numConstraints - 1 - i, i % 2 ? "true" : "false", i + 100, i + 1);
+		json.append(buffer);
+	}
+	json.append("],\"skins\":[");
+	for (int skin = 0; skin < 2; skin++) {
+		snprintf(buffer, sizeof(buffer), "%s{\"name\":\"s%i\",\"ik\":[", skin == 0 ? "" : ",", skin);
+		json.append(buffer);
+		for (int i = 1 + skin * 2, first = 1; i < numConstraints; i += 4, first = 0) {
+			snprintf(buffer, sizeof(buffer), "%s\"ik%i\"", first ? "" : ",", i);
+			json.append(buffer);
+		}
+		json.append("],\"attachments\":{}}");
+	}
+	json.append("]}");
+	SkeletonJson reader((Atlas *) NULL);
+	SkeletonData *skeletonData = reader.readSkeletonData(json.buffer());
+	assert(skeletonData);
+	Skeleton skeleton(skeletonData);
+
+	double start = nowMs();
+	for (int i = 0; i < numSwitches; i++)
+		skeleton.setSkin(skeletonData->getSkins()[i % 2]);
+	double elapsed = nowMs() - start;
+	printf("setSkin, %i bones, %i IK constraints: %.4f ms per switch\n", numBones, numConstraints,
+		   elapsed / numSwitches);
+
+	delete skeletonData;
+}
+
+/// A mix-and-match avatar: two skins with many attachments per slot and an animation keying a different attachment of
+/// every slot on every frame. Reports the cost of skin switches and of applying the attachment keys.
+static void benchmarkAvatar() {
+	const int numSlots = 30, numAttachments = 100, numKeys = 60, numFrames = 6000;
+	String json("{\"skeleton\":{\"spine\":\"4.1.00\"},\"bones\":[{\"name\":\"root\"}],\"slots\":[");
+	char buffer[256];
+	for (int i = 0; i < numSlots; i++) {
+		snprintf(buffer, sizeof(buffer), "%s{\"name\":\"slot%i\",\"bone\":\"root\",\"attachment\":\"a%i\"}",
+				 i == 0 ? "" : ",", i, numAttachments - 1);
+		json.append(buffer);
+	}
+	json.append("],\"skins\":[");
+	for (int skin = 0; skin < 2; skin++) {
+		snprintf(buffer, sizeof(buffer), "%s{\"name\":\"s%i\",\"attachments\":{", skin == 0 ? "" : ",", skin);
+		json.append(buffer);
+		for (int i = 0; i < numSlots; i++) {
+			snprintf(buffer, sizeof(buffer), "%s\"slot%i\":{", i == 0 ? "" : ",", i);
+			json.append(buffer);
+			for (int ii = 0; ii < numAttachments; ii++) {
+				snprintf(buffer, sizeof(buffer), "%s\"a%i\":{\"type\":\"point\"}", ii == 0 ? "" : ",", ii);
+				json.append(buffer);
+			}
+			json.append("}");
+		}
+		json.append("}}");
+	}
+	json.append("],\"animations\":{\"swap\":{\"slots\":{");
+	for (int i = 0; i < numSlots; i++) {
+		snprintf(buffer, sizeof(buffer), "%s\"slot%i\":{\"attachment\":[", i == 0 ? "" : ",", i);
+		json.append(buffer);
+		for (int k = 0; k < numKeys; k++) {
+			snprintf(buffer, sizeof(buffer), "%s{\"time\":%f,\"name\":\"a%i\"}", k == 0 ? "" : ",", k / 60.0f,
+					 (k * 37 + i) % numAttachments);
+			json.append(buffer);
+		}
+		json.append("]}");
+	}
+	json.append("}}}}");
+	SkeletonJson reader((Atlas *) NULL);
+	SkeletonData *skeletonData = reader.readSkeletonData(json.buffer());
+	assert(skeletonData);
+	Skeleton skeleton(skeletonData);
+	Animation *animation = skeletonData->findAnimation("swap");
+
+	double start = nowMs();
+	for (int i = 0; i < 1000; i++)
+		skeleton.setSkin(skeletonData->getSkins()[i % 2]);
+	double switchTime = (nowMs() - start) / 1000;
+	start = nowMs();
+	for (int frame = 0; frame < numFrames; frame++) {
+		float time = (frame % numKeys) / 60.0f;
+		animation->apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+	}
+	double applyTime = (nowMs() - start) / numFrames;
+	printf("avatar, %i slots with %i attachments per skin: setSkin %.4f ms, apply %.4f ms\n", numSlots, numAttachments,
+		   switchTime, applyTime);
+
+	delete skeletonData;
+}
+
+/// Thousands of mix-and-match characters equipping outfits picked from a few popular choices per category. Compares
+/// building each character's skin with Skin::addSkin() against looking it up in a SkinCache.
+static void benchmarkSkinCache() {
+	const char *categories[] = {"nose/", "eyes/", "hair/", "clothes/", "legs/", "accessories/"};
+	const int numCategories = 6, numChoices = 3, numPlayers = 5000;
+	Atlas atlas("testdata/mix-and-match/mix-and-match.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/mix-and-match/mix-and-match-pro.skel");
+	assert(skeletonData);
+	Vector<Skin *> choices[numCategories];
+	Vector<Skin *> &skins = skeletonData->getSkins();
+	for (int i = 0; i < numCategories; i++)
+		for (size_t ii = 0; ii < skins.size() && (int) choices[i].size() < numChoices; ii++)
+			if (String(skins[ii]->getName()).startsWith(categories[i])) choices[i].add(skins[ii]);
+	Vector<Skin *> outfits[numPlayers];
+	unsigned int seed = 1;
+	for (int i = 0; i < numPlayers; i++) {
+		outfits[i].add(skeletonData->findSkin("skin-base"));
+		for (int ii = 0; ii < numCategories; ii++) {
+			seed = seed * 1103515245 + 12345;
+			outfits[i].add(choices[ii][(seed >> 16) % choices[ii].size()]);
+		}
+	}
+	Skeleton skeleton(skeletonData);
+
+	double start = nowMs();
+	Skin *previous = NULL;
+	for (int i = 0; i < numPlayers; i++) {
+		Skin *skin = new (__FILE__, __LINE__) Skin("outfit");
+		for (size_t ii = 0; ii < outfits[i].size(); ii++)
+			skin->addSkin(outfits[i][ii]);
+		skeleton.setSkin(skin);
+		delete previous;
+		previous = skin;
+	}
+	double buildTime = (nowMs() - start) / numPlayers;
+	skeleton.setSkin(NULL);
+	delete previous;
+
+	SkinCache cache(skeletonData);
+	start = nowMs();
+	for (int i = 0; i < numPlayers; i++)
+		skeleton.setSkin(cache.getSkin(outfits[i]));
+	double cacheTime = (nowMs() - start) / numPlayers;
+	printf("skin cache, %i players, %i outfits: addSkin %.4f ms, cached %.4f ms per player\n", numPlayers,
+		   (int) cache.getSkinCount(), buildTime, cacheTime);
+
+	skeleton.setSkin(NULL);
+	delete skeletonData;
+}
+
+/// Plays a long generated animation with many keys per timeline from start to end, which stresses the keyframe search.
+static void benchmarkLongAnimation() {
+	const int numBones = 50, numKeys = 3000;
+	String json = generateRig(numBones, 1, numKeys);
+	SkeletonJson reader((Atlas *) NULL);
+	SkeletonData *skeletonData = reader.readSkeletonData(json.buffer());
+	assert(skeletonData);
+	Skeleton skeleton(skeletonData);
+	AnimationStateData stateData(skeletonData);
+	AnimationState state(&stateData);
+	state.setAnimation(0, skeletonData->getAnimations()[0], false);
+
+	int numFrames = (int) (skeletonData->getAnimations()[0]->getDuration() * 60);
+	double start = nowMs();
+	for (int frame = 0; frame < numFrames; frame++) {
+		state.update(1 / 60.0f);
+		state.apply(skeleton);
+	}
+	double elapsed = nowMs() - start;
+	printf("long animation, %i bones, %i keys per timeline: avg apply %.4f ms\n", numBones, numKeys,
+		   elapsed / numFrames);
+
+	delete skeletonData;
+}
+
+/// Plays every animation of the example skeletons for 10 seconds each.
+static void benchmarkExamples() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+		if (!skeletonData) {
+			printf("Couldn't load %s\n", skeletonFile);
+			continue;
+		}
+		Skeleton skeleton(skeletonData);
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		double elapsed = 0;
+		int numFrames = 0;
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			state.setAnimation(0, animations[ii], true);
+			double start = nowMs();
+			for (int frame = 0; frame < 600; frame++, numFrames++) {
+				state.update(1 / 60.0f);
+				state.apply(skeleton);
+				skeleton.updateWorldTransform();
+			}
+			elapsed += nowMs() - start;
+		}
+		printf("%s, %i animations: avg frame %.4f ms\n", names[i], (int) animations.size(), elapsed / numFrames);
+		delete skeletonData;
+	}
+}
+
+/// Tracks the bytes and number of allocations made through the extension, storing each size in a header.
+class CountingExtension : public DefaultSpineExtension {
+public:
+	CountingExtension() : liveBytes(0), peakBytes(0), allocations(0) {
+	}
+
+	size_t liveBytes, peakBytes, allocations;
+
+protected:
+	static const size_t HEADER = 16;
+
+	virtual void *_alloc(size_t size, const char *file, int line) override {
+		if (size == 0) return NULL;
+		char *mem = (char *) DefaultSpineExtension::_alloc(size + HEADER, file, line);
+		*(size_t *) mem = size;
+		liveBytes += size;
+		if (liveBytes > peakBytes) peakBytes = liveBytes;
+		allocations++;
+		return mem + HEADER;
+	}
+
+	virtual void *_calloc(size_t size, const char *file, int line) override {
+		if (size == 0) return NULL;
+		char *mem = (char *) DefaultSpineExtension::_calloc(size + HEADER, file, line);
+		*(size_t *) mem = size;
+		liveBytes += size;
+		if (liveBytes > peakBytes) peakBytes = liveBytes;
+		allocations++;
+		return mem + HEADER;
+	}
+
+	virtual void *_realloc(void *ptr, size_t size, const char *file, int line) override {
+		if (!ptr) return _alloc(size, file, line);
+		char *mem = (char *) ptr - HEADER;
+		liveBytes -= *(size_t *) mem;
+		mem = (char *) DefaultSpineExtension::_realloc(mem, size + HEADER, file, line);
+		*(size_t *) mem = size;
+		liveBytes += size;
+		if (liveBytes > peakBytes) peakBytes = liveBytes;
+		allocations++;
+		return mem + HEADER;
+	}
+
+	virtual void _free(void *ptr, const char *file, int line) override {
+		if (!ptr) return;
+		char *mem = (char *) ptr - HEADER;
+		liveBytes -= *(size_t *) mem;
+		DefaultSpineExtension::_free(mem, file, line);
+	}
+};
+
+static CountingExtension *counting;
+
+/// Loads copies of the example skeletons with and without an arena, keeping them alive to measure their memory.
+static void benchmarkArenaLoading() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	const int copies = 50;
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		int length;
+		unsigned char *file = (unsigned char *) SpineExtension::readFile(skeletonFile, &length);
+		if (!file) {
+			printf("Couldn't load %s\n", skeletonFile);
+			continue;
+		}
+
+		for (int useArena = 0; useArena < 2; useArena++) {
+			SkeletonBinary binary(&atlas);
+			binary.setUseArena(useArena != 0);
+			Vector<SkeletonData *> datas;
+			datas.ensureCapacity(copies);
+			size_t bytes = counting->liveBytes, allocations = counting->allocations;
+			double start = nowMs();
+			for (int ii = 0; ii < copies; ii++)
+				datas.add(binary.readSkeletonData(file, length));
+			double load = nowMs() - start;
+			bytes = counting->liveBytes - bytes;
+			allocations = counting->allocations - allocations;
+			start = nowMs();
+			ContainerUtil::cleanUpVectorOfPointers(datas);
+			double dispose = nowMs() - start;
+			printf("%s%s: load %.3f ms, delete %.3f ms, %d KB in %d allocations per copy\n", names[i],
+				   useArena ? " (arena)" : "", load / copies, dispose / copies, (int) (bytes / copies / 1024),
+				   (int) (allocations / copies));
+		}
+		SpineExtension::free(file, __FILE__, __LINE__);
+	}
+}
+
+/// Loads the example skeleton files by reading and by mapping them, measuring the peak heap memory of a load.
+static void benchmarkMappedLoading() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	const char *modes[] = {"read", "mapped", "mapped, arena"};
+	const int copies = 50;
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		for (int mode = 0; mode < 3; mode++) {
+			SkeletonBinary binary(&atlas);
+			binary.setUseMappedFile(mode > 0);
+			binary.setUseArena(mode == 2);
+			double load = 0;
+			size_t peak = 0;
+			for (int ii = 0; ii < copies; ii++) {
+				size_t bytes = counting->peakBytes = counting->liveBytes;
+				double start = nowMs();
+				SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+				load += nowMs() - start;
+				peak = MathUtil::max(peak, counting->peakBytes - bytes);
+				delete data;
+			}
+			printf("%s (%s): load %.3f ms, peak %d KB\n", names[i], modes[mode], load / copies, (int) (peak / 1024));
+		}
+	}
+}
+
+/// Compares loading the example skeletons with all animations decoded to loading them lazily, then decoding each
+/// animation on first use.
+static void benchmarkLazyAnimations() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	const int copies = 50;
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		int length;
+		unsigned char *file = (unsigned char *) SpineExtension::readFile(skeletonFile, &length);
+		if (!file) {
+			printf("Couldn't load %s\n", skeletonFile);
+			continue;
+		}
+
+		for (int lazy = 0; lazy < 2; lazy++) {
+			SkeletonBinary binary(&atlas);
+			binary.setLazyAnimations(lazy != 0);
+			Vector<SkeletonData *> datas;
+			datas.ensureCapacity(copies);
+			size_t base = counting->liveBytes;
+			double start = nowMs();
+			for (int ii = 0; ii < copies; ii++)
+				datas.add(binary.readSkeletonData(file, length));
+			double load = nowMs() - start;
+			printf("%s%s: load %.3f ms, %d KB per copy", names[i], lazy ? " (lazy)" : "", load / copies,
+				   (int) ((counting->liveBytes - base) / copies / 1024));
+			if (lazy) {
+				start = nowMs();
+				for (int ii = 0; ii < copies; ii++) {
+					Vector<Animation *> &animations = datas[ii]->getAnimations();
+					for (size_t iii = 0; iii < animations.size(); iii++)
+						animations[iii]->load();
+				}
+				printf(", decoding %d animations %.3f ms, %d KB after", (int) datas[0]->getAnimations().size(),
+					   (nowMs() - start) / copies, (int) ((counting->liveBytes - base) / copies / 1024));
+			}
+			printf("\n");
+			ContainerUtil::cleanUpVectorOfPointers(datas);
+		}
+		SpineExtension::free(file, __FILE__, __LINE__);
+	}
+}
+
+/// Measures the memory of the decoded animations of the example skeletons before and after compressing them, and the
+/// cost of applying them.
+static void benchmarkCompression() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+		binary.setLazyAnimations(true);
+		SkeletonData *compressedData = binary.readSkeletonDataFile(skeletonFile);
+		if (!skeletonData || !compressedData) {
+			printf("Couldn't load %s\n", skeletonFile);
+			delete skeletonData;
+			delete compressedData;
+			continue;
+		}
+
+		// Decoding lazily loaded animations allocates only their timelines.
+		Vector<Animation *> &animations = compressedData->getAnimations();
+		size_t bytes = 0, compressedBytes = 0;
+		float error = 0;
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			size_t live = counting->liveBytes;
+			animations[ii]->load();
+			bytes += counting->liveBytes - live;
+			error = MathUtil::max(error, animations[ii]->compress());
+			compressedBytes += counting->liveBytes - live;
+		}
+
+		double elapsed[2] = {0, 0};
+		SkeletonData *datas[] = {skeletonData, compressedData};
+		for (int compressed = 0; compressed < 2; compressed++) {
+			Skeleton skeleton(datas[compressed]);
+			Vector<Animation *> &dataAnimations = datas[compressed]->getAnimations();
+			double start = nowMs();
+			for (size_t ii = 0; ii < dataAnimations.size(); ii++) {
+				for (int frame = 0; frame < 600; frame++) {
+					float time = frame / 60.0f;
+					dataAnimations[ii]->apply(skeleton, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+				}
+			}
+			elapsed[compressed] = (nowMs() - start) / (600.0 * dataAnimations.size());
+		}
+		printf("%s, %d animations: %.1f KB, compressed %.1f KB (%.1fx), max error %g; apply %.4f ms, compressed "
+			   "%.4f ms\n",
+			   names[i], (int) animations.size(), bytes / 1024.0, compressedBytes / 1024.0,
+			   (double) bytes / compressedBytes, error, elapsed[0], elapsed[1]);
+		delete skeletonData;
+		delete compressedData;
+	}
+}
+
+/// Parses the example JSON skeletons into a Json document, and loads them with SkeletonJson, measuring the peak heap
+/// memory of a load.
+static void benchmarkJsonLoading() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	const int copies = 20;
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.json", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		int length;
+		char *file = SpineExtension::readFile(skeletonFile, &length);
+		if (!file) {
+			printf("Couldn't load %s\n", skeletonFile);
+			continue;
+		}
+		char *text = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
+		memcpy(text, file, length);
+		SpineExtension::free(file, __FILE__, __LINE__);
+
+		size_t base = counting->peakBytes = counting->liveBytes;
+		size_t allocations = counting->allocations;
+		double start = nowMs();
+		for (int ii = 0; ii < copies; ii++)
+			delete new (__FILE__, __LINE__) Json(text);
+		double parse = nowMs() - start;
+		size_t parsePeak = counting->peakBytes - base;
+		allocations = (counting->allocations - allocations) / copies;
+
+		SkeletonJson json(&atlas);
+		double load = 0;
+		size_t loadPeak = 0;
+		for (int ii = 0; ii < copies; ii++) {
+			base = counting->peakBytes = counting->liveBytes;
+			start = nowMs();
+			SkeletonData *data = json.readSkeletonDataFile(skeletonFile);
+			load += nowMs() - start;
+			loadPeak = MathUtil::max(loadPeak, counting->peakBytes - base);
+			delete data;
+		}
+		printf("%s JSON, %d KB: parse %.3f ms, peak %d KB, %d allocations, load %.3f ms, peak %d KB\n", names[i],
+			   length / 1024, parse / copies, (int) (parsePeak / 1024), (int) allocations, load / copies,
+			   (int) (loadPeak / 1024));
+		SpineExtension::free(text, __FILE__, __LINE__);
+	}
+}
+
+/// Uses the atlas pages as textures, so render commands are split by page like with a real backend.
+class PageTextureLoader : public TextureLoader {
+public:
+	virtual void load(AtlasPage &page, const String &path) {
+		SP_UNUSED(path);
+		page.setRendererObject(&page);
+	}
+
+	virtual void unload(void *texture) {
+		SP_UNUSED(texture);
+	}
+};
+
+/// Builds render commands for the examples while playing their animations.
+static void benchmarkRenderer() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		PageTextureLoader textureLoader;
+		Atlas atlas(atlasFile, &textureLoader);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+		if (!skeletonData) {
+			printf("Couldn't load %s\n", skeletonFile);
+			continue;
+		}
+		Skeleton skeleton(skeletonData);
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+		SkeletonRenderer renderer;
+
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		double elapsed = 0;
+		int numFrames = 0, numCommands = 0, numVertices = 0;
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			state.setAnimation(0, animations[ii], true);
+			for (int frame = 0; frame < 600; frame++, numFrames++) {
+				state.update(1 / 60.0f);
+				state.apply(skeleton);
+				skeleton.updateWorldTransform();
+				double start = nowMs();
+				Vector<RenderCommand> &commands = renderer.render(skeleton);
+				elapsed += nowMs() - start;
+				numCommands += (int) commands.size();
+				for (size_t iii = 0; iii < commands.size(); iii++)
+					numVertices += commands[iii].numVertices;
+			}
+		}
+		printf("%s, %i slots: render %.4f ms, avg %.1f commands, %i vertices\n", names[i],
+			   (int) skeleton.getSlots().size(), elapsed / numFrames, numCommands / (double) numFrames,
+			   numVertices / numFrames);
+		delete skeletonData;
+	}
+}
+
+/// Computes the world vertices of the weighted meshes while playing every animation, decoding the bones and vertices and
+/// with the fixed width skinning layout.
+static void benchmarkSkinning() {
+	const char *names[] = {"raptor", "goblins", "stretchyman", "tank"};
+	for (int i = 0; i < 4; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		double elapsed[2] = {0, 0};
+		int numVertices = 0;
+		for (int layout = 0; layout < 2; layout++) {
+			SkeletonBinary binary(&atlas);
+			binary.setSkinningLayout(layout == 1);
+			SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+			if (!skeletonData) {
+				printf("Couldn't load %s\n", skeletonFile);
+				break;
+			}
+			Skeleton skeleton(skeletonData);
+			skeleton.setSkin(skeletonData->getSkins().size() > 1 ? skeletonData->getSkins()[1] : NULL);
+			Vector<float> worldVertices;
+			Vector<Animation *> &animations = skeletonData->getAnimations();
+			numVertices = 0;
+			for (size_t ii = 0; ii < animations.size(); ii++) {
+				for (int frame = 0; frame < 100; frame++) {
+					skeleton.setToSetupPose();
+					animations[ii]->apply(skeleton, 0, frame / 60.0f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+					skeleton.updateWorldTransform();
+					double start = nowMs();
+					for (size_t iii = 0; iii < skeleton.getSlots().size(); iii++) {
+						Slot &slot = *skeleton.getSlots()[iii];
+						Attachment *attachment = slot.getAttachment();
+						if (!attachment || !attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+						MeshAttachment *mesh = (MeshAttachment *) attachment;
+						if (mesh->getBones().size() == 0) continue;
+						worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+						mesh->computeWorldVertices(slot, worldVertices);
+						numVertices += (int) worldVertices.size() >> 1;
+					}
+					elapsed[layout] += nowMs() - start;
+				}
+			}
+			delete skeletonData;
+		}
+		printf("%s, %i weighted vertices: skinning %.2f ms, with layout %.2f ms\n", names[i], numVertices, elapsed[0],
+			   elapsed[1]);
+	}
+}
+
+/// A lobby of raptors of which most hold the last pose of a finished animation and every tenth loops one. Updates and
+/// renders each frame with and without change tracking.
+static void benchmarkChangeTracking() {
+	const int numSkeletons = 200, numFrames = 120;
+	PageTextureLoader textureLoader;
+	Atlas atlas("testdata/raptor/raptor.atlas", &textureLoader);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	if (!skeletonData) {
+		printf("Couldn't load raptor\n");
+		return;
+	}
+	AnimationStateData stateData(skeletonData);
+	for (int tracking = 0; tracking < 2; tracking++) {
+		Vector<Skeleton *> skeletons;
+		Vector<AnimationState *> states;
+		Vector<SkeletonRenderer *> renderers;
+		for (int i = 0; i < numSkeletons; i++) {
+			Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+			skeleton->setUseChangeTracking(tracking == 1);
+			renderers.add(new (__FILE__, __LINE__) SkeletonRenderer());
+			AnimationState *state = new (__FILE__, __LINE__) AnimationState(&stateData);
+			state->setAnimation(0, "walk", i % 10 == 0);
+			state->update(10);
+			skeletons.add(skeleton);
+			states.add(state);
+		}
+		double start = nowMs();
+		for (int frame = 0; frame < numFrames; frame++) {
+			for (int i = 0; i < numSkeletons; i++) {
+				states[i]->update(1 / 60.0f);
+				states[i]->apply(*skeletons[i]);
+				skeletons[i]->updateWorldTransform();
+				renderers[i]->render(*skeletons[i]);
+			}
+		}
+		double elapsed = nowMs() - start;
+		if (tracking) {
+			int bonesUpdated = 0, bonesSkipped = 0, verticesComputed = 0, verticesReused = 0;
+			for (int i = 0; i < numSkeletons; i++) {
+				ChangeTracker &tracker = *skeletons[i]->getChangeTracker();
+				bonesUpdated += tracker.getBonesUpdated();
+				bonesSkipped += tracker.getBonesSkipped();
+				verticesComputed += tracker.getVerticesComputed();
+				verticesReused += tracker.getVerticesReused();
+			}
+			printf("Lobby of %i raptors with change tracking: %.3f ms per frame, %.1f%% of bones and %.1f%% of vertices "
+				   "skipped\n",
+				   numSkeletons, elapsed / numFrames, 100.0 * bonesSkipped / (bonesUpdated + bonesSkipped),
+				   100.0 * verticesReused / (verticesComputed + verticesReused));
+		} else
+			printf("Lobby of %i raptors: %.3f ms per frame\n", numSkeletons, elapsed / numFrames);
+		for (int i = 0; i < numSkeletons; i++) {
+			delete skeletons[i];
+			delete states[i];
+			delete renderers[i];
+		}
+	}
+	delete skeletonData;
+}
+
+/// Bakes all animations of the example rigs at 30 frames per second and compares the size of the tables and the cost of
+/// posing a skeleton from them against Animation::apply().
+static void benchmarkBaking() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	const float fps = 30;
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+		if (!skeletonData) {
+			printf("Couldn't load %s\n", skeletonFile);
+			continue;
+		}
+		AnimationBaker baker(skeletonData);
+		Skeleton skeleton(skeletonData);
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		double applyTime = 0, localTime = 0, worldTime = 0;
+		size_t localBytes = 0, worldBytes = 0;
+		float duration = 0;
+		int numFrames = 0;
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			Animation &animation = *animations[ii];
+			BakedAnimation *local = baker.bake(animation, fps, false);
+			BakedAnimation *world = baker.bake(animation, fps, true);
+			localBytes += local->getMemorySize();
+			worldBytes += world->getMemorySize();
+			duration += animation.getDuration();
+
+			double start = nowMs();
+			for (int frame = 0; frame < 600; frame++) {
+				float time = frame / 60.0f;
+				animation.apply(skeleton, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+				skeleton.updateWorldTransform();
+			}
+			applyTime += nowMs() - start;
+			start = nowMs();
+			for (int frame = 0; frame < 600; frame++) {
+				local->apply(skeleton, frame / 60.0f, true, true);
+				skeleton.updateWorldTransform();
+			}
+			localTime += nowMs() - start;
+			start = nowMs();
+			for (int frame = 0; frame < 600; frame++)
+				world->apply(skeleton, frame / 60.0f, true, true);
+			worldTime += nowMs() - start;
+			numFrames += 600;
+			delete local;
+			delete world;
+		}
+		if (duration == 0) duration = 1;
+		printf("%s, baked at %.0f fps: local %.1f KB/s, world %.1f KB/s; avg frame apply %.4f ms, local %.4f ms, world "
+			   "%.4f ms\n",
+			   names[i], fps, localBytes / 1024.0 / duration, worldBytes / 1024.0 / duration, applyTime / numFrames,
+			   localTime / numFrames, worldTime / numFrames);
+		delete skeletonData;
+	}
+}
+
+/// A marching army: skeletons walking in step, applied by their animation states with and without a shared pose cache,
+/// and from a cache storing world transforms.
+static void benchmarkPoseCache() {
+	const int numSkeletons = 1000, numFrames = 60;
+	Atlas atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	if (!skeletonData) {
+		printf("Couldn't load spineboy\n");
+		return;
+	}
+	AnimationStateData stateData(skeletonData);
+	Animation *walk = skeletonData->findAnimation("walk");
+	PoseCache cache, worldCache(0, true);
+	Vector<Skeleton *> skeletons;
+	Vector<AnimationState *> states;
+	for (int i = 0; i < numSkeletons; i++) {
+		skeletons.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+		states.add(new (__FILE__, __LINE__) AnimationState(&stateData));
+		states[i]->setAnimation(0, walk, true);
+	}
+
+	double times[3];
+	for (int mode = 0; mode < 3; mode++) {
+		double start = nowMs();
+		for (int frame = 0; frame < numFrames; frame++) {
+			// Clearing every frame keeps only the poses of the current time.
+			cache.clear();
+			worldCache.clear();
+			for (int i = 0; i < numSkeletons; i++) {
+				if (mode == 2) {
+					worldCache.apply(*skeletons[i], *walk, frame / 30.0f, true);
+					continue;
+				}
+				states[i]->setPoseCache(mode == 1 ? &cache : NULL);
+				states[i]->update(1 / 30.0f);
+				states[i]->apply(*skeletons[i]);
+				skeletons[i]->updateWorldTransform();
+			}
+		}
+		times[mode] = (nowMs() - start) / numFrames;
+	}
+	printf("pose cache, %i spineboys walking in step: serial %.3f ms, cached %.3f ms, cached world %.3f ms per frame\n",
+		   numSkeletons, times[0], times[1], times[2]);
+
+	ContainerUtil::cleanUpVectorOfPointers(states);
+	ContainerUtil::cleanUpVectorOfPointers(skeletons);
+	delete skeletonData;
+}
+
+/// Evaluates sines and cosines of an array of angles with both precisions, one at a time and with the array variant.
+static void benchmarkTrig() {
+	const int count = 4096, repeats = 500;
+	Vector<float> degrees, sines, cosines;
+	degrees.setSize(count, 0);
+	sines.setSize(count, 0);
+	cosines.setSize(count, 0);
+	for (int i = 0; i < count; i++)
+		degrees[i] = -720 + 1440 * MathUtil::random();
+
+	MathPrecision precisions[] = {MathPrecision_Precise, MathPrecision_Fast};
+	for (int i = 0; i < 2; i++) {
+		MathUtil::setPrecision(precisions[i]);
+		float sum = 0;
+		double start = nowMs();
+		for (int ii = 0; ii < repeats; ii++) {
+			float *d = degrees.buffer(), *sin = sines.buffer(), *cos = cosines.buffer();
+			for (int iii = 0; iii < count; iii++)
+				MathUtil::sinCosDeg(d[iii], sin[iii], cos[iii]);
+			sum += sines[ii] + cosines[ii];
+		}
+		double single = nowMs() - start;
+		start = nowMs();
+		for (int ii = 0; ii < repeats; ii++) {
+			MathUtil::sinCosDeg(degrees.buffer(), sines.buffer(), cosines.buffer(), count);
+			sum += sines[ii] + cosines[ii];
+		}
+		double batch = nowMs() - start;
+		printf("sinCosDeg, %s: %.2f ns per angle, array variant %.2f ns per angle (%g)\n",
+			   i == 0 ? "precise" : "fast", single * 1e6 / count / repeats, batch * 1e6 / count / repeats, sum);
+	}
+	MathUtil::setPrecision(MathPrecision_Precise);
+}
+
+/// Updates the world transforms of a crowd of skeletons with and without the SkeletonPose kernel.
+static void benchmarkWorldTransform() {
+	const int numSkeletons = 200;
+	String json = generateRig(300, 1, 4);
+	SkeletonJson reader((Atlas *) NULL);
+	SkeletonData *skeletonData = reader.readSkeletonData(json.buffer());
+	assert(skeletonData);
+	Vector<Skeleton *> skeletons;
+	for (int i = 0; i < numSkeletons; i++) {
+		Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+		skeletonData->getAnimations()[0]->apply(*skeleton, 0, i / 60.0f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		skeletons.add(skeleton);
+	}
+
+	for (int usePose = 0; usePose < 2; usePose++) {
+		for (int i = 0; i < numSkeletons; i++)
+			skeletons[i]->setUseSkeletonPose(usePose != 0);
+		double start = nowMs();
+		for (int frame = 0; frame < 100; frame++) {
+			for (int i = 0; i < numSkeletons; i++)
+				skeletons[i]->updateWorldTransform();
+		}
+		double elapsed = nowMs() - start;
+		printf("updateWorldTransform, %i skeletons with 300 bones%s: %.3f ms per frame\n", numSkeletons,
+			   usePose ? ", SkeletonPose" : "", elapsed / 100);
+	}
+
+	ContainerUtil::cleanUpVectorOfPointers(skeletons);
+	delete skeletonData;
+}
+
+/// Folds every listener callback into an order sensitive hash, to check that event delivery is deterministic.
+class EventRecorder : public AnimationStateListenerObject {
+public:
+	EventRecorder() : hash(17) {
+	}
+
+	unsigned int hash;
+
+	virtual void callback(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
+		SP_UNUSED(entry);
+		hash = hash * 31 + (unsigned int) (size_t) state->getRendererObject();
+		hash = hash * 31 + (unsigned int) type;
+		if (event) hash = hash * 31 + (unsigned int) event->getData().getName().length();
+	}
+};
+
+/// Plays spineboy on a crowd of skeletons, updating them serially on one thread and with a CrowdUpdater.
+static void benchmarkCrowd() {
+	const int numSkeletons = 5000, numFrames = 60;
+	Atlas atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	if (!skeletonData) {
+		printf("Couldn't load spineboy\n");
+		return;
+	}
+	AnimationStateData stateData(skeletonData);
+	stateData.setDefaultMix(0.2f);
+	const char *animations[] = {"walk", "run", "jump", "shoot"};
+
+	float serialX = 0, crowdX = 0;
+	unsigned int serialHash = 0, crowdHash = 0;
+	for (int useCrowd = 0; useCrowd < 2; useCrowd++) {
+		EventRecorder recorder;
+		Vector<Skeleton *> skeletons;
+		Vector<AnimationState *> states;
+		ThreadPoolExecutor executor(4);
+		CrowdUpdater crowd(&executor);
+		for (int i = 0; i < numSkeletons; i++) {
+			Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+			AnimationState *state = new (__FILE__, __LINE__) AnimationState(&stateData);
+			state->setRendererObject((void *) (size_t) (i + 1));
+			state->setListener(&recorder);
+			state->setAnimation(0, animations[i % 4], (i & 4) == 0);
+			state->addAnimation(0, animations[(i + 1) % 4], true, 0.1f + (i % 7) * 0.05f);
+			skeletons.add(skeleton);
+			states.add(state);
+			crowd.add(skeleton, state);
+		}
+
+		double start = nowMs();
+		for (int frame = 0; frame < numFrames; frame++) {
+			if (useCrowd)
+				crowd.update(1 / 30.0f);
+			else {
+				for (int i = 0; i < numSkeletons; i++) {
+					states[i]->update(1 / 30.0f);
+					states[i]->apply(*skeletons[i]);
+					skeletons[i]->updateWorldTransform();
+				}
+			}
+		}
+		double elapsed = nowMs() - start;
+
+		float x = 0;
+		for (int i = 0; i < numSkeletons; i++)
+			x += skeletons[i]->getBones()[skeletons[i]->getBones().size() - 1]->getWorldX();
+		if (useCrowd) {
+			crowdX = x;
+			crowdHash = recorder.hash;
+			printf("crowd, %i spineboys, CrowdUpdater with %i threads: %.3f ms per frame\n", numSkeletons,
+				   executor.getNumThreads(), elapsed / numFrames);
+		} else {
+			serialX = x;
+			serialHash = recorder.hash;
+			printf("crowd, %i spineboys, serial: %.3f ms per frame\n", numSkeletons, elapsed / numFrames);
+		}
+
+		ContainerUtil::cleanUpVectorOfPointers(states);
+		ContainerUtil::cleanUpVectorOfPointers(skeletons);
+	}
+	if (serialX != crowdX || serialHash != crowdHash) printf("crowd: results differ from the serial update\n");
+	assert(serialX == crowdX && serialHash == crowdHash);
+
+	delete skeletonData;
+}
+
+namespace spine {
+	SpineExtension *getDefaultExtension() {
+		counting = new CountingExtension();
+		return counting;
+	}
+}// namespace spine
+
+int main(int argc, char **argv) {
+	SP_UNUSED(argc);
+	SP_UNUSED(argv);
+
+	benchmarkSetAnimation();
+	benchmarkTracks();
+	benchmarkSetSkin();
+	benchmarkAvatar();
+	benchmarkSkinCache();
+	benchmarkLongAnimation();
+	benchmarkExamples();
+	benchmarkWorldTransform();
+	benchmarkArenaLoading();
+	benchmarkMappedLoading();
+	benchmarkLazyAnimations();
+	benchmarkCompression();
+	benchmarkJsonLoading();
+	benchmarkRenderer();
+	benchmarkSkinning();
+	benchmarkChangeTracking();
+	benchmarkBaking();
+	benchmarkPoseCache();
+	benchmarkTrig();
+	MathUtil::setPrecision(MathPrecision_Fast);
+	printf("With MathPrecision_Fast:\n");
+	benchmarkExamples();
+	benchmarkWorldTransform();
+	MathUtil::setPrecision(MathPrecision_Precise);
+	benchmarkCrowd();
+}
@@ -1,5 +1,6 @@
 #include <spine/Debug.h>
 #include <spine/spine.h>
+#include <math.h>
 #include <stdio.h>
 
 #ifdef MSVC
@@ -98,6 +99,1388 @@ void testLoading() {
 	}
 }
 
+/// Checks Animation::search against a linear search, with and without a search cursor.
+void testSearch() {
+	Vector<float> frames;
+	float time = 0;
+	for (int i = 0; i < 300; i++) {
+		frames.add(time);
+		if (i % 7 != 3) time += (float) (i % 5) * 0.1f;
+	}
+
+	int cursor = 0;
+	for (int step = 1; step <= 3; step++) {
+		for (int useCursor = 0; useCursor < 2; useCursor++) {
+			for (int i = -10; i < 1000; i++) {
+				float target = i * 0.031f * (i % 11 == 0 ? 0.5f : 1);
+				size_t n = frames.size(), expected = n - step;
+				for (size_t ii = step; ii < n; ii += step) {
+					if (frames[ii] > target) {
+						expected = ii - step;
+						break;
+					}
+				}
+				int actual = Animation::search(frames, target, step, useCursor ? &cursor : NULL);
+				if (actual != (int) expected) {
+					printf("Animation::search mismatch, step %i, target %f: %i != %i\n", step, target, actual,
+						   (int) expected);
+					assert(false);
+				}
+			}
+		}
+	}
+}
+
+void testJsonIndex() {
+	// Objects with many children are looked up by name in an index, ignoring case and finding the first of duplicates.
+	for (int count = 1; count < 100; count += 7) {
+		String text("{");
+		char item[64];
+		for (int i = 0; i < count; i++) {
+			snprintf(item, sizeof(item), "%s\"Key%i\": %i", i ? ", " : "", i, i);
+			text.append(item);
+		}
+		text.append(", \"key0\": -1}");
+		Json json(text.buffer());
+		for (int i = 0; i < count; i++) {
+			snprintf(item, sizeof(item), i % 2 ? "key%i" : "KEY%i", i);
+			assert(Json::getInt(&json, item, -2) == i);
+		}
+		assert(!Json::getItem(&json, "key"));
+		assert(!Json::getItem(&json, "missing"));
+		assert(Json::getItem(&json, "") == NULL);
+	}
+}
+
+/// Overrides only Timeline::apply(), as timelines outside the runtime do, and counts its applications.
+class CountingTimeline : public Timeline {
+public:
+	CountingTimeline() : Timeline(1, 1), count(0) {
+		PropertyId ids[] = {(PropertyId) 1 << 40};
+		setPropertyIds(ids, 1);
+	}
+
+	virtual void apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+					   MixBlend blend, MixDirection direction) {
+		SP_UNUSED(skeleton);
+		SP_UNUSED(lastTime);
+		SP_UNUSED(time);
+		SP_UNUSED(pEvents);
+		SP_UNUSED(alpha);
+		SP_UNUSED(blend);
+		SP_UNUSED(direction);
+		count++;
+	}
+
+	int count;
+};
+
+void testCustomTimeline() {
+	// AnimationState applies timelines with a cursor, which custom timelines ignore, also when mixing out.
+	Atlas atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *data = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	{
+		Skeleton skeleton(data);
+		CountingTimeline *timeline = new (__FILE__, __LINE__) CountingTimeline();
+		Vector<Timeline *> timelines;
+		timelines.add(timeline);
+		Animation animation("custom", timelines, 1);
+		AnimationStateData stateData(data);
+		stateData.setDefaultMix(1);
+		AnimationState state(&stateData);
+		state.setAnimation(0, &animation, true);
+		for (int i = 0; i < 20; i++) {
+			if (i == 10) state.setAnimation(0, data->findAnimation("idle"), true);
+			state.update(1 / 60.0f);
+			state.apply(skeleton);
+		}
+		assert(timeline->count == 20);
+	}
+	delete data;
+}
+
+/// Checks that world transforms computed with the SkeletonPose kernel match the default path.
+void testSkeletonPose() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData,
+			   skeleton, state);
+	Skeleton poseSkeleton(skeletonData);
+	poseSkeleton.setUseSkeletonPose(true);
+
+	state->setAnimation(0, "run", true);
+	state->addAnimation(1, "shoot", false, 0.3f);
+	for (int frame = 0; frame < 120; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		state->apply(poseSkeleton);
+		skeleton->updateWorldTransform();
+		poseSkeleton.updateWorldTransform();
+
+		// The kernel writes the world transforms back to the bones, which constraints may then change further.
+		Vector<Bone *> &bones = skeleton->getBones(), &poseBones = poseSkeleton.getBones();
+		for (size_t i = 0; i < bones.size(); i++) {
+			Bone *bone = bones[i], *poseBone = poseBones[i];
+			float expected[] = {bone->getA(), bone->getB(), bone->getC(), bone->getD(), bone->getWorldX(),
+								bone->getWorldY()};
+			float actual[] = {poseBone->getA(), poseBone->getB(), poseBone->getC(), poseBone->getD(),
+							  poseBone->getWorldX(), poseBone->getWorldY()};
+			for (int ii = 0; ii < 6; ii++) {
+				if (MathUtil::abs(expected[ii] - actual[ii]) > 0.001f * MathUtil::max(1.0f, MathUtil::abs(expected[ii]))) {
+					printf("SkeletonPose mismatch, bone %s: %f != %f\n", bone->getData().getName().buffer(),
+						   actual[ii], expected[ii]);
+					assert(false);
+				}
+			}
+		}
+	}
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testArena() {
+	Atlas atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonJson json(&atlas);
+	SkeletonData *datas[4];
+	datas[0] = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	datas[2] = json.readSkeletonDataFile("testdata/spineboy/spineboy-pro.json");
+	binary.setUseArena(true);
+	json.setUseArena(true);
+	datas[1] = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	datas[3] = json.readSkeletonDataFile("testdata/spineboy/spineboy-pro.json");
+	unsigned char invalid[32] = {0};
+	SkeletonData *invalidData = binary.readSkeletonData(invalid, 32);
+	assert(!invalidData);
+	SP_UNUSED(invalidData);
+	assert(Arena::getCurrent() == NULL);
+
+	// Loaded containers grow into the arena while it is current, and other memory is freed as usual meanwhile.
+	String *heap = new (__FILE__, __LINE__) String("heap");
+	Arena *previous = Arena::setCurrent(datas[1]->getArena());
+	for (int i = 0; i < 32; i++)
+		datas[1]->getEvents().add(new (__FILE__, __LINE__) EventData("arena"));
+	assert(datas[1]->getArena()->owns(datas[1]->getEvents().buffer()));
+	assert(!datas[1]->getArena()->owns(heap));
+	delete heap;
+	Arena::setCurrent(previous);
+
+	Skeleton *skeletons[4];
+	AnimationStateData *stateDatas[4];
+	AnimationState *states[4];
+	for (int i = 0; i < 4; i++) {
+		assert(datas[i] && (datas[i]->getArena() != NULL) == (i % 2 == 1));
+		skeletons[i] = new (__FILE__, __LINE__) Skeleton(datas[i]);
+		stateDatas[i] = new (__FILE__, __LINE__) AnimationStateData(datas[i]);
+		states[i] = new (__FILE__, __LINE__) AnimationState(stateDatas[i]);
+		states[i]->setAnimation(0, "walk", true);
+		states[i]->addAnimation(0, "jump", false, 0.5f);
+	}
+	for (int frame = 0; frame < 60; frame++) {
+		for (int i = 0; i < 4; i++) {
+			states[i]->update(1 / 60.0f);
+			states[i]->apply(*skeletons[i]);
+			skeletons[i]->updateWorldTransform();
+		}
+		for (int i = 0; i < 4; i += 2) {
+			Vector<Bone *> &bones = skeletons[i]->getBones(), &arenaBones = skeletons[i + 1]->getBones();
+			for (size_t ii = 0; ii < bones.size(); ii++) {
+				assert(bones[ii]->getWorldX() == arenaBones[ii]->getWorldX());
+				assert(bones[ii]->getWorldY() == arenaBones[ii]->getWorldY());
+			}
+			SP_UNUSED(arenaBones);
+		}
+	}
+
+	for (int i = 0; i < 4; i++) {
+		delete states[i];
+		delete stateDatas[i];
+		delete skeletons[i];
+		delete datas[i];
+	}
+
+	// An allocation larger than a quarter chunk gets a chunk of its own, and the last allocation can still be reclaimed.
+	Arena arena(1024);
+	void *first = arena.alloc(8);
+	arena.alloc(300);
+	arena.free(first);
+	void *reused = arena.alloc(8);
+	assert(reused == first);
+	SP_UNUSED(reused);
+}
+
+void testMappedFile() {
+	Atlas atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *datas[3];
+	datas[0] = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	binary.setUseMappedFile(true);
+	datas[1] = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	binary.setUseArena(true);
+	datas[2] = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	SkeletonData *missing = binary.readSkeletonDataFile("testdata/spineboy/missing.skel");
+	assert(!missing);
+	SP_UNUSED(missing);
+
+	for (int i = 1; i < 3; i++) {
+		assert(datas[i] && datas[i]->getArena());
+		// Strings are used in place in the mapping, which the arena owns.
+		assert(datas[i]->getArena()->owns(datas[i]->getVersion().buffer()));
+		assert(datas[i]->getVersion() == datas[0]->getVersion());
+		assert(datas[i]->getAnimations().size() == datas[0]->getAnimations().size());
+		for (size_t ii = 0; ii < datas[0]->getBones().size(); ii++)
+			assert(datas[i]->getBones()[ii]->getName() == datas[0]->getBones()[ii]->getName());
+		for (size_t ii = 0; ii < datas[0]->getAnimations().size(); ii++)
+			assert(datas[i]->getAnimations()[ii]->getName() == datas[0]->getAnimations()[ii]->getName());
+		for (size_t ii = 0; ii < datas[0]->getEvents().size(); ii++) {
+			assert(datas[i]->getEvents()[ii]->getName() == datas[0]->getEvents()[ii]->getName());
+			assert(datas[i]->getEvents()[ii]->getAudioPath() == datas[0]->getEvents()[ii]->getAudioPath());
+		}
+	}
+
+	Skeleton *skeletons[3];
+	AnimationStateData *stateDatas[3];
+	AnimationState *states[3];
+	for (int i = 0; i < 3; i++) {
+		skeletons[i] = new (__FILE__, __LINE__) Skeleton(datas[i]);
+		stateDatas[i] = new (__FILE__, __LINE__) AnimationStateData(datas[i]);
+		states[i] = new (__FILE__, __LINE__) AnimationState(stateDatas[i]);
+		states[i]->setAnimation(0, "run", true);
+		states[i]->addAnimation(0, "shoot", false, 0.5f);
+	}
+	for (int frame = 0; frame < 60; frame++) {
+		for (int i = 0; i < 3; i++) {
+			states[i]->update(1 / 60.0f);
+			states[i]->apply(*skeletons[i]);
+			skeletons[i]->updateWorldTransform();
+		}
+		Vector<Bone *> &bones = skeletons[0]->getBones();
+		for (int i = 1; i < 3; i++) {
+			for (size_t ii = 0; ii < bones.size(); ii++) {
+				assert(bones[ii]->getWorldX() == skeletons[i]->getBones()[ii]->getWorldX());
+				assert(bones[ii]->getWorldY() == skeletons[i]->getBones()[ii]->getWorldY());
+			}
+		}
+	}
+
+	for (int i = 0; i < 3; i++) {
+		delete states[i];
+		delete stateDatas[i];
+		delete skeletons[i];
+		delete datas[i];
+	}
+}
+
+void testLazyAnimations() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		binary.setLazyAnimations(true);
+		SkeletonData *lazyDatas[3];
+		lazyDatas[0] = binary.readSkeletonDataFile(skeletonFile);
+		binary.setUseMappedFile(true);
+		lazyDatas[1] = binary.readSkeletonDataFile(skeletonFile);
+		binary.setUseArena(true);
+		lazyDatas[2] = binary.readSkeletonDataFile(skeletonFile);
+
+		Skeleton skeleton(data);
+		for (int ii = 0; ii < 3; ii++) {
+			SkeletonData *lazyData = lazyDatas[ii];
+			assert(lazyData && lazyData->getAnimations().size() == data->getAnimations().size());
+			Skeleton lazySkeleton(lazyData);
+			for (int pass = 0; pass < 2; pass++) {
+				for (size_t iii = 0; iii < data->getAnimations().size(); iii++) {
+					Animation *animation = data->getAnimations()[iii];
+					Animation *lazyAnimation = lazyData->getAnimations()[iii];
+					assert(!lazyAnimation->isLoaded());
+					assert(lazyData->findAnimation(animation->getName()) == lazyAnimation && lazyAnimation->isLoaded());
+					assert(lazyAnimation->getTimelines().size() == animation->getTimelines().size());
+					assert(lazyAnimation->getDuration() == animation->getDuration());
+
+					skeleton.setToSetupPose();
+					lazySkeleton.setToSetupPose();
+					animation->apply(skeleton, 0, animation->getDuration() * 0.7f, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					lazyAnimation->apply(lazySkeleton, 0, animation->getDuration() * 0.7f, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					skeleton.updateWorldTransform();
+					lazySkeleton.updateWorldTransform();
+					for (size_t b = 0; b < skeleton.getBones().size(); b++) {
+						assert(skeleton.getBones()[b]->getWorldX() == lazySkeleton.getBones()[b]->getWorldX());
+						assert(skeleton.getBones()[b]->getWorldY() == lazySkeleton.getBones()[b]->getWorldY());
+					}
+				}
+				// Evicted animations are decoded again on next use.
+				lazyData->evictAnimations();
+			}
+			delete lazyData;
+		}
+		delete data;
+	}
+
+	// An animation that fails to decode stays empty and is not loaded, and the loader reports the error.
+	Atlas atlas("testdata/goblins/goblins.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	binary.setLazyAnimations(true);
+	SkeletonData *data = binary.readSkeletonDataFile("testdata/goblins/goblins-pro.skel");
+	data->getDefaultSkin()->removeAttachment(data->findSlot("right-hand-item")->getIndex(), "dagger");
+	Animation *walk = data->findAnimation("walk");
+	assert(!walk->isLoaded());
+	bool loaded = walk->load();
+	assert(!loaded && !walk->isLoaded() && walk->getTimelines().size() == 0);
+	assert(walk->getLoader()->getError() == "Attachment not found: dagger");
+	SP_UNUSED(loaded);
+	delete data;
+}
+
+/// Uses the atlas pages as textures, so render commands can be told apart by page.
+class PageTextureLoader : public TextureLoader {
+public:
+	virtual void load(AtlasPage &page, const String &path) {
+		SP_UNUSED(path);
+		page.setRendererObject(&page);
+	}
+
+	virtual void unload(void *texture) {
+		SP_UNUSED(texture);
+	}
+};
+
+void testSkeletonRenderer() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "coin", "tank", "stretchyman"};
+	Vector<unsigned short> quadIndices;
+	quadIndices.add(0);
+	quadIndices.add(1);
+	quadIndices.add(2);
+	quadIndices.add(2);
+	quadIndices.add(3);
+	quadIndices.add(0);
+	for (int i = 0; i < 6; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		PageTextureLoader textureLoader;
+		Atlas atlas(atlasFile, &textureLoader);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		Skeleton skeleton(data);
+		Animation *animation = data->getAnimations()[0];
+		animation->apply(skeleton, 0, animation->getDuration() * 0.5f, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		skeleton.updateWorldTransform();
+
+		// Expected triangle corners, one slot at a time.
+		Vector<float> expected;
+		Vector<void *> expectedTextures;
+		SkeletonClipping clipper;
+		Vector<float> worldVertices;
+		int visibleSlots = 0;
+		for (size_t ii = 0; ii < skeleton.getDrawOrder().size(); ii++) {
+			Slot &slot = *skeleton.getDrawOrder()[ii];
+			Attachment *attachment = slot.getAttachment();
+			if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) {
+				clipper.clipEnd(slot);
+				continue;
+			}
+			Vector<float> *uvs;
+			Vector<unsigned short> *triangles;
+			void *region;
+			if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+				RegionAttachment *regionAttachment = (RegionAttachment *) attachment;
+				worldVertices.setSize(8, 0);
+				regionAttachment->computeWorldVertices(slot, worldVertices, 0, 2);
+				uvs = &regionAttachment->getUVs();
+				triangles = &quadIndices;
+				region = regionAttachment->getRendererObject();
+			} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+				MeshAttachment *mesh = (MeshAttachment *) attachment;
+				worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+				mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices.buffer(), 0, 2);
+				uvs = &mesh->getUVs();
+				triangles = &mesh->getTriangles();
+				region = mesh->getRendererObject();
+			} else {
+				if (attachment->getRTTI().isExactly(ClippingAttachment::rtti))
+					clipper.clipStart(slot, (ClippingAttachment *) attachment);
+				continue;
+			}
+			Vector<float> *vertices = &worldVertices;
+			if (clipper.isClipping()) {
+				clipper.clipTriangles(worldVertices, *triangles, *uvs, 2);
+				vertices = &clipper.getClippedVertices();
+				uvs = &clipper.getClippedUVs();
+				triangles = &clipper.getClippedTriangles();
+			}
+			for (size_t iii = 0; iii < triangles->size(); iii++) {
+				int index = (*triangles)[iii] << 1;
+				expected.add((*vertices)[index]);
+				expected.add((*vertices)[index + 1]);
+				expected.add((*uvs)[index]);
+				expected.add((*uvs)[index + 1]);
+				expectedTextures.add(((AtlasRegion *) region)->page->getRendererObject());
+			}
+			visibleSlots++;
+			clipper.clipEnd(slot);
+		}
+		clipper.clipEnd();
+
+		SkeletonRenderer renderer;
+		for (int pass = 0; pass < 2; pass++) {
+			renderer.setUse32BitIndices(pass == 1);
+			Vector<RenderCommand> &commands = renderer.render(skeleton);
+			assert(commands.size() > 0 && (int) commands.size() <= visibleSlots);
+			size_t corner = 0;
+			for (size_t ii = 0; ii < commands.size(); ii++) {
+				RenderCommand &command = commands[ii];
+				assert((command.indices != NULL) == (pass == 0) && (command.indices32 != NULL) == (pass == 1));
+				// Commands are only split when the state changes.
+				if (ii > 0)
+					assert(command.texture != commands[ii - 1].texture || command.blendMode != commands[ii - 1].blendMode);
+				for (int iii = 0; iii < command.numIndices; iii++, corner++) {
+					int index = pass == 0 ? command.indices[iii] : (int) command.indices32[iii];
+					assert(index < command.numVertices);
+					RenderVertex &vertex = command.vertices[index];
+					assert(vertex.x == expected[corner * 4] && vertex.y == expected[corner * 4 + 1]);
+					assert(vertex.u == expected[corner * 4 + 2] && vertex.v == expected[corner * 4 + 3]);
+					assert(command.texture == expectedTextures[corner]);
+					SP_UNUSED(vertex);
+				}
+			}
+			assert(corner == expectedTextures.size());
+		}
+		delete data;
+	}
+}
+
+static float clippedArea(SkeletonClipping &clipper) {
+	Vector<float> &vertices = clipper.getClippedVertices();
+	Vector<unsigned short> &triangles = clipper.getClippedTriangles();
+	float area = 0;
+	for (size_t i = 0; i < triangles.size(); i += 3) {
+		float *p1 = &vertices[triangles[i] << 1], *p2 = &vertices[triangles[i + 1] << 1], *p3 = &vertices[triangles[i + 2] << 1];
+		area += MathUtil::abs((p2[0] - p1[0]) * (p3[1] - p1[1]) - (p3[0] - p1[0]) * (p2[1] - p1[1])) / 2;
+	}
+	return area;
+}
+
+void testClippingCache() {
+	const char *names[] = {"coin", "spineboy"};
+	for (int i = 0; i < 2; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		Skeleton skeleton(data);
+		int clips = 0;
+		for (int pose = 0; pose < 8; pose++) {
+			// Odd poses are mirrored, which reverses the winding of the cached polygons.
+			skeleton.setScaleX(pose & 1 ? -1.0f : 1.0f);
+			skeleton.setScaleY(pose & 2 ? 0.5f : 1.0f);
+			skeleton.setToSetupPose();
+			skeleton.setAttachment("clipping", "clipping");
+			if (pose >= 4) {
+				Animation *animation = data->getAnimations()[0];
+				animation->apply(skeleton, 0, animation->getDuration() * pose / 8, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+			}
+			skeleton.updateWorldTransform();
+			for (size_t ii = 0; ii < skeleton.getSlots().size(); ii++) {
+				Slot &slot = *skeleton.getSlots()[ii];
+				if (!slot.getAttachment() || !slot.getAttachment()->getRTTI().isExactly(ClippingAttachment::rtti)) continue;
+				ClippingAttachment *clip = (ClippingAttachment *) slot.getAttachment();
+				if (clip->getBones().size() > 0 || slot.getDeform().size() > 0) continue;
+
+				// A grid of triangles covering the clipping polygon.
+				SkeletonClipping cached, uncached;
+				cached.clipStart(slot, clip);
+				float minX = 1e9f, minY = 1e9f, maxX = -1e9f, maxY = -1e9f;
+				Vector<float> world;
+				world.setSize(clip->getWorldVerticesLength(), 0);
+				clip->computeWorldVertices(slot, 0, world.size(), world, 0, 2);
+				for (size_t iii = 0; iii < world.size(); iii += 2) {
+					minX = MathUtil::min(minX, world[iii]);
+					maxX = MathUtil::max(maxX, world[iii]);
+					minY = MathUtil::min(minY, world[iii + 1]);
+					maxY = MathUtil::max(maxY, world[iii + 1]);
+				}
+				Vector<float> vertices, uvs;
+				Vector<unsigned short> triangles;
+				for (int y = 0; y <= 4; y++) {
+					for (int x = 0; x <= 4; x++) {
+						vertices.add(minX - 1 + (maxX - minX + 2) * x / 4);
+						vertices.add(minY - 1 + (maxY - minY + 2) * y / 4);
+						uvs.add(0);
+						uvs.add(0);
+					}
+				}
+				for (int y = 0; y < 4; y++) {
+					for (int x = 0; x < 4; x++) {
+						unsigned short index = (unsigned short) (y * 5 + x);
+						triangles.add(index);
+						triangles.add(index + 1);
+						triangles.add(index + 6);
+						triangles.add(index + 6);
+						triangles.add(index + 5);
+						triangles.add(index);
+					}
+				}
+				cached.clipTriangles(vertices, triangles, uvs, 2);
+
+				// Deforming to the same vertices bypasses the cache.
+				slot.getDeform().clearAndAddAll(clip->getVertices());
+				uncached.clipStart(slot, clip);
+				uncached.clipTriangles(vertices, triangles, uvs, 2);
+				slot.getDeform().clear();
+
+				float area = clippedArea(uncached);
+				assert(area > 0);
+				assert(MathUtil::abs(clippedArea(cached) - area) <= area * 1e-4f);
+				SP_UNUSED(area);
+				cached.clipEnd();
+				uncached.clipEnd();
+				clips++;
+			}
+		}
+		assert(clips > 0);
+		delete data;
+	}
+}
+
+void testClippingRectangle() {
+	Atlas atlas("testdata/coin/coin.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *data = binary.readSkeletonDataFile("testdata/coin/coin-pro.skel");
+	Skeleton skeleton(data);
+	skeleton.setToSetupPose();
+	skeleton.updateWorldTransform();
+	Slot &slot = *skeleton.getSlots()[0];
+	float x = slot.getBone().getWorldX(), y = slot.getBone().getWorldY();
+
+	// An axis aligned rectangle takes the rectangle clipper, the same rectangle slightly rotated the generic one.
+	for (int rotated = 0; rotated < 2; rotated++) {
+		ClippingAttachment clip("rectangle");
+		float offset = rotated ? 0.001f : 0;
+		float rectangle[] = {-10, -5 + offset, 10, -5, 10 + offset, 5, -10, 5};
+		Vector<float> &local = clip.getVertices();
+		for (int i = 0; i < 8; i++) local.add(rectangle[i]);
+		clip.setWorldVerticesLength(8);
+		Bone &bone = slot.getBone();
+		float a = bone.getA(), b = bone.getB(), c = bone.getC(), d = bone.getD(), det = a * d - b * c;
+		for (int i = 0; i < 8; i += 2) {
+			// Local vertices which give the rectangle in world space.
+			float wx = rectangle[i], wy = rectangle[i + 1];
+			local[i] = (d * wx - b * wy) / det;
+			local[i + 1] = (a * wy - c * wx) / det;
+		}
+
+		// A triangle inside, one outside, one crossing a corner and one covering the whole rectangle.
+		float triangleVertices[] = {-2, -2, 2, -2, 0, 2,
+									20, 20, 30, 20, 25, 30,
+									0, 0, 20, 0, 0, 20,
+									-100, -100, 100, -100, 0, 100};
+		Vector<float> vertices, uvs;
+		Vector<unsigned short> triangles;
+		for (int i = 0; i < 24; i += 2) {
+			vertices.add(x + triangleVertices[i]);
+			vertices.add(y + triangleVertices[i + 1]);
+			uvs.add(0);
+			uvs.add(0);
+			triangles.add((unsigned short) (i >> 1));
+		}
+
+		SkeletonClipping clipper;
+		clipper.clipStart(slot, &clip);
+		clipper.clipTriangles(vertices, triangles, uvs, 2);
+		assert(MathUtil::abs(clippedArea(clipper) - (8 + 50 + 200)) < 0.1f);
+		clipper.clipEnd();
+	}
+	delete data;
+}
+
+void testSkinningLayout() {
+	const char *names[] = {"raptor", "goblins", "stretchyman", "tank"};
+	for (int i = 0; i < 4; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		binary.setSkinningLayout(true);
+		SkeletonData *layoutData = binary.readSkeletonDataFile(skeletonFile);
+		Skeleton skeleton(data), layoutSkeleton(layoutData);
+		skeleton.setSkin(data->getSkins().size() > 1 ? data->getSkins()[1] : NULL);
+		layoutSkeleton.setSkin(layoutData->getSkins().size() > 1 ? layoutData->getSkins()[1] : NULL);
+
+		int layouts = 0;
+		Vector<float> expected, actual;
+		Vector<Animation *> &animations = data->getAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			for (int frame = 0; frame < 4; frame++) {
+				float time = animations[ii]->getDuration() * frame / 4;
+				skeleton.setToSetupPose();
+				layoutSkeleton.setToSetupPose();
+				animations[ii]->apply(skeleton, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				layoutData->getAnimations()[ii]->apply(layoutSkeleton, 0, time, false, NULL, 1, MixBlend_Setup,
+													   MixDirection_In);
+				skeleton.updateWorldTransform();
+				layoutSkeleton.updateWorldTransform();
+				for (size_t iii = 0; iii < skeleton.getSlots().size(); iii++) {
+					Slot &slot = *skeleton.getSlots()[iii], &layoutSlot = *layoutSkeleton.getSlots()[iii];
+					if (!slot.getAttachment() || !slot.getAttachment()->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+					MeshAttachment *mesh = (MeshAttachment *) slot.getAttachment();
+					MeshAttachment *layoutMesh = (MeshAttachment *) layoutSlot.getAttachment();
+					if (layoutMesh->hasSkinningLayout()) layouts++;
+					expected.setSize(mesh->getWorldVerticesLength(), 0);
+					actual.setSize(mesh->getWorldVerticesLength(), 0);
+					mesh->computeWorldVertices(slot, expected);
+					layoutMesh->computeWorldVertices(layoutSlot, actual);
+					for (size_t iv = 0; iv < expected.size(); iv++) assert(expected[iv] == actual[iv]);
+
+					// A range starting after the first vertex.
+					if (expected.size() > 4) {
+						layoutMesh->computeWorldVertices(layoutSlot, 2, expected.size() - 4, actual, 0, 2);
+						for (size_t iv = 0; iv < expected.size() - 4; iv++) assert(expected[iv + 2] == actual[iv]);
+					}
+
+					// Offsets for each bone influence of a weighted mesh.
+					if (mesh->getBones().size() > 0) {
+						for (size_t iv = 0, n = mesh->getVertices().size() / 3 * 2; iv < n; iv++) {
+							slot.getDeform().add((float) (iv % 7));
+							layoutSlot.getDeform().add((float) (iv % 7));
+						}
+						mesh->computeWorldVertices(slot, expected);
+						layoutMesh->computeWorldVertices(layoutSlot, actual);
+						for (size_t iv = 0; iv < expected.size(); iv++) assert(expected[iv] == actual[iv]);
+						slot.getDeform().clear();
+						layoutSlot.getDeform().clear();
+					}
+				}
+			}
+		}
+		assert(layouts > 0);
+		delete data;
+		delete layoutData;
+	}
+}
+
+void testChangeTracking() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "tank", "stretchyman"};
+	for (int i = 0; i < 5; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		PageTextureLoader textureLoader;
+		Atlas atlas(atlasFile, &textureLoader);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		AnimationStateData stateData(data);
+		Skeleton skeleton(data), tracked(data);
+		tracked.setUseChangeTracking(true);
+		Skin *skin = data->getSkins().size() > 1 ? data->getSkins()[1] : NULL;
+		skeleton.setSkin(skin);
+		tracked.setSkin(skin);
+		AnimationState state(&stateData), trackedState(&stateData);
+		state.setAnimation(0, data->getAnimations()[0], true);
+		trackedState.setAnimation(0, data->getAnimations()[0], true);
+		SkeletonRenderer renderer, trackedRenderer;
+
+		// Plays the animation, then holds the pose while changing a bone, a constraint, the skeleton position and a
+		// constraint target.
+		for (int frame = 0; frame < 120; frame++) {
+			float delta = frame < 30 || (frame >= 60 && frame < 70) ? 1 / 60.0f : 0;
+			state.update(delta);
+			trackedState.update(delta);
+			state.apply(skeleton);
+			trackedState.apply(tracked);
+			if (frame >= 80 && frame < 90) {
+				Bone *bone = skeleton.getBones()[skeleton.getBones().size() / 2];
+				bone->setRotation(bone->getRotation() + frame);
+				bone = tracked.getBones()[tracked.getBones().size() / 2];
+				bone->setRotation(bone->getRotation() + frame);
+			}
+			if (frame == 95 && skeleton.getIkConstraints().size() > 0) {
+				skeleton.getIkConstraints()[0]->setMix(0.5f);
+				tracked.getIkConstraints()[0]->setMix(0.5f);
+			}
+			if (frame == 100 && skeleton.getTransformConstraints().size() > 0) {
+				skeleton.getTransformConstraints()[0]->setMixRotate(0.25f);
+				tracked.getTransformConstraints()[0]->setMixRotate(0.25f);
+			}
+			if (frame == 105) {
+				skeleton.setX(10);
+				tracked.setX(10);
+			}
+			// The root bone is updated before any constraint, so the update order stays valid.
+			if (frame == 110 && skeleton.getIkConstraints().size() > 0) {
+				skeleton.getIkConstraints()[0]->setTarget(skeleton.getRootBone());
+				tracked.getIkConstraints()[0]->setTarget(tracked.getRootBone());
+			}
+			skeleton.updateWorldTransform();
+			tracked.updateWorldTransform();
+
+			for (size_t ii = 0; ii < skeleton.getBones().size(); ii++) {
+				Bone &bone = *skeleton.getBones()[ii], &trackedBone = *tracked.getBones()[ii];
+				assert(bone.getA() == trackedBone.getA() && bone.getB() == trackedBone.getB());
+				assert(bone.getC() == trackedBone.getC() && bone.getD() == trackedBone.getD());
+				assert(bone.getWorldX() == trackedBone.getWorldX() && bone.getWorldY() == trackedBone.getWorldY());
+				SP_UNUSED(bone);
+				SP_UNUSED(trackedBone);
+			}
+
+			Vector<RenderCommand> &commands = renderer.render(skeleton);
+			Vector<RenderCommand> &trackedCommands = trackedRenderer.render(tracked);
+			assert(commands.size() == trackedCommands.size());
+			for (size_t ii = 0; ii < commands.size(); ii++) {
+				assert(commands[ii].numVertices == trackedCommands[ii].numVertices);
+				for (int iii = 0; iii < commands[ii].numVertices; iii++) {
+					assert(commands[ii].vertices[iii].x == trackedCommands[ii].vertices[iii].x);
+					assert(commands[ii].vertices[iii].y == trackedCommands[ii].vertices[iii].y);
+				}
+			}
+			SP_UNUSED(trackedCommands);
+		}
+
+		ChangeTracker &tracker = *tracked.getChangeTracker();
+		assert(tracker.getBonesSkipped() > 0 && tracker.getBonesUpdated() > 0);
+		assert(tracker.getVerticesReused() > 0 || tracker.getVerticesComputed() == 0);
+		SP_UNUSED(tracker);
+		delete data;
+	}
+}
+
+void testAnimationBaker() {
+	const char *names[] = {"spineboy", "raptor"};
+	for (int i = 0; i < 2; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		Animation &animation = *data->findAnimation("walk");
+		AnimationBaker baker(data);
+		// A power of two rate makes the frame times exact.
+		BakedAnimation *local = baker.bake(animation, 32, false);
+		BakedAnimation *world = baker.bake(animation, 32, true);
+		assert(local->getFrameCount() == world->getFrameCount() && local->getFrameCount() >= 2);
+		assert(local->getAnimatedBoneCount() > 0 && local->getAnimatedBoneCount() < (int) data->getBones().size());
+		assert(local->getMemorySize() < local->getFrameCount() * data->getBones().size() * 7 * sizeof(float));
+
+		Skeleton skeleton(data), localSkeleton(data), worldSkeleton(data);
+		for (int frame = 0; frame < local->getFrameCount(); frame++) {
+			float time = MathUtil::min(frame / 32.0f, animation.getDuration());
+			skeleton.setToSetupPose();
+			animation.apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+			skeleton.updateWorldTransform();
+			localSkeleton.setToSetupPose();
+			local->apply(localSkeleton, time, false, false);
+			localSkeleton.updateWorldTransform();
+			world->apply(worldSkeleton, time, false, false);
+			for (size_t ii = 0; ii < skeleton.getBones().size(); ii++) {
+				Bone &bone = *skeleton.getBones()[ii], &localBone = *localSkeleton.getBones()[ii];
+				Bone &worldBone = *worldSkeleton.getBones()[ii];
+				assert(bone.getA() == localBone.getA() && bone.getA() == worldBone.getA());
+				assert(bone.getD() == localBone.getD() && bone.getD() == worldBone.getD());
+				assert(bone.getWorldX() == localBone.getWorldX() && bone.getWorldX() == worldBone.getWorldX());
+				assert(bone.getWorldY() == localBone.getWorldY() && bone.getWorldY() == worldBone.getWorldY());
+				SP_UNUSED(bone);
+				SP_UNUSED(localBone);
+				SP_UNUSED(worldBone);
+			}
+		}
+
+		// Interpolated world frames lie between their neighbors, and the skeleton's position is applied.
+		worldSkeleton.setX(100);
+		Vector<float> from, to;
+		world->apply(worldSkeleton, 0, false, false);
+		for (size_t ii = 0; ii < worldSkeleton.getBones().size(); ii++)
+			from.add(worldSkeleton.getBones()[ii]->getWorldX());
+		world->apply(worldSkeleton, 1 / 32.0f, false, false);
+		for (size_t ii = 0; ii < worldSkeleton.getBones().size(); ii++)
+			to.add(worldSkeleton.getBones()[ii]->getWorldX());
+		world->apply(worldSkeleton, 0.5f / 32.0f, false, true);
+		for (size_t ii = 0; ii < worldSkeleton.getBones().size(); ii++) {
+			float x = worldSkeleton.getBones()[ii]->getWorldX();
+			assert(x >= MathUtil::min(from[ii], to[ii]) - 0.001f && x <= MathUtil::max(from[ii], to[ii]) + 0.001f);
+			SP_UNUSED(x);
+		}
+		skeleton.setToSetupPose();
+		skeleton.setX(100);
+		animation.apply(skeleton, 0, 0, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		skeleton.updateWorldTransform();
+		for (size_t ii = 0; ii < skeleton.getBones().size(); ii++)
+			assert(fabs(skeleton.getBones()[ii]->getWorldX() - from[ii]) < 0.001f);
+
+		delete local;
+		delete world;
+		delete data;
+	}
+}
+
+void testCompression() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "tank", "stretchyman"};
+	for (int i = 0; i < 5; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		binary.setCompressAnimations(true);
+		SkeletonData *compressedData = binary.readSkeletonDataFile(skeletonFile);
+		Skeleton skeleton(data), compressed(compressedData);
+		Skin *skin = data->getSkins().size() > 1 ? data->getSkins()[1] : NULL;
+		skeleton.setSkin(skin);
+		compressed.setSkin(skin ? compressedData->getSkins()[1] : NULL);
+
+		float maxError = 0;
+		int compressedCount = 0;
+		for (size_t ii = 0; ii < data->getAnimations().size(); ii++) {
+			Animation *animation = data->getAnimations()[ii], *compressedAnimation = compressedData->getAnimations()[ii];
+			for (size_t iii = 0; iii < compressedAnimation->getTimelines().size(); iii++) {
+				Timeline *timeline = compressedAnimation->getTimelines()[iii];
+				if (timeline->getRTTI().instanceOf(CurveTimeline::rtti) && ((CurveTimeline *) timeline)->isCompressed())
+					compressedCount++;
+				if (timeline->getRTTI().isExactly(DeformTimeline::rtti))
+					assert(((DeformTimeline *) timeline)->getVertices().size() == 0);
+			}
+			// Compressing again does nothing.
+			assert(compressedAnimation->compress() == 0);
+
+			for (float time = 0; time < animation->getDuration(); time += 1 / 60.0f) {
+				skeleton.setToSetupPose();
+				compressed.setToSetupPose();
+				animation->apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				compressedAnimation->apply(compressed, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				for (size_t b = 0; b < skeleton.getBones().size(); b++) {
+					Bone &bone = *skeleton.getBones()[b], &compressedBone = *compressed.getBones()[b];
+					float values[] = {bone.getX() - compressedBone.getX(), bone.getY() - compressedBone.getY(),
+									  bone.getRotation() - compressedBone.getRotation(),
+									  bone.getScaleX() - compressedBone.getScaleX(),
+									  bone.getScaleY() - compressedBone.getScaleY(),
+									  bone.getShearX() - compressedBone.getShearX(),
+									  bone.getShearY() - compressedBone.getShearY()};
+					for (int v = 0; v < 7; v++)
+						maxError = MathUtil::max(maxError, MathUtil::abs(values[v]));
+				}
+				for (size_t s = 0; s < skeleton.getSlots().size(); s++) {
+					Vector<float> &deform = skeleton.getSlots()[s]->getDeform();
+					Vector<float> &compressedDeform = compressed.getSlots()[s]->getDeform();
+					assert(deform.size() == compressedDeform.size());
+					for (size_t v = 0; v < deform.size(); v++)
+						maxError = MathUtil::max(maxError, MathUtil::abs(deform[v] - compressedDeform[v]));
+				}
+			}
+		}
+		assert(compressedCount > 0);
+		assert(maxError < 0.05f);
+		printf("Compression %s, %d compressed timelines, max error: %g\n", names[i], compressedCount, maxError);
+		delete data;
+		delete compressedData;
+	}
+}
+
+void testPropertyIndices() {
+	Atlas atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *data = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	binary.setLazyAnimations(true);
+	SkeletonData *lazyData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(lazyData->getPropertyCount() == 0);
+
+	// Every property is indexed when the animations are loaded, the indices are dense.
+	HashMap<PropertyId, bool> ids;
+	for (size_t i = 0; i < data->getAnimations().size(); i++) {
+		Vector<Timeline *> &timelines = data->getAnimations()[i]->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ii++)
+			ids.addAll(timelines[ii]->getPropertyIds(), true);
+	}
+	int count = data->getPropertyCount();
+	assert(count == (int) ids.size());
+	for (HashMap<PropertyId, bool>::Entries entries = ids.getEntries(); entries.hasNext();) {
+		int index = data->getPropertyIndex(entries.next().key);
+		assert(index >= 0 && index < count);
+		SP_UNUSED(index);
+	}
+	assert(data->getPropertyCount() == count);
+	SP_UNUSED(count);
+
+	// Lazily loaded animations are indexed when they are decoded, and keep their indices when decoded again.
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t i = 0; i < lazyData->getAnimations().size(); i++)
+			lazyData->getAnimations()[i]->load();
+		assert(lazyData->getPropertyCount() == count);
+		lazyData->evictAnimations();
+	}
+
+	// Animations created at runtime are indexed when they are set on a track.
+	Vector<Timeline *> timelines;
+	RotateTimeline *rotate = new (__FILE__, __LINE__) RotateTimeline(2, 0, 0);
+	rotate->setFrame(0, 0, 0);
+	rotate->setFrame(1, 1, 90);
+	timelines.add(rotate);
+	timelines.add(new (__FILE__, __LINE__) DrawOrderTimeline(1));
+	Animation animation("runtime", timelines, 1);
+	AnimationStateData stateData(data);
+	AnimationState state(&stateData);
+	Skeleton skeleton(data);
+	state.setAnimation(0, data->findAnimation("walk"), true);
+	state.setAnimation(1, &animation, true);
+	state.update(0.5f);
+	state.apply(skeleton);
+	assert(skeleton.getBones()[0]->getRotation() == skeleton.getBones()[0]->getData().getRotation() + 45);
+	for (size_t i = 0; i < timelines.size(); i++)
+		ids.addAll(timelines[i]->getPropertyIds(), true);
+	assert(data->getPropertyCount() == (int) ids.size());
+
+	// Timelines added later are indexed when the animation is set again.
+	RotateTimeline *added = new (__FILE__, __LINE__) RotateTimeline(2, 0, 1);
+	added->setFrame(0, 0, 30);
+	added->setFrame(1, 1, 30);
+	animation.getTimelines().add(added);
+	state.setAnimation(1, &animation, true);
+	state.update(0);
+	state.apply(skeleton);
+	assert(fabs(skeleton.getBones()[1]->getRotation() - skeleton.getBones()[1]->getData().getRotation() - 30) < 0.001f);
+	ids.addAll(added->getPropertyIds(), true);
+	assert(data->getPropertyCount() == (int) ids.size());
+
+	delete lazyData;
+	delete data;
+}
+
+void testPoseCache() {
+	const char *names[] = {"spineboy", "raptor"};
+	for (int i = 0; i < 2; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		AnimationStateData stateData(data);
+
+		// Skeletons whose track 0 uses the cache match the skeleton applying the timelines, the second one always hits.
+		PoseCache cache;
+		for (size_t ii = 0; ii < data->getAnimations().size(); ii++) {
+			Animation *animation = data->getAnimations()[ii];
+			Skeleton skeleton(data), cached(data), shared(data);
+			AnimationState state(&stateData), cachedState(&stateData), sharedState(&stateData);
+			cachedState.setPoseCache(&cache);
+			sharedState.setPoseCache(&cache);
+			state.setAnimation(0, animation, true);
+			cachedState.setAnimation(0, animation, true);
+			sharedState.setAnimation(0, animation, true);
+			int misses = cache.getMisses(), hits = cache.getHits();
+			for (int frame = 0; frame < 100; frame++) {
+				state.update(1 / 45.0f);
+				cachedState.update(1 / 45.0f);
+				sharedState.update(1 / 45.0f);
+				state.apply(skeleton);
+				cachedState.apply(cached);
+				sharedState.apply(shared);
+				skeleton.updateWorldTransform();
+				cached.updateWorldTransform();
+				shared.updateWorldTransform();
+				for (size_t b = 0; b < skeleton.getBones().size(); b++) {
+					Bone &bone = *skeleton.getBones()[b], &cachedBone = *cached.getBones()[b];
+					assert(MathUtil::abs(bone.getWorldX() - cachedBone.getWorldX()) < 0.01f);
+					assert(MathUtil::abs(bone.getWorldY() - cachedBone.getWorldY()) < 0.01f);
+					assert(MathUtil::abs(bone.getA() - cachedBone.getA()) < 0.001f);
+					assert(shared.getBones()[b]->getWorldX() == cachedBone.getWorldX());
+					SP_UNUSED(bone);
+					SP_UNUSED(cachedBone);
+				}
+				for (size_t s = 0; s < skeleton.getSlots().size(); s++) {
+					Slot &slot = *skeleton.getSlots()[s], &cachedSlot = *cached.getSlots()[s];
+					assert(slot.getAttachment() == cachedSlot.getAttachment());
+					assert(skeleton.getDrawOrder()[s] == skeleton.getSlots()[cached.getDrawOrder()[s]->getData().getIndex()]);
+					assert(MathUtil::abs(slot.getColor().a - cachedSlot.getColor().a) < 0.001f);
+					assert(slot.getDeform().size() == cachedSlot.getDeform().size());
+					for (size_t v = 0; v < slot.getDeform().size(); v++)
+						assert(MathUtil::abs(slot.getDeform()[v] - cachedSlot.getDeform()[v]) < 0.01f);
+					SP_UNUSED(cachedSlot);
+				}
+			}
+			assert(cache.getMisses() > misses && cache.getHits() - hits >= cache.getMisses() - misses);
+			SP_UNUSED(misses);
+			SP_UNUSED(hits);
+			cache.clear();
+			assert(cache.getPoseCount() == 0);
+		}
+
+		// World poses match updateWorldTransform() and apply the skeleton's position and scale.
+		Animation &walk = *data->findAnimation("walk");
+		PoseCache worldCache(1 / 64.0f, true);
+		Skeleton skeleton(data), cached(data);
+		skeleton.setX(100);
+		skeleton.setScaleX(2);
+		skeleton.setScaleY(2);
+		cached.setX(100);
+		cached.setScaleX(2);
+		cached.setScaleY(2);
+		for (int frame = 0; frame < 200; frame++) {
+			// The looped time is rounded to the time step.
+			float time = frame / 64.0f, sampled = (int) (MathUtil::fmod(time, walk.getDuration()) * 64 + 0.5f) / 64.0f;
+			skeleton.setToSetupPose();
+			walk.apply(skeleton, sampled, sampled, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+			skeleton.updateWorldTransform();
+			cached.setToSetupPose();
+			worldCache.apply(cached, walk, time, true);
+			for (size_t b = 0; b < skeleton.getBones().size(); b++) {
+				Bone &bone = *skeleton.getBones()[b], &cachedBone = *cached.getBones()[b];
+				assert(MathUtil::abs(bone.getWorldX() - cachedBone.getWorldX()) < 0.01f);
+				assert(MathUtil::abs(bone.getWorldY() - cachedBone.getWorldY()) < 0.01f);
+				assert(MathUtil::abs(bone.getB() - cachedBone.getB()) < 0.001f);
+				assert(MathUtil::abs(bone.getC() - cachedBone.getC()) < 0.001f);
+				SP_UNUSED(bone);
+				SP_UNUSED(cachedBone);
+			}
+		}
+		// Looping wraps the times, so the poses past the first loop were hits.
+		assert(worldCache.getHits() > 0 && (int) worldCache.getPoseCount() == worldCache.getMisses());
+		printf("Pose cache %s, %d poses, %d hits\n", names[i], (int) worldCache.getPoseCount(), worldCache.getHits());
+
+		delete data;
+	}
+
+	// Skins may be deleted while poses for them are cached, a skin allocated in place of a deleted one gets its own poses.
+	Atlas atlas("testdata/goblins/goblins.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *data = binary.readSkeletonDataFile("testdata/goblins/goblins-pro.skel");
+	PoseCache cache;
+	Skeleton skeleton(data);
+	for (int i = 0; i < 3; i++) {
+		Skin *skin = new (__FILE__, __LINE__) Skin("temporary");
+		skin->addSkin(data->findSkin("goblin"));
+		skeleton.setSkin(skin);
+		skeleton.setSlotsToSetupPose();
+		cache.apply(skeleton, *data->findAnimation("walk"), 0.5f, true);
+		assert(cache.getMisses() == i + 1 && cache.getHits() == 0);
+		skeleton.setSkin(NULL);
+		skeleton.setSlotsToSetupPose();
+		delete skin;
+	}
+	delete data;
+}
+
+/// Counts its updates, to check that custom entries of the update cache are run.
+class CountingUpdatable : public Updatable {
+public:
+	CountingUpdatable() : count(0) {
+	}
+
+	virtual void update() {
+		count++;
+	}
+
+	virtual bool isActive() {
+		return true;
+	}
+
+	virtual void setActive(bool inValue) {
+		SP_UNUSED(inValue);
+	}
+
+	int count;
+};
+
+void testUpdateProgram() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "tank", "stretchyman"};
+	for (int precision = 0; precision < 2; precision++) {
+		MathUtil::setPrecision(precision ? MathPrecision_Fast : MathPrecision_Precise);
+		for (int i = 0; i < 5; i++) {
+			char skeletonFile[256], atlasFile[256];
+			snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+			snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+			Atlas atlas(atlasFile, NULL);
+			SkeletonBinary binary(&atlas);
+			SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+			Skeleton skeleton(data), expected(data);
+			Skin *skin = data->getSkins().size() > 1 ? data->getSkins()[1] : NULL;
+			skeleton.setSkin(skin);
+			expected.setSkin(skin);
+
+			// The compiled program gives the same bits as updating the update cache entries one by one.
+			for (size_t ii = 0; ii < data->getAnimations().size(); ii++) {
+				Animation *animation = data->getAnimations()[ii];
+				for (float time = 0; time < animation->getDuration(); time += 0.1f) {
+					animation->apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					animation->apply(expected, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					skeleton.updateWorldTransform();
+					Vector<Bone *> &bones = expected.getBones();
+					for (size_t b = 0; b < bones.size(); b++) {
+						Bone &bone = *bones[b];
+						bone.setAX(bone.getX());
+						bone.setAY(bone.getY());
+						bone.setAppliedRotation(bone.getRotation());
+						bone.setAScaleX(bone.getScaleX());
+						bone.setAScaleY(bone.getScaleY());
+						bone.setAShearX(bone.getShearX());
+						bone.setAShearY(bone.getShearY());
+					}
+					Vector<Updatable *> &updateCache = expected.getUpdateCacheList();
+					for (size_t u = 0; u < updateCache.size(); u++)
+						updateCache[u]->update();
+					for (size_t b = 0; b < bones.size(); b++) {
+						Bone &bone = *bones[b], &programBone = *skeleton.getBones()[b];
+						assert(bone.getA() == programBone.getA() && bone.getB() == programBone.getB());
+						assert(bone.getC() == programBone.getC() && bone.getD() == programBone.getD());
+						assert(bone.getWorldX() == programBone.getWorldX());
+						assert(bone.getWorldY() == programBone.getWorldY());
+						SP_UNUSED(bone);
+						SP_UNUSED(programBone);
+					}
+				}
+			}
+			delete data;
+		}
+	}
+	MathUtil::setPrecision(MathPrecision_Precise);
+
+	// Entries replaced or added through getUpdateCacheList() are noticed, also when the size of the list is unchanged.
+	Atlas atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *data = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	for (int tracking = 0; tracking < 2; tracking++) {
+		Skeleton skeleton(data);
+		skeleton.setUseChangeTracking(tracking != 0);
+		skeleton.updateWorldTransform();
+		Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+		CountingUpdatable counter;
+		size_t last = updateCache.size() - 1;
+		Updatable *replaced = updateCache[last];
+		updateCache[last] = &counter;
+		skeleton.updateWorldTransform();
+		assert(counter.count == 1);
+		updateCache.add(&counter);
+		skeleton.updateWorldTransform();
+		assert(counter.count == 3);
+		updateCache.removeAt(last + 1);
+		updateCache[last] = replaced;
+		skeleton.updateWorldTransform();
+		assert(counter.count == 3);
+	}
+	delete data;
+}
+
+void testConstraintOrder() {
+	const char *names[] = {"spineboy", "raptor", "goblins", "tank", "stretchyman"};
+	for (int i = 0; i < 5; i++) {
+		char skeletonFile[256], atlasFile[256];
+		snprintf(skeletonFile, sizeof(skeletonFile), "testdata/%s/%s-pro.skel", names[i], names[i]);
+		snprintf(atlasFile, sizeof(atlasFile), "testdata/%s/%s.atlas", names[i], names[i]);
+		Atlas atlas(atlasFile, NULL);
+		SkeletonBinary binary(&atlas);
+		SkeletonData *data = binary.readSkeletonDataFile(skeletonFile);
+		Skeleton skeleton(data);
+		Vector<ConstraintData *> constraints;
+		for (size_t c = 0; c < data->getIkConstraints().size(); c++)
+			constraints.add(data->getIkConstraints()[c]);
+		for (size_t c = 0; c < data->getTransformConstraints().size(); c++)
+			constraints.add(data->getTransformConstraints()[c]);
+		for (size_t c = 0; c < data->getPathConstraints().size(); c++)
+			constraints.add(data->getPathConstraints()[c]);
+		for (int pass = 0; pass < 2; pass++) {
+			// The second pass reverses the order of the constraints after the skeleton was set up.
+			if (pass == 1) {
+				for (size_t c = 0; c < constraints.size(); c++)
+					constraints[c]->setOrder(constraints.size() - 1 - constraints[c]->getOrder());
+			}
+			for (int ii = -1; ii < (int) data->getSkins().size(); ii++) {
+				Skin *skin = ii == -1 ? NULL : data->getSkins()[ii];
+				skeleton.setSkin(skin);
+				skeleton.updateCache();
+
+				// Constraints are updated by increasing order, and those requiring a skin are active only with it.
+				Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+				int lastOrder = -1;
+				for (size_t u = 0; u < updateCache.size(); u++) {
+					ConstraintData *constraintData = NULL;
+					if (updateCache[u]->getRTTI().isExactly(IkConstraint::rtti))
+						constraintData = &((IkConstraint *) updateCache[u])->getData();
+					else if (updateCache[u]->getRTTI().isExactly(TransformConstraint::rtti))
+						constraintData = &((TransformConstraint *) updateCache[u])->getData();
+					else if (updateCache[u]->getRTTI().isExactly(PathConstraint::rtti))
+						constraintData = &((PathConstraint *) updateCache[u])->getData();
+					if (!constraintData) continue;
+					assert((int) constraintData->getOrder() > lastOrder);
+					lastOrder = (int) constraintData->getOrder();
+					assert(!constraintData->isSkinRequired() || (skin && skin->getConstraints().contains(constraintData)));
+				}
+				SP_UNUSED(lastOrder);
+				Vector<IkConstraint *> &ikConstraints = skeleton.getIkConstraints();
+				for (size_t c = 0; c < ikConstraints.size(); c++) {
+					IkConstraintData &constraintData = ikConstraints[c]->getData();
+					bool active = ikConstraints[c]->getTarget()->isActive() &&
+								  (!constraintData.isSkinRequired() || (skin && skin->getConstraints().contains(&constraintData)));
+					assert(ikConstraints[c]->isActive() == active);
+					assert(!active || updateCache.contains(ikConstraints[c]));
+					SP_UNUSED(active);
+				}
+			}
+		}
+		delete data;
+	}
+}
+
+void testSkinLookup() {
+	// Slots with many attachments are looked up by hash, and stay consistent when attachments are replaced or removed.
+	const int count = 300;
+	Skin skin("avatar");
+	char name[32];
+	for (int i = 0; i < count; i++) {
+		snprintf(name, sizeof(name), "a%i", i);
+		skin.setAttachment(1, name, new (__FILE__, __LINE__) PointAttachment(name));
+	}
+	skin.setAttachment(1, "a7", new (__FILE__, __LINE__) PointAttachment("a7 replaced"));
+	for (int i = 0; i < count; i += 2) {
+		snprintf(name, sizeof(name), "a%i", i);
+		skin.removeAttachment(1, name);
+	}
+	for (int i = 0; i < count; i++) {
+		snprintf(name, sizeof(name), "a%i", i);
+		String attachmentName(name);
+		Attachment *attachment = skin.getAttachment(1, attachmentName);
+		assert(attachment == skin.getAttachment(1, attachmentName, attachmentName.hash()));
+		assert(!skin.getAttachment(0, attachmentName));
+		if (i % 2 == 0)
+			assert(!attachment);
+		else
+			assert(attachment && attachment->getName() == (i == 7 ? String("a7 replaced") : attachmentName));
+		SP_UNUSED(attachment);
+	}
+	Vector<String> names;
+	skin.findNamesForSlot(1, names);
+	assert(names.size() == count / 2 && names[0] == "a1" && names[1] == "a3");
+	assert(!skin.getAttachment(1, "a"));
+}
+
+void testSkinCache() {
+	// Composites are shared per combination of skins, and restore the same update cache and active bones and
+	// constraints as a composite built with Skin::addSkin() for which the update cache is sorted.
+	Atlas atlas("testdata/mix-and-match/mix-and-match.atlas", NULL);
+	SkeletonBinary binary(&atlas);
+	SkeletonData *data = binary.readSkeletonDataFile("testdata/mix-and-match/mix-and-match-pro.skel");
+	Vector<Skin *> &skins = data->getSkins();
+	SkinCache cache(data);
+	Skeleton skeleton(data), expected(data);
+	for (int i = 0; i < 200; i++) {
+		Vector<Skin *> components;
+		components.add(data->findSkin("skin-base"));
+		for (int ii = 0, n = 1 + i % 6; ii < n; ii++)
+			components.add(skins[(i * 7 + ii * 13) % skins.size()]);
+		Skin *composite = cache.getSkin(components);
+		assert(cache.getSkin(components) == composite);
+
+		Skin built("built");
+		for (size_t ii = 0; ii < components.size(); ii++)
+			built.addSkin(components[ii]);
+		skeleton.setSkin(composite);
+		skeleton.setSlotsToSetupPose();
+		expected.setSkin(&built);
+		expected.setSlotsToSetupPose();
+
+		Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+		Vector<Updatable *> &expectedCache = expected.getUpdateCacheList();
+		assert(updateCache.size() == expectedCache.size());
+		for (size_t u = 0; u < updateCache.size(); u++) {
+			const RTTI &rtti = updateCache[u]->getRTTI();
+			assert(rtti.isExactly(expectedCache[u]->getRTTI()));
+			if (rtti.isExactly(Bone::rtti))
+				assert(((Bone *) updateCache[u])->getData().getIndex() == ((Bone *) expectedCache[u])->getData().getIndex());
+			else if (rtti.isExactly(IkConstraint::rtti))
+				assert(&((IkConstraint *) updateCache[u])->getData() == &((IkConstraint *) expectedCache[u])->getData());
+			else if (rtti.isExactly(TransformConstraint::rtti))
+				assert(&((TransformConstraint *) updateCache[u])->getData() == &((TransformConstraint *) expectedCache[u])->getData());
+			else
+				assert(&((PathConstraint *) updateCache[u])->getData() == &((PathConstraint *) expectedCache[u])->getData());
+		}
+		SP_UNUSED(expectedCache);
+		for (size_t b = 0; b < skeleton.getBones().size(); b++)
+			assert(skeleton.getBones()[b]->isActive() == expected.getBones()[b]->isActive());
+		for (size_t c = 0; c < skeleton.getIkConstraints().size(); c++)
+			assert(skeleton.getIkConstraints()[c]->isActive() == expected.getIkConstraints()[c]->isActive());
+		for (size_t c = 0; c < skeleton.getTransformConstraints().size(); c++)
+			assert(skeleton.getTransformConstraints()[c]->isActive() == expected.getTransformConstraints()[c]->isActive());
+		for (size_t c = 0; c < skeleton.getPathConstraints().size(); c++)
+			assert(skeleton.getPathConstraints()[c]->isActive() == expected.getPathConstraints()[c]->isActive());
+		expected.setSkin(NULL);
+	}
+	assert(cache.getSkinCount() == (size_t) cache.getMisses() && cache.getHits() >= 200);
+
+	// A stored update order is not used after the order of the constraints changed.
+	Vector<TransformConstraintData *> &transformConstraints = data->getTransformConstraints();
+	size_t constraintCount = data->getIkConstraints().size() + transformConstraints.size() + data->getPathConstraints().size();
+	for (size_t c = 0; c < transformConstraints.size(); c++)
+		transformConstraints[c]->setOrder(constraintCount - 1 - transformConstraints[c]->getOrder());
+	Vector<Skin *> components;
+	components.add(data->findSkin("skin-base"));
+	components.add(skins[0]);
+	skeleton.setSkin(NULL);
+	skeleton.setSkin(cache.getSkin(components));
+	skeleton.setSlotsToSetupPose();
+	Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+	int lastOrder = -1;
+	for (size_t u = 0; u < updateCache.size(); u++) {
+		if (!updateCache[u]->getRTTI().isExactly(TransformConstraint::rtti)) continue;
+		assert((int) ((TransformConstraint *) updateCache[u])->getData().getOrder() > lastOrder);
+		lastOrder = (int) ((TransformConstraint *) updateCache[u])->getData().getOrder();
+	}
+	SP_UNUSED(lastOrder);
+	skeleton.setSkin(NULL);
+	delete data;
+}
+
+void testFastMath() {
+	MathUtil::setPrecision(MathPrecision_Fast);
+	float maxSinCos = 0, maxAtan2 = 0;
+	float degrees[64], sines[64], cosines[64];
+	for (int i = 0; i <= 720000; i++) {
+		float angle = -360 + i * 0.001f;
+		float s, c;
+		MathUtil::sinCosDeg(angle, s, c);
+		maxSinCos = MathUtil::max(maxSinCos, (float) fabs(s - sin(angle * MathUtil::Deg_Rad)));
+		maxSinCos = MathUtil::max(maxSinCos, (float) fabs(c - cos(angle * MathUtil::Deg_Rad)));
+		maxSinCos = MathUtil::max(maxSinCos, (float) fabs(MathUtil::cos(angle * 0.0175f) - cos(angle * 0.0175f)));
+
+		float x = MathUtil::cosDeg(angle) * (1 + i % 7), y = MathUtil::sinDeg(angle) * (1 + i % 5);
+		maxAtan2 = MathUtil::max(maxAtan2, (float) fabs(MathUtil::atan2(y, x) - atan2(y, x)));
+
+		degrees[i % 64] = angle;
+		if (i % 64 == 63) {
+			MathUtil::sinCosDeg(degrees, sines, cosines, 61);
+			for (int ii = 0; ii < 61; ii++) {
+				maxSinCos = MathUtil::max(maxSinCos, (float) fabs(sines[ii] - sin(degrees[ii] * MathUtil::Deg_Rad)));
+				maxSinCos = MathUtil::max(maxSinCos, (float) fabs(cosines[ii] - cos(degrees[ii] * MathUtil::Deg_Rad)));
+			}
+		}
+	}
+
+	// The array variant picks the same quadrant as the scalar one for angles halfway between two, e.g. 45 degrees.
+	for (int i = 0; i < 16; i++)
+		degrees[i] = -675 + i * 90.0f;
+	MathUtil::sinCosDeg(degrees, sines, cosines, 16);
+	for (int i = 0; i < 16; i++) {
+		float s, c;
+		MathUtil::sinCosDeg(degrees[i], s, c);
+		assert(s == sines[i] && c == cosines[i]);
+	}
+	MathUtil::setPrecision(MathPrecision_Precise);
+	printf("Fast math, max error sin/cos: %g, atan2: %g\n", maxSinCos, maxAtan2);
+	assert(maxSinCos <= 3e-7f);
+	assert(maxAtan2 <= 5e-7f);
+	assert(MathUtil::atan2(0, 0) == 0);
+}
+
 namespace spine {
 	SpineExtension *getDefaultExtension() {
 		return new DefaultSpineExtension();
@@ -111,6 +1494,27 @@ int main(int argc, char **argv) {
 	SpineExtension::setInstance(&debug);
 
 	testLoading();
+	testSearch();
+	testJsonIndex();
+	testCustomTimeline();
+	testSkeletonPose();
+	testFastMath();
+	testArena();
+	testMappedFile();
+	testLazyAnimations();
+	testSkeletonRenderer();
+	testClippingCache();
+	testClippingRectangle();
+	testSkinningLayout();
+	testChangeTracking();
+	testAnimationBaker();
+	testCompression();
+	testPropertyIndices();
+	testPoseCache();
+	testUpdateProgram();
+	testConstraintOrder();
+	testSkinLookup();
+	testSkinCache();
 
 	debug.reportLeaks();
 }
@@ -47,6 +47,10 @@ namespace spine {
 
 	class AnimationState;
 
+	class AnimationLoader;
+
+	class SkeletonData;
+
 	class SP_API Animation : public SpineObject {
 		friend class AnimationState;
 
@@ -96,6 +100,8 @@ namespace spine {
 
 		friend class TwoColorTimeline;
 
+		friend class BinaryAnimationLoader;
+
 	public:
 		Animation(const String &name, Vector<Timeline *> &timelines, float duration);
 
@@ -112,19 +118,77 @@ namespace spine {
 
 		bool hasTimeline(Vector<PropertyId> &ids);
 
+		/// Looks up the index of each property of the timelines in the skeleton data, see SkeletonData::getPropertyIndex(),
+		/// so AnimationState can track the properties of its animations with bitsets. Called by the loaders when the
+		/// timelines are decoded and by AnimationState when the animation is set on a track, never while it is applied.
+		/// Does nothing if the properties are indexed for the skeleton data already. Thread safe.
+		///
+		/// Timelines added or removed after the animation is set on a track are indexed when it is set again. An animation
+		/// is indexed for one skeleton data at a time, so it must not be used by AnimationStates of different skeleton
+		/// data at once.
+		void indexProperties(SkeletonData &skeletonData);
+
 		float getDuration();
 
 		void setDuration(float inValue);
 
+		/// Decodes the timelines if the animation is loaded lazily and they are not decoded yet. Thread safe. Called by the
+		/// methods that need the timelines, and by SkeletonData::findAnimation().
+		/// @return False if the timelines could not be decoded, see AnimationLoader::getError(). The animation then has no
+		/// timelines.
+		bool load();
+
+		/// Deletes the timelines if the animation is loaded lazily, they are decoded again on next use. Must not be called
+		/// while the animation is in use, e.g. by a TrackEntry.
+		void evict();
+
+		/// False if the animation is loaded lazily and its timelines are not decoded.
+		bool isLoaded();
+
+		/// The loader decoding the timelines if the animation is loaded lazily, else NULL.
+		AnimationLoader *getLoader();
+
+		/// Compresses the timelines, see Timeline::compress(). Only decoded timelines of lazily loaded animations are
+		/// compressed, SkeletonBinary::setCompressAnimations() also compresses them when they are decoded. Returns the
+		/// largest difference between an original and a decompressed value.
+		float compress();
+
+		/// Returns the index of the frame at or before the target time using a binary search.
 		/// @param target After the first and before the last entry.
 		static int search(Vector<float> &values, float target);
 
 		static int search(Vector<float> &values, float target, int step);
+
+		/// Like search(), but first tries the frame index hint at the cursor, which is validated before use and updated
+		/// with the result, so monotonic playback finds the frame in constant time. AnimationState keeps a cursor per
+		/// TrackEntry and timeline.
+		/// @param cursor The frame index hint, or NULL for no hint.
+		static int search(Vector<float> &values, float target, int step, int *cursor);
 	private:
 		Vector<Timeline *> _timelines;
 		HashMap<PropertyId, bool> _timelineIds;
+		Vector<int> _timelineTypes; // The type of each timeline, see TimelineOther.
+		Vector<int> _propertyIndices; // The property indices of each timeline, in order.
+		Vector<int> _propertyOffsets; // The start of each timeline's property indices, then the end of the last.
+		Vector<unsigned int> _propertyBits; // A bit per property index of the timelines.
+		SkeletonData *_propertySkeletonData;
 		float _duration;
 		String _name;
+		AnimationLoader *_loader;
+		int _loaderIndex;
+
+		void setTimelines(Vector<Timeline *> &timelines, float duration);
+
+		// The timeline types AnimationState applies differently.
+		enum TimelineType {
+			TimelineOther, TimelineRotate, TimelineAttachment, TimelineDrawOrder, TimelineEvent
+		};
+
+		/// Also computes the type of each timeline.
+		void computePropertyIndices(SkeletonData &skeletonData);
+
+		/// True if the timelines key any of the property indices.
+		bool hasProperties(const int *indices, size_t count);
 	};
 }
 
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_AnimationBaker_h
+#define Spine_AnimationBaker_h
+
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Animation;
+
+	class BakedAnimation;
+
+	class Skeleton;
+
+	class SkeletonData;
+
+	/// Samples animations at a fixed rate into BakedAnimation tables, for skeletons that don't need curve evaluation,
+	/// mixing or constraints at full fidelity, such as background crowds.
+	class SP_API AnimationBaker : public SpineObject {
+	public:
+		explicit AnimationBaker(SkeletonData *skeletonData);
+
+		~AnimationBaker();
+
+		/// Poses the skeleton with the animation at each frame and stores the bone transforms. Local tables store the
+		/// bones' local transforms after the animation is applied. World tables store the world transforms after
+		/// Skeleton::updateWorldTransform(), so they include constraints.
+		///
+		/// @param fps The number of frames per second. The last frame is sampled at the animation's duration.
+		/// @return The baked animation, which must be deleted by the caller.
+		BakedAnimation *bake(Animation &animation, float fps, bool world);
+
+		/// The skeleton the animations are sampled with. Its skin may be set when constraints depend on skin attachments.
+		Skeleton &getSkeleton();
+
+	private:
+		Skeleton *_skeleton;
+	};
+}
+
+#endif /* Spine_AnimationBaker_h */
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_AnimationLoader_h
+#define Spine_AnimationLoader_h
+
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+
+namespace spine {
+	class Animation;
+
+	/// Decodes the timelines of animations on first use. Lazily loaded animations keep a pointer to their loader and an
+	/// index identifying them to it. See SkeletonBinary::setLazyAnimations().
+	class SP_API AnimationLoader : public SpineObject {
+	public:
+		AnimationLoader();
+
+		virtual ~AnimationLoader();
+
+		/// Decodes the timelines of the animation, unless they are decoded already. Must be safe to call from multiple
+		/// threads at once.
+		/// @return False if the timelines could not be decoded. The animation is then left empty and not loaded, and
+		/// getError() describes the failure.
+		virtual bool load(Animation &animation, int index) = 0;
+
+		/// Deletes the timelines of the animation if they are decoded, so they are decoded again on next use.
+		virtual void evict(Animation &animation, int index) = 0;
+
+		virtual bool isLoaded(int index) = 0;
+
+		/// The error of the last load() that failed, or an empty string.
+		virtual String getError() = 0;
+	};
+}
+
+#endif /* Spine_AnimationLoader_h */
@@ -59,6 +59,8 @@ namespace spine {
 
 	class Animation;
 
+	class PoseCache;
+
 	class Event;
 
 	class AnimationStateData;
@@ -288,6 +290,7 @@ namespace spine {
 		Vector<int> _timelineMode;
 		Vector<TrackEntry *> _timelineHoldMix;
 		Vector<float> _timelinesRotation;
+		Vector<int> _timelineCursors;
 		AnimationStateListener _listener;
 		AnimationStateListenerObject *_listenerObject;
 
@@ -308,6 +311,8 @@ namespace spine {
 	class SP_API EventQueue : public SpineObject {
 		friend class AnimationState;
 
+		friend class CrowdUpdater;
+
 	private:
 		Vector<EventQueueEntry> _eventQueueEntries;
 		AnimationState &_state;
@@ -343,6 +348,8 @@ namespace spine {
 
 		friend class EventQueue;
 
+		friend class CrowdUpdater;
+
 	public:
 		explicit AnimationState(AnimationStateData *data);
 
@@ -421,6 +428,13 @@ namespace spine {
 
 		void setTimeScale(float inValue);
 
+		/// When set, track 0 copies the pose of its current animation from the cache instead of applying the timelines,
+		/// while it isn't mixed out and its alpha is 1. Events are still fired. The cache isn't owned by the state and can
+		/// be shared by states of skeletons with the same skeleton data. May be NULL, the default.
+		void setPoseCache(PoseCache *poseCache);
+
+		PoseCache *getPoseCache();
+
 		void setListener(AnimationStateListener listener);
 
 		void setListener(AnimationStateListenerObject *listener);
@@ -446,7 +460,7 @@ namespace spine {
 		Vector<Event *> _events;
 		EventQueue *_queue;
 
-		HashMap<PropertyId, bool> _propertyIDs;
+		Vector<unsigned int> _propertyBits; // A bit per property index, set once a track entry keys the property.
 		bool _animationsChanged;
 
 		AnimationStateListener _listener;
@@ -456,14 +470,16 @@ namespace spine {
 
 		float _timeScale;
 
+		PoseCache *_poseCache;
+
 		static Animation *getEmptyAnimation();
 
 		static void
 		applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleton &skeleton, float time, float alpha, MixBlend pose,
-							Vector<float> &timelinesRotation, size_t i, bool firstFrame);
+							Vector<float> &timelinesRotation, size_t i, bool firstFrame, int *cursor);
 
 		void applyAttachmentTimeline(AttachmentTimeline *attachmentTimeline, Skeleton &skeleton, float animationTime,
-									 MixBlend pose, bool firstFrame);
+									 MixBlend pose, bool firstFrame, int *cursor);
 
 		/// Returns true when all mixing from entries are complete.
 		bool updateMixingFrom(TrackEntry *to, float delta);
@@ -488,7 +504,10 @@ namespace spine {
 
 		void computeHold(TrackEntry *entry);
 
-		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
+		bool addProperties(const int *indices, size_t count);
+
+		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, size_t hash,
+						   bool attachments);
 	};
 }
 
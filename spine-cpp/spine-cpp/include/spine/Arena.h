@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_Arena_h
+#define Spine_Arena_h
+
+#include <spine/SpineObject.h>
+
+namespace spine {
+	struct ArenaChunk;
+
+	struct ArenaAdopted;
+
+	struct ArenaRange;
+
+	/// A chunked bump pointer allocator. While an arena is current on a thread, SpineExtension::alloc(), calloc() and
+	/// realloc() on that thread allocate from it, so all memory allocated in between belongs to the arena. Freeing memory
+	/// owned by the current arena does nothing, it is all released at once when the arena is deleted.
+	///
+	/// Only the current arena is checked for ownership, so memory owned by an arena must only be freed or reallocated
+	/// while that arena is current, and memory allocated elsewhere is freed as usual. Without a current arena, frees and
+	/// reallocations pay nothing for arenas. An arena must not be current on more than one thread at a time.
+	///
+	/// SkeletonBinary::setUseArena() and SkeletonJson::setUseArena() load a SkeletonData into an arena that the
+	/// SkeletonData owns.
+	class SP_API Arena : public SpineObject {
+	public:
+		/// @param chunkSize Size of the chunks in bytes. Allocations larger than a quarter chunk get a chunk of their own.
+		explicit Arena(size_t chunkSize = 64 * 1024);
+
+		~Arena();
+
+		/// Allocates zeroed memory aligned to 8 bytes. Returns NULL if size is 0.
+		void *alloc(size_t size);
+
+		/// Grows or shrinks memory owned by this arena, in place if it was the last allocation.
+		void *realloc(void *ptr, size_t size);
+
+		/// Reclaims memory owned by this arena if it was the last allocation, otherwise does nothing.
+		void free(void *ptr);
+
+		/// Makes the arena own memory it did not allocate, e.g. a mapped file, so that freeing pointers into it does
+		/// nothing. The release function is called with the memory when the arena is deleted.
+		void adopt(void *memory, size_t size, void (*release)(void *memory, size_t size));
+
+		bool owns(const void *ptr);
+
+		/// Returns the size requested for memory allocated from this arena, or the bytes up to the end of adopted memory.
+		size_t getSize(const void *ptr);
+
+		/// Bytes allocated from the arena, including per allocation headers.
+		size_t getUsed();
+
+		/// Bytes of all chunks.
+		size_t getCapacity();
+
+		/// The arena allocations on the calling thread go to, or NULL.
+		static Arena *getCurrent();
+
+		/// Sets the arena allocations on the calling thread go to and returns the previous one. May be NULL.
+		static Arena *setCurrent(Arena *arena);
+
+	private:
+		ArenaChunk *_chunks;
+		size_t _chunkSize;
+		size_t _used;
+		size_t _capacity;
+		void *_last;
+		ArenaAdopted *_adopted;
+		ArenaRange *_ranges; // The chunks and adopted memory, sorted by address.
+		size_t _rangeCount;
+		size_t _rangeCapacity;
+
+		/// @param single True if the chunk holds a single large allocation.
+		ArenaChunk *addChunk(size_t size, bool single);
+
+		void addRange(const char *start, const char *end, bool adopted);
+
+		/// Returns the chunk or adopted memory containing ptr, or NULL.
+		const ArenaRange *findRange(const void *ptr);
+	};
+
+	/// Deletes an arena when destroyed. Declared as the first member of a class, it releases the arena after all other
+	/// members, whose destructors may still free memory into it. The destructor of the class calls makeCurrent() first,
+	/// so those frees go to the arena.
+	class SP_API ArenaHolder {
+	public:
+		ArenaHolder() : arena(NULL), _previous(NULL) {
+		}
+
+		~ArenaHolder() {
+			if (!arena) return;
+			Arena::setCurrent(_previous);
+			delete arena;
+		}
+
+		/// Makes the arena current until the holder is destroyed. Does nothing without an arena.
+		void makeCurrent() {
+			if (arena) _previous = Arena::setCurrent(arena);
+		}
+
+		Arena *arena;
+
+	private:
+		Arena *_previous;
+	};
+}
+
+#endif /* Spine_Arena_h */
@@ -64,18 +64,27 @@ namespace spine {
 		/// Sets the time and value of the specified keyframe.
 		void setFrame(int frame, float time, const String &attachmentName);
 
-		Vector<String> &getAttachmentNames();
+		/// The attachment names. Use setFrame() to change them, so their hashes are updated.
+		const Vector<String> &getAttachmentNames();
+
+		/// The hashes of the attachment names, see String::hash().
+		const Vector<size_t> &getAttachmentNameHashes();
 
 		int getSlotIndex() { return _slotIndex; }
 
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _slotIndex;
 
 		Vector<String> _attachmentNames;
+		Vector<size_t> _attachmentNameHashes;
 
-		void setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName);
+		void setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName, size_t hash);
 	};
 }
 
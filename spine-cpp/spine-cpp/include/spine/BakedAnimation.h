@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_BakedAnimation_h
+#define Spine_BakedAnimation_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+
+namespace spine {
+	class Skeleton;
+
+	/// The pose of an animation sampled at a fixed rate by AnimationBaker. Applying a baked animation sets the bones
+	/// directly from the tables, without evaluating timelines or curves.
+	///
+	/// Local tables hold the bones' local transforms and the constraints' mixes and properties. World tables hold the
+	/// bones' world transforms. Values that don't change during the animation are stored once instead of once per frame.
+	/// Slot attachments, colors, deforms, draw order and events are not baked.
+	class SP_API BakedAnimation : public SpineObject {
+		friend class AnimationBaker;
+
+	public:
+		~BakedAnimation();
+
+		/// Sets the bones of the skeleton to the pose at the specified time. If interpolate is true, the two nearest
+		/// frames are blended, otherwise the nearest earlier frame is used.
+		///
+		/// For local tables the bones' local transforms and the constraints are set, and Skeleton::updateWorldTransform()
+		/// must be called afterward. For world tables the bones' world transforms are set, including the effect of constraints, and the
+		/// skeleton must not be updated afterward. The skeleton's position and scale are applied to the world tables. This
+		/// is exact for the position, but only approximate for scale when bones inherit neither scale nor rotation.
+		///
+		/// @param skeleton A skeleton of the skeleton data the animation was baked for.
+		void apply(Skeleton &skeleton, float time, bool loop, bool interpolate);
+
+		const String &getName();
+
+		/// The number of frames per second.
+		float getFps();
+
+		float getDuration();
+
+		int getFrameCount();
+
+		/// True if the tables hold world transforms, false if they hold local transforms.
+		bool isWorld();
+
+		/// The number of bones that are animated, the rest are stored once.
+		int getAnimatedBoneCount();
+
+		/// The number of bytes used by the tables.
+		size_t getMemorySize();
+
+	private:
+		BakedAnimation(const String &name, float fps, float duration, int frameCount, bool world);
+
+		String _name;
+		float _fps, _duration;
+		int _frameCount;
+		bool _world;
+		int _boneCount;
+
+		/// Per bone, followed for local tables by each IK, transform and path constraint: the offset of its values in
+		/// _frames and the number of values per frame, or 0 if it is constant.
+		Vector<int> _offsets, _strides;
+		Vector<float> _frames;
+	};
+}
+
+#endif /* Spine_BakedAnimation_h */
@@ -59,6 +59,10 @@ namespace spine {
 
 		friend class Skeleton;
 
+		friend class ChangeTracker;
+
+		friend class SkeletonPose;
+
 		friend class RegionAttachment;
 
 		friend class PointAttachment;
@@ -93,6 +97,10 @@ namespace spine {
 
 		friend class TranslateYTimeline;
 
+		friend class BakedAnimation;
+
+		friend class PoseCache;
+
 	RTTI_DECL
 
 	public:
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_ChangeTracker_h
+#define Spine_ChangeTracker_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Attachment;
+
+	class Bone;
+
+	class Skeleton;
+
+	/// Tracks what changed in a skeleton's pose between updates, so Skeleton::updateWorldTransform() only updates the bones
+	/// whose local transform or parent changed and the constraints whose bones or properties changed. Enabled per skeleton
+	/// with Skeleton::setUseChangeTracking().
+	///
+	/// Changes are found by comparing the local transforms, the constraint properties and the skeleton's position and scale
+	/// to their values at the previous update, so timelines, setters and direct writes are all noticed. A constraint given
+	/// another target is noticed too, which makes the next update compute all bones and constraints. Changes to bone or
+	/// constraint data, or to world transforms made outside of updateWorldTransform(), require a call to invalidate().
+	///
+	/// The tracker also counts how often the world transform of each bone changed, which lets SkeletonRenderer reuse the
+	/// world vertices of attachments whose bones and deform did not change.
+	class SP_API ChangeTracker : public SpineObject {
+		friend class Skeleton;
+
+		friend class SkeletonRenderer;
+
+		friend class BakedAnimation;
+
+		friend class PoseCache;
+
+	public:
+		ChangeTracker();
+
+		~ChangeTracker();
+
+		/// Makes the next update compute all bones and constraints.
+		void invalidate();
+
+		/// A number which is incremented each time the world transform of the bone with the index changes.
+		unsigned int getWorldVersion(size_t boneIndex);
+
+		/// A unique ID for this tracker, so caches of world versions can tell trackers apart.
+		int getId();
+
+		/// The number of bone and constraint updates that were done and skipped since the last resetStats().
+		int getBonesUpdated();
+
+		int getBonesSkipped();
+
+		int getConstraintsUpdated();
+
+		int getConstraintsSkipped();
+
+		/// The number of world vertices SkeletonRenderer computed and reused since the last resetStats().
+		int getVerticesComputed();
+
+		int getVerticesReused();
+
+		void resetStats();
+
+	private:
+		enum EntryType {
+			EntryType_Bone, EntryType_Ik, EntryType_Transform, EntryType_Path, EntryType_Other
+		};
+
+		const int _id;
+		bool _valid;
+		/// The skeleton's x, y, scaleX and scaleY at the last update.
+		float _skeletonValues[4];
+
+		/// Per bone: the local transform at the last update, 7 floats, the world transform at the last update, 6 floats,
+		/// the world version, and flags for the current update.
+		Vector<float> _locals, _worlds;
+		Vector<unsigned int> _versions;
+		Vector<bool> _dirty, _changed, _updated;
+
+		/// Per update cache entry: its type, the range of _entryBones holding the bone and parent index for bones, or the
+		/// constrained bones followed by the bone read for constraints, the range of _entryValues holding the properties at the last
+		/// update and, for path constraints, the attachment at the last update.
+		Vector<int> _entryTypes, _entryBoneStart, _entryBoneCount, _entryOutputCount, _entryValueStart;
+		Vector<int> _entryBones;
+		Vector<float> _entryValues;
+		Vector<Attachment *> _entryAttachments;
+		/// Per update cache entry, the target bone of a constraint when the entry was collected, else NULL.
+		Vector<Bone *> _entryInputs;
+		Vector<bool> _entryChanged, _entryRun;
+		int _boneEntries, _constraintEntries;
+		bool _hasOther;
+
+		int _bonesUpdated, _bonesSkipped, _constraintsUpdated, _constraintsSkipped;
+		int _verticesComputed, _verticesReused;
+
+		/// Collects the entry information from the skeleton's update cache.
+		void build(Skeleton &skeleton);
+
+		/// Updates the world transforms of the bones and constraints which may have changed.
+		void updateWorldTransform(Skeleton &skeleton);
+
+		/// Compares the world transforms of the bones to their values at the last update and increments the versions of
+		/// those which changed. All bones are compared if all is true, else only those updated.
+		void updateVersions(Skeleton &skeleton, bool all);
+
+		/// Determines which entries must be updated. Returns false if a constraint must be updated after a bone it
+		/// constrains was skipped, in which case that bone is marked dirty and the plan must be made again.
+		bool plan(Skeleton &skeleton);
+
+		static int getNextID();
+	};
+}
+
+#endif /* Spine_ChangeTracker_h */
@@ -57,6 +57,10 @@ namespace spine {
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _slotIndex;
 
 		static const int ENTRIES = 5;
@@ -90,6 +94,10 @@ namespace spine {
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _slotIndex;
 
 		static const int ENTRIES = 4;
@@ -119,6 +127,10 @@ namespace spine {
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _slotIndex;
 	};
 
@@ -146,6 +158,10 @@ namespace spine {
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _slotIndex;
 
 		static const int ENTRIES = 8;
@@ -182,6 +198,10 @@ namespace spine {
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _slotIndex;
 
 		static const int ENTRIES = 7;
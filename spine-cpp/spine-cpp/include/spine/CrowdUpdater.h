@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_CrowdUpdater_h
+#define Spine_CrowdUpdater_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Skeleton;
+
+	class AnimationState;
+
+	class CrowdThreadPool;
+
+	/// A unit of work made of independent items, see CrowdExecutor.
+	class SP_API CrowdTask {
+	public:
+		CrowdTask() {};
+
+		virtual ~CrowdTask() {};
+
+		/// Processes the item with the given index. May be called concurrently for different indices.
+		virtual void run(size_t index) = 0;
+	};
+
+	/// Runs the items of a CrowdTask. Implement this to run CrowdUpdater on an engine's own job system.
+	class SP_API CrowdExecutor {
+	public:
+		CrowdExecutor() {};
+
+		virtual ~CrowdExecutor() {};
+
+		/// Calls task.run(i) exactly once for every i in [0, count), possibly concurrently from any threads, and returns
+		/// once all calls have completed.
+		virtual void parallelFor(size_t count, CrowdTask &task) = 0;
+	};
+
+	/// A CrowdExecutor backed by a pool of worker threads. Each call to parallelFor() splits the items evenly between the
+	/// calling thread and the workers. A thread that runs out of items steals half of the remaining items of another thread,
+	/// so uneven items, e.g. skeletons with very different bone counts, still keep all threads busy.
+	///
+	/// Define SPINE_NO_THREADS on platforms without std::thread, in which case all items run on the calling thread.
+	class SP_API ThreadPoolExecutor : public CrowdExecutor, public SpineObject {
+	public:
+		/// @param numThreads The number of threads running items, including the calling thread. 0 uses one thread per
+		/// hardware thread.
+		explicit ThreadPoolExecutor(int numThreads = 0);
+
+		virtual ~ThreadPoolExecutor();
+
+		int getNumThreads();
+
+		virtual void parallelFor(size_t count, CrowdTask &task);
+
+	private:
+		CrowdThreadPool *_pool;
+	};
+
+	/// Updates many independent skeletons in parallel. For each skeleton, update() calls AnimationState::update(),
+	/// AnimationState::apply() and Skeleton::updateWorldTransform(), spreading the skeletons across a CrowdExecutor.
+	///
+	/// Listeners are never invoked from the executor's threads. Events raised during update() are queued on each animation
+	/// state and delivered on the calling thread once all skeletons are posed, in the order the skeletons were added, so
+	/// listener invocations are deterministic regardless of how the work was scheduled. Listeners may safely modify the
+	/// animation states, e.g. to set a new animation.
+	///
+	/// Skeletons and animation states must not be shared between entries. Shared SkeletonData and AnimationStateData are
+	/// only read during update(), as is any SpineExtension state except allocation, which must be thread safe.
+	class SP_API CrowdUpdater : public SpineObject, private CrowdTask {
+	public:
+		/// @param executor Runs the updates, not owned. If NULL, a ThreadPoolExecutor with one thread per hardware thread
+		/// is created.
+		explicit CrowdUpdater(CrowdExecutor *executor = NULL);
+
+		~CrowdUpdater();
+
+		/// Adds a skeleton to be updated.
+		/// @param state May be NULL to only compute world transforms.
+		void add(Skeleton *skeleton, AnimationState *state);
+
+		/// Removes the first entry for the skeleton, if any.
+		void remove(Skeleton *skeleton);
+
+		void clear();
+
+		size_t size();
+
+		Vector<Skeleton *> &getSkeletons();
+
+		/// The animation state of each skeleton, which may contain NULLs.
+		Vector<AnimationState *> &getAnimationStates();
+
+		CrowdExecutor *getExecutor();
+
+		/// Advances, applies and poses all skeletons, then delivers queued events on the calling thread.
+		void update(float delta);
+
+	private:
+		Vector<Skeleton *> _skeletons;
+		Vector<AnimationState *> _states;
+		Vector<bool> _drainDisabled;
+		CrowdExecutor *_executor;
+		ThreadPoolExecutor *_ownedExecutor;
+		float _delta;
+
+		virtual void run(size_t index);
+	};
+}
+
+#endif /* Spine_CrowdUpdater_h */
@@ -113,6 +113,14 @@ namespace spine {
 			return _extension->_readFile(path, length);
 		}
 
+		virtual char *_mapFile(const String &path, int *length) {
+			return _extension->_mapFile(path, length);
+		}
+
+		virtual void _unmapFile(char *data, int length) {
+			_extension->_unmapFile(data, length);
+		}
+
 		size_t getUsedMemory() {
 			return _usedMemory;
 		}
@@ -52,6 +52,7 @@ namespace spine {
 		/// Sets the time and value of the specified keyframe.
 		void setFrame(int frameIndex, float time, Vector<float> &vertices);
 
+		/// The vertices of each key. Empty once the timeline is compressed.
 		Vector <Vector<float>> &getVertices();
 
 		VertexAttachment *getAttachment();
@@ -64,15 +65,34 @@ namespace spine {
 
 		float getCurvePercent(float time, int frame);
 
+		/// Compresses the curves like CurveTimeline::compress() and the keys. Keys of unweighted attachments are stored
+		/// relative to the setup vertices. The values are quantized to 16 bits with a range per timeline, and only the
+		/// vertices between the first and last one that differs from the setup are stored. The keys are decompressed as
+		/// the timeline is applied. Returns the largest difference between an original and a decompressed value.
+		virtual float compress();
+
 		int getSlotIndex() { return _slotIndex; }
 
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _slotIndex;
 
 		Vector <Vector<float>> _vertices;
 
+		struct PackedKey;
+
+		/// When compressed, the values of each key between its first and last changed vertex.
+		Vector<short> _packedVertices;
+		/// When compressed, per key the offset of its values in _packedVertices, its first vertex and the end vertex.
+		Vector<int> _packedKeys;
+		float _packedVertexScale;
+		size_t _vertexCount;
+
 		VertexAttachment *_attachment;
 	};
 }
@@ -53,6 +53,11 @@ namespace spine {
 
 		Vector <Vector<int>> &getDrawOrders();
 
+	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 	private:
 		Vector <Vector<int>> _drawOrders;
 	};
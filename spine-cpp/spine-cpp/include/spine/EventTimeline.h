@@ -54,6 +54,11 @@ namespace spine {
 
 		Vector<Event *> &getEvents();
 
+	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 	private:
 		Vector<Event *> _events;
 	};
@@ -33,6 +33,7 @@
 
 #include <stdlib.h>
 #include <spine/dll.h>
+#include <spine/Arena.h>
 
 #define SP_UNUSED(x) (void)(x)
 
@@ -43,21 +44,33 @@ namespace spine {
 	public:
 		template<typename T>
 		static T *alloc(size_t num, const char *file, int line) {
+			Arena *arena = Arena::getCurrent();
+			if (arena) return (T *) arena->alloc(sizeof(T) * num);
 			return (T *) getInstance()->_alloc(sizeof(T) * num, file, line);
 		}
 
 		template<typename T>
 		static T *calloc(size_t num, const char *file, int line) {
+			Arena *arena = Arena::getCurrent();
+			if (arena) return (T *) arena->alloc(sizeof(T) * num);
 			return (T *) getInstance()->_calloc(sizeof(T) * num, file, line);
 		}
 
 		template<typename T>
 		static T *realloc(T *ptr, size_t num, const char *file, int line) {
+			Arena *arena = Arena::getCurrent();
+			if (arena && (!ptr || arena->owns((const void *) ptr)))
+				return (T *) arena->realloc((void *) ptr, sizeof(T) * num);
 			return (T *) getInstance()->_realloc(ptr, sizeof(T) * num, file, line);
 		}
 
 		template<typename T>
 		static void free(T *ptr, const char *file, int line) {
+			Arena *arena = Arena::getCurrent();
+			if (arena && arena->owns((const void *) ptr)) {
+				arena->free((void *) ptr);
+				return;
+			}
 			getInstance()->_free((void *) ptr, file, line);
 		}
 
@@ -70,6 +83,14 @@ namespace spine {
 			return getInstance()->_readFile(path, length);
 		}
 
+		static char *mapFile(const String &path, int *length) {
+			return getInstance()->_mapFile(path, length);
+		}
+
+		static void unmapFile(char *data, int length) {
+			getInstance()->_unmapFile(data, length);
+		}
+
 		static void setInstance(SpineExtension *inSpineExtension);
 
 		static SpineExtension *getInstance();
@@ -90,6 +111,19 @@ namespace spine {
 
 		virtual void _beforeFree(void *ptr) { SP_UNUSED(ptr); }
 
+		/// Implement this function to map files into memory. The mapping must be private and writable, changes must not be
+		/// written back to the file. Returns NULL if the file can not be mapped, loaders then read it instead.
+		virtual char *_mapFile(const String &path, int *length) {
+			SP_UNUSED(path);
+			SP_UNUSED(length);
+			return NULL;
+		}
+
+		virtual void _unmapFile(char *data, int length) {
+			SP_UNUSED(data);
+			SP_UNUSED(length);
+		}
+
 	protected:
 		SpineExtension();
 
@@ -113,6 +147,10 @@ namespace spine {
 		virtual void _free(void *mem, const char *file, int line) override;
 
 		virtual char *_readFile(const String &path, int *length) override;
+
+		virtual char *_mapFile(const String &path, int *length) override;
+
+		virtual void _unmapFile(char *data, int length) override;
 	};
 
 // This function is to be implemented by engine specific runtimes to provide
@@ -27,9 +27,11 @@
  * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *****************************************************************************/
 
+
 #ifndef Spine_HashMap_h
 #define Spine_HashMap_h
 
+#include <spine/Extension.h>
 #include <spine/Vector.h>
 #include <spine/SpineObject.h>
 
@@ -42,10 +44,49 @@
 #endif
 
 namespace spine {
-	template<typename K, typename V>
+	/// Hash function used by HashMap. The default implementation calls a `size_t hash() const` member of the key.
+	/// Specialize this template to provide a hash for key types that can't carry such a member.
+	template<typename K>
+	struct SP_API HashMapHasher {
+		static size_t hash(const K &key) {
+			return key.hash();
+		}
+	};
+
+	template<>
+	struct SP_API HashMapHasher<long long> {
+		static size_t hash(const long long &key) {
+			// 64-bit finalizer from MurmurHash3, property ids have most of their entropy in the low bits.
+			unsigned long long h = (unsigned long long) key;
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdULL;
+			h ^= h >> 33;
+			h *= 0xc4ceb9fe1a85ec53ULL;
+			h ^= h >> 33;
+			return (size_t) h;
+		}
+	};
+
+	template<>
+	struct SP_API HashMapHasher<int> {
+		static size_t hash(const int &key) {
+			return HashMapHasher<long long>::hash((long long) key);
+		}
+	};
+
+	/// Hash map using open addressing with linear probing. Entries are stored in a single contiguous slot array whose
+	/// capacity is a power of two. Removal uses backward shift deletion, so no tombstones are left behind. clear()
+	/// keeps the slot array so maps that are cleared and refilled every frame don't allocate.
+	template<typename K, typename V, typename H = HashMapHasher<K> >
 	class SP_API HashMap : public SpineObject {
 	private:
-		class Entry;
+		struct Slot {
+			K _key;
+			V _value;
+			bool _used;
+
+			Slot() : _key(), _value(), _used(false) {}
+		};
 
 	public:
 		class SP_API Pair {
@@ -60,47 +101,46 @@ namespace spine {
 		public:
 			friend class HashMap;
 
-			explicit Entries(Entry *entry) : _entry(NULL), _hasChecked(false) {
-				_start.next = entry;
-				_entry = &_start;
+			explicit Entries(Slot *slots, size_t capacity) : _slots(slots), _capacity(capacity), _index(0),
+															 _hasChecked(false) {
 			}
 
 			Pair next() {
-				assert(_entry);
 				assert(_hasChecked);
-				_entry = _entry->next;
-				Pair pair(_entry->_key, _entry->_value);
+				assert(_index < _capacity);
+				Slot &slot = _slots[_index++];
 				_hasChecked = false;
-				return pair;
+				return Pair(slot._key, slot._value);
 			}
 
 			bool hasNext() {
 				_hasChecked = true;
-				return _entry->next;
+				while (_index < _capacity && !_slots[_index]._used)
+					_index++;
+				return _index < _capacity;
 			}
 
 		private:
+			Slot *_slots;
+			size_t _capacity;
+			size_t _index;
 			bool _hasChecked;
-			Entry _start;
-			Entry *_entry;
 		};
 
 		HashMap() :
-				_head(NULL),
+				_slots(NULL),
+				_capacity(0),
 				_size(0) {
 		}
 
 		~HashMap() {
-			clear();
+			deallocate(_slots, _capacity);
 		}
 
 		void clear() {
-			for (Entry *entry = _head; entry != NULL;) {
-				Entry *next = entry->next;
-				delete entry;
-				entry = next;
-			}
-			_head = NULL;
+			if (_size == 0) return;
+			for (size_t i = 0; i < _capacity; i++)
+				_slots[i]._used = false;
 			_size = 0;
 		}
 
@@ -108,31 +148,29 @@ namespace spine {
 			return _size;
 		}
 
+		/// Ensures at least the specified number of entries can be stored without rehashing.
+		void ensureCapacity(size_t newSize) {
+			size_t capacity = _capacity < 16 ? 16 : _capacity;
+			while (newSize * 4 > capacity * 3)
+				capacity <<= 1;
+			if (capacity != _capacity) rehash(capacity);
+		}
+
 		void put(const K &key, const V &value) {
-			Entry *entry = find(key);
-			if (entry) {
-				entry->_key = key;
-				entry->_value = value;
-			} else {
-				entry = new(__FILE__, __LINE__) Entry();
-				entry->_key = key;
-				entry->_value = value;
-
-				Entry *oldHead = _head;
-
-				if (oldHead) {
-					_head = entry;
-					oldHead->prev = entry;
-					entry->next = oldHead;
-				} else {
-					_head = entry;
-				}
+			ensureCapacity(_size + 1);
+			size_t index = findSlot(key);
+			Slot &slot = _slots[index];
+			slot._key = key;
+			slot._value = value;
+			if (!slot._used) {
+				slot._used = true;
 				_size++;
 			}
 		}
 
 		bool addAll(Vector <K> &keys, const V &value) {
 			size_t oldSize = _size;
+			ensureCapacity(_size + keys.size());
 			for (size_t i = 0; i < keys.size(); i++) {
 				put(keys[i], value);
 			}
@@ -144,25 +182,32 @@ namespace spine {
 		}
 
 		bool remove(const K &key) {
-			Entry *entry = find(key);
-			if (!entry) return false;
-
-			Entry *prev = entry->prev;
-			Entry *next = entry->next;
-
-			if (prev) prev->next = next;
-			else _head = next;
-			if (next) next->prev = entry->prev;
-
-			delete entry;
+			if (_size == 0) return false;
+			size_t mask = _capacity - 1;
+			size_t index = findSlot(key);
+			if (!_slots[index]._used) return false;
+
+			// Shift back following entries of the probe run into the hole so lookups never stop early.
+			size_t hole = index;
+			for (size_t i = (hole + 1) & mask; _slots[i]._used; i = (i + 1) & mask) {
+				size_t ideal = H::hash(_slots[i]._key) & mask;
+				if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+					_slots[hole]._key = _slots[i]._key;
+					_slots[hole]._value = _slots[i]._value;
+					hole = i;
+				}
+			}
+			_slots[hole]._used = false;
+			_slots[hole]._key = K();
+			_slots[hole]._value = V();
 			_size--;
 
 			return true;
 		}
 
 		V operator[](const K &key) {
-			Entry *entry = find(key);
-			if (entry) return entry->_value;
+			Slot *slot = find(key);
+			if (slot) return slot->_value;
 			else {
 				assert(false);
 				return 0;
@@ -170,29 +215,57 @@ namespace spine {
 		}
 
 		Entries getEntries() const {
-			return Entries(_head);
+			return Entries(_slots, _capacity);
 		}
 
 	private:
-		Entry *find(const K &key) {
-			for (Entry *entry = _head; entry != NULL; entry = entry->next) {
-				if (entry->_key == key)
-					return entry;
+		/// Returns the index of the slot holding the key, or of the empty slot where it would be inserted.
+		/// Requires a non-empty slot array with at least one free slot.
+		size_t findSlot(const K &key) {
+			size_t mask = _capacity - 1;
+			size_t index = H::hash(key) & mask;
+			while (_slots[index]._used) {
+				if (_slots[index]._key == key) return index;
+				index = (index + 1) & mask;
 			}
-			return NULL;
+			return index;
 		}
 
-		class SP_API Entry : public SpineObject {
-		public:
-			K _key;
-			V _value;
-			Entry *next;
-			Entry *prev;
+		Slot *find(const K &key) {
+			if (_size == 0) return NULL;
+			Slot *slot = &_slots[findSlot(key)];
+			return slot->_used ? slot : NULL;
+		}
 
-			Entry() : next(NULL), prev(NULL) {}
-		};
+		void rehash(size_t newCapacity) {
+			Slot *oldSlots = _slots;
+			size_t oldCapacity = _capacity;
+
+			_slots = SpineExtension::alloc<Slot>(newCapacity, __FILE__, __LINE__);
+			for (size_t i = 0; i < newCapacity; i++)
+				new(_slots + i) Slot();
+			_capacity = newCapacity;
+
+			for (size_t i = 0; i < oldCapacity; i++) {
+				Slot &oldSlot = oldSlots[i];
+				if (!oldSlot._used) continue;
+				Slot &slot = _slots[findSlot(oldSlot._key)];
+				slot._key = oldSlot._key;
+				slot._value = oldSlot._value;
+				slot._used = true;
+			}
+			deallocate(oldSlots, oldCapacity);
+		}
+
+		static void deallocate(Slot *slots, size_t capacity) {
+			if (!slots) return;
+			for (size_t i = 0; i < capacity; i++)
+				slots[i].~Slot();
+			SpineExtension::free(slots, __FILE__, __LINE__);
+		}
 
-		Entry *_head;
+		Slot *_slots;
+		size_t _capacity;
 		size_t _size;
 	};
 }
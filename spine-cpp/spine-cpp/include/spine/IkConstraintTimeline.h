@@ -55,6 +55,11 @@ namespace spine {
 
 		void setIkConstraintIndex(int inValue) { _ikConstraintIndex = inValue; }
 
+	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 	private:
 		int _ikConstraintIndex;
 
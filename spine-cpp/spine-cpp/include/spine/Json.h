@@ -38,6 +38,8 @@
 #endif
 
 namespace spine {
+	class Arena;
+
 	class SP_API Json : public SpineObject {
 		friend class SkeletonJson;
 
@@ -51,7 +53,7 @@ namespace spine {
 		static const int JSON_ARRAY;
 		static const int JSON_OBJECT;
 
-		/* Get item "string" from object. Case insensitive. */
+		/* Get item "string" from object. Case insensitive. Objects with many children are looked up in their index. */
 		static Json *getItem(Json *object, const char *string);
 
 		static Json *getItem(Json *object, int childIndex);
@@ -70,6 +72,9 @@ namespace spine {
 		/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
 		explicit Json(const char *value);
 
+		/* If inPlace, strings are unescaped into the block, which must outlive the Json, instead of into a copy of it. */
+		Json(char *value, bool inPlace);
+
 		~Json();
 
 
@@ -84,32 +89,54 @@ namespace spine {
 
 		int _type; /* The type of the item, as above. */
 		int _size; /* The number of children. */
+		Json **_index; /* For an object with at least INDEX_SIZE children, a hash table of the children by name, else NULL. */
 
 		const char *_valueString; /* The item's string, if type==JSON_STRING */
 		int _valueInt; /* The item's number, if type==JSON_NUMBER */
 		float _valueFloat; /* The item's number, if type==JSON_NUMBER */
 
-		const char *_name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
+		/* The root has no name, so it keeps the arena in the same place. */
+		union {
+			const char *_name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
+			Arena *_arena; /* The root's arena. Holds all other items and, unless parsed in place, the strings. */
+		};
+
+		/* Objects with fewer children are searched linearly by getItem(). */
+		static const int INDEX_SIZE = 16;
+
+		/* Hands out the items of a parse from blocks allocated in the root's arena. */
+		struct Items;
+
+		void parse(char *value, bool inPlace);
 
 		/* Utility to jump whitespace and cr/lf */
 		static const char *skip(const char *inValue);
 
 		/* Parser core - when encountering text, process appropriately. */
-		static const char *parseValue(Json *item, const char *value);
+		static const char *parseValue(Json *item, const char *value, Items &items);
 
-		/* Parse the input text into an unescaped cstring, and populate item. */
+		/* Unescape a string of the input text in place, and populate item. */
 		static const char *parseString(Json *item, const char *str);
 
 		/* Parse the input text to generate a number, and populate the result into item. */
 		static const char *parseNumber(Json *item, const char *num);
 
 		/* Build an array from input text. */
-		static const char *parseArray(Json *item, const char *value);
+		static const char *parseArray(Json *item, const char *value, Items &items);
 
 		/* Build an object from the text. */
-		static const char *parseObject(Json *item, const char *value);
+		static const char *parseObject(Json *item, const char *value, Items &items);
 
 		static int json_strcasecmp(const char *s1, const char *s2);
+
+		/* A hash of the name that ignores case, like json_strcasecmp(). */
+		static size_t hashName(const char *name);
+
+		/* The number of slots in the index of an object with the number of children, a power of two. */
+		static size_t getIndexCapacity(int size);
+
+		/* Build the index of an object's children in the arena. */
+		static void buildIndex(Json *item, Arena *arena);
 	};
 }
 
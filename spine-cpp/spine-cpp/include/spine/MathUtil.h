@@ -31,6 +31,7 @@
 #define Spine_MathUtil_h
 
 #include <spine/SpineObject.h>
+#include <spine/MathPrecision.h>
 
 #include <string.h>
 
@@ -58,20 +59,39 @@ namespace spine {
 
 		static float abs(float v);
 
-		/// Returns the sine in radians from a lookup table.
+		/// Sets how sin(), cos(), sinDeg(), cosDeg(), sinCosDeg() and atan2() are evaluated. Defaults to
+		/// MathPrecision_Precise, or to MathPrecision_Fast if SPINE_FAST_MATH is defined. This is global state, set it before
+		/// skeletons are updated.
+		///
+		/// MathPrecision_Precise calls the C library in double precision.
+		///
+		/// MathPrecision_Fast uses single precision minimax polynomials. Compared to the C library, sine and cosine have a
+		/// maximum absolute error of 3e-7 for angles within +/-360 degrees or +/-2 pi radians, and atan2 has a maximum
+		/// absolute error of 5e-7 radians. The array variant of sinCosDeg() uses SSE2 or NEON, unless SPINE_NO_SIMD is
+		/// defined.
+		static void setPrecision(MathPrecision precision);
+
+		static MathPrecision getPrecision();
+
+		/// Returns the sine of an angle in radians.
 		static float sin(float radians);
 
-		/// Returns the cosine in radians from a lookup table.
+		/// Returns the cosine of an angle in radians.
 		static float cos(float radians);
 
-		/// Returns the sine in radians from a lookup table.
+		/// Returns the sine of an angle in degrees.
 		static float sinDeg(float degrees);
 
-		/// Returns the cosine in radians from a lookup table.
+		/// Returns the cosine of an angle in degrees.
 		static float cosDeg(float degrees);
 
-		/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-		/// degrees), largest error of 0.00488 radians (0.2796 degrees).
+		/// Computes the sine and cosine of an angle in degrees at once.
+		static void sinCosDeg(float degrees, float &outSin, float &outCos);
+
+		/// Computes the sines and cosines of count angles in degrees. The output arrays must not overlap the input.
+		static void sinCosDeg(const float *degrees, float *outSin, float *outCos, size_t count);
+
+		/// Returns atan2 in radians.
 		static float atan2(float y, float x);
 
 		static float acos(float v);
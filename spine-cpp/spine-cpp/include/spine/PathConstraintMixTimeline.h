@@ -56,6 +56,11 @@ namespace spine {
 
 		void setPathConstraintIndex(int inValue) { _pathConstraintIndex = inValue; }
 
+	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 	private:
 		int _pathConstraintIndex;
 
@@ -57,6 +57,10 @@ namespace spine {
 		void setPathConstraintIndex(int inValue) { _pathConstraintIndex = inValue; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _pathConstraintIndex;
 	};
 }
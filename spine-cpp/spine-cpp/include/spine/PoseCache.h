@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_PoseCache_h
+#define Spine_PoseCache_h
+
+#include <spine/HashMap.h>
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Animation;
+
+	class Skeleton;
+
+	class SkeletonData;
+
+	class Skin;
+
+	/// Shares the evaluation of animations between skeletons of the same skeleton data that play the same animation at
+	/// the same time, e.g. a crowd marching in step. The first skeleton to need the pose of an animation at a time with a
+	/// skin applies the timelines to a scratch skeleton and stores the values of the properties the animation keys. Every
+	/// other skeleton copies those values instead of applying the timelines.
+	///
+	/// Times are rounded to a multiple of the time step, so skeletons whose times differ by less than half a step share a
+	/// pose. Poses are kept until clear() is called. Clearing once per frame bounds the memory, clearing less often also
+	/// shares poses across frames, e.g. for looping animations.
+	///
+	/// Poses are keyed by Skin::getId(), so skins may be deleted while the cache holds poses for them. Those poses are
+	/// never used again and are released by clear().
+	///
+	/// Poses are used either directly with apply(), or by an AnimationState, see AnimationState::setPoseCache(). apply()
+	/// is thread safe, so a cache can be shared by skeletons updated on several threads, e.g. by a CrowdUpdater.
+	class SP_API PoseCache : public SpineObject {
+		friend class AnimationState;
+
+	public:
+		/// @param timeStep See setTimeStep().
+		/// @param world See setWorld().
+		explicit PoseCache(float timeStep = 0, bool world = false);
+
+		~PoseCache();
+
+		/// Sets the properties the animation keys to their values at the time, like Animation::apply() with an alpha of
+		/// 1 and MixBlend_Setup, except that no events are fired.
+		///
+		/// If the cache stores world transforms, the bones' world transforms are also set, as
+		/// Skeleton::updateWorldTransform() computes them when all properties the animation doesn't key are in the setup
+		/// pose, and the skeleton must not be updated afterward. The skeleton's position and scale are applied to them. This is
+		/// exact for the position and a uniform positive scale, but only approximate for other scales when constraints or
+		/// bones that don't inherit scale or reflection are involved.
+		void apply(Skeleton &skeleton, Animation &animation, float time, bool loop);
+
+		/// Deletes the cached poses. Must not be called while apply() runs on another thread.
+		void clear();
+
+		/// The time step times are rounded to before looking up a pose, 0 to share poses only between equal times.
+		/// Changing it clears the cache.
+		void setTimeStep(float timeStep);
+
+		float getTimeStep();
+
+		/// If true, the poses also store the world transforms of the bones, see apply(). Changing it clears the cache.
+		void setWorld(bool world);
+
+		bool isWorld();
+
+		size_t getPoseCount();
+
+		/// The number of times a cached pose was used.
+		int getHits();
+
+		/// The number of times a pose was computed. Threads missing the same pose at once each compute it.
+		int getMisses();
+
+	private:
+		class PoseKey : public SpineObject {
+		public:
+			SkeletonData *_skeletonData;
+			Animation *_animation;
+			int _skinId; // See Skin::getId(), -1 without a skin.
+			long long _time;
+
+			explicit PoseKey(SkeletonData *skeletonData = NULL, Animation *animation = NULL, int skinId = -1,
+							 long long time = 0);
+
+			bool operator==(const PoseKey &other) const;
+
+			size_t hash() const;
+		};
+
+		class Pose;
+
+		class Lock;
+
+		float _timeStep;
+		bool _world;
+		Lock *_lock;
+		HashMap<PoseKey, Pose *> _poses;
+		Vector<Pose *> _usedPoses, _freePoses;
+		Vector<Skeleton *> _scratchSkeletons; // The scratch skeletons not computing a pose.
+		int _hits, _misses;
+
+		/// Returns the pose for the skeleton's data and skin at the time, computing it if it isn't cached. The lock is
+		/// held only to look up and add poses, so threads computing missing poses don't block each other or hits.
+		Pose *findPose(Skeleton &skeleton, Animation &animation, float time);
+
+		/// Samples the animation with the scratch skeleton, which must have the skeleton's data, into the pose.
+		void computePose(Pose &pose, Skeleton &scratch, Skin *skin, Animation &animation, float time);
+
+		/// Sets the keyed properties and, if world is true and the pose stores them, the world transforms.
+		static void applyPose(Pose &pose, Skeleton &skeleton, bool world);
+	};
+}
+
+#endif /* Spine_PoseCache_h */
@@ -32,18 +32,43 @@
 
 #include <spine/dll.h>
 
+#include <string.h>
+
 namespace spine {
+	/// Minimal runtime type information. Every class using RTTI_DECL/RTTI_IMPL owns one static RTTI instance, whose address
+	/// identifies the class within a module. Each instance also carries a type id hashed from the class name at compile time,
+	/// so instances of the same class that were duplicated across DLL or shared library boundaries still compare equal
+	/// without a string compare. The constructors are constexpr so all instances are constant initialized and the base
+	/// chain is valid during static initialization of other translation units.
 	class SP_API RTTI {
 	public:
-		explicit RTTI(const char *className);
+		explicit constexpr RTTI(const char *className) : _className(className), _pBaseRTTI(NULL),
+														 _typeId(hashClassName(className)) {
+		}
 
-		RTTI(const char *className, const RTTI &baseRTTI);
+		constexpr RTTI(const char *className, const RTTI &baseRTTI) : _className(className), _pBaseRTTI(&baseRTTI),
+																	  _typeId(hashClassName(className)) {
+		}
 
 		const char *getClassName() const;
 
-		bool isExactly(const RTTI &rtti) const;
+		/// A hash of the class name, identical for the same class in every module.
+		unsigned int getTypeId() const {
+			return _typeId;
+		}
+
+		bool isExactly(const RTTI &rtti) const {
+			if (this == &rtti) return true;
+			// Different instances with the same type id are the same class in different modules, unless the hashes collide.
+			return _typeId == rtti._typeId && !strcmp(_className, rtti._className);
+		}
 
-		bool instanceOf(const RTTI &rtti) const;
+		bool instanceOf(const RTTI &rtti) const {
+			for (const RTTI *pCompare = this; pCompare; pCompare = pCompare->_pBaseRTTI) {
+				if (pCompare->isExactly(rtti)) return true;
+			}
+			return false;
+		}
 
 	private:
 		// Prevent copying
@@ -51,8 +76,14 @@ namespace spine {
 
 		RTTI &operator=(const RTTI &obj);
 
+		/// FNV-1a, written recursively so it can be evaluated at compile time in C++11.
+		static constexpr unsigned int hashClassName(const char *name, unsigned int hash = 2166136261u) {
+			return *name ? hashClassName(name + 1, (hash ^ (unsigned char) *name) * 16777619u) : hash;
+		}
+
 		const char *_className;
 		const RTTI *_pBaseRTTI;
+		unsigned int _typeId;
 	};
 }
 
@@ -53,6 +53,11 @@ namespace spine {
 
 		void setBoneIndex(int inValue) { _boneIndex = inValue; }
 
+	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 	private:
 		int _boneIndex;
 	};
@@ -61,6 +61,10 @@ namespace spine {
 		Attachment *getAttachment() { return _attachment; }
 
 	protected:
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		int _slotIndex;
 		Attachment *_attachment;
 
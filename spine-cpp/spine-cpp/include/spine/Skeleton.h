@@ -55,6 +55,12 @@ namespace spine {
 
 	class Attachment;
 
+	class SkeletonPose;
+
+	class ChangeTracker;
+
+	class ConstraintData;
+
 	class SP_API Skeleton : public SpineObject {
 		friend class AnimationState;
 
@@ -112,6 +118,8 @@ namespace spine {
 
 		friend class TwoColorTimeline;
 
+		friend class SkinCache;
+
 	public:
 		explicit Skeleton(SkeletonData *skeletonData);
 
@@ -123,7 +131,8 @@ namespace spine {
 
 		void printUpdateCache();
 
-		/// Updates the world transform for each bone and applies constraints.
+		/// Updates the world transform for each bone and applies constraints. The update cache is run as a program compiled
+		/// by updateCache(), see getUpdateCacheList().
 		void updateWorldTransform();
 
 		void updateWorldTransform(Bone *parent);
@@ -160,6 +169,10 @@ namespace spine {
 		/// @return May be NULL.
 		Attachment *getAttachment(int slotIndex, const String &attachmentName);
 
+		/// Finds an attachment by looking in the skin and skeletonData->defaultSkin using a precomputed hash of the name.
+		/// @param hash The hash of the name, see String::hash().
+		Attachment *getAttachment(int slotIndex, const String &attachmentName, size_t hash);
+
 		/// @param attachmentName May be empty.
 		void setAttachment(const String &slotName, const String &attachmentName);
 
@@ -186,6 +199,8 @@ namespace spine {
 
 		Vector<Bone *> &getBones();
 
+		/// The bones and constraints in the order they are updated. Changes are noticed by the next updateWorldTransform(),
+		/// so custom updatables may be added. updateCache() builds the list again, which discards them.
 		Vector<Updatable *> &getUpdateCacheList();
 
 		Vector<Slot *> &getSlots();
@@ -220,6 +235,19 @@ namespace spine {
 
 		void setScaleY(float inValue);
 
+		/// Enables or disables the structure of arrays pose block. See SkeletonPose.
+		void setUseSkeletonPose(bool inValue);
+
+		/// The pose block filled by updateWorldTransform(), or NULL if it is not enabled.
+		SkeletonPose *getSkeletonPose();
+
+		/// Enables or disables change tracking, which makes updateWorldTransform() skip the bones and constraints whose
+		/// inputs did not change since the last update. See ChangeTracker.
+		void setUseChangeTracking(bool inValue);
+
+		/// The change tracker used by updateWorldTransform(), or NULL if it is not enabled.
+		ChangeTracker *getChangeTracker();
+
 	private:
 		SkeletonData *_data;
 		Vector<Bone *> _bones;
@@ -233,6 +261,27 @@ namespace spine {
 		Color _color;
 		float _scaleX, _scaleY;
 		float _x, _y;
+		SkeletonPose *_pose;
+		ChangeTracker *_changeTracker;
+
+		enum UpdateOpcode {
+			UpdateBone, UpdateBoneRun, UpdateIkConstraint, UpdateTransformConstraint, UpdatePathConstraint, UpdateOther
+		};
+
+		/// The update cache as pairs of an opcode and the index of the bone or constraint, or of the update cache entry for
+		/// UpdateOther. Consecutive child bones using TransformMode_Normal are preceded by an UpdateBoneRun pair whose index
+		/// is the number of bones in the run.
+		Vector<int> _updateProgram;
+		/// The update cache the program was compiled for, to notice changes made through getUpdateCacheList().
+		Vector<Updatable *> _updateProgramCache;
+
+		/// A bit per constraint order, set if the constraint using the order is in the skin. See
+		/// SkeletonData::getConstraintOrder().
+		Vector<unsigned int> _skinConstraints;
+		/// Copied from the skeleton data by updateCache(), see SkeletonData::getConstraintOrder().
+		Vector<int> _constraintOrder;
+		Vector<ConstraintData *> _constraintsByOrder;
+		int _constraintOrderSerial;
 
 		void sortIkConstraint(IkConstraint *constraint);
 
@@ -246,7 +295,28 @@ namespace spine {
 
 		void sortBone(Bone *bone);
 
+		bool isSkinConstraint(ConstraintData &data);
+
 		static void sortReset(Vector<Bone *> &bones);
+
+		void updateProgram();
+
+		/// Compiles the program and collects the change tracker entries again if the update cache changed since the
+		/// program was compiled.
+		void checkUpdateProgram();
+
+		void runUpdateProgram();
+
+		/// Stores the update program and the active bones and constraints in the skin, which must be the skin used by
+		/// the last updateCache(). Later calls to updateCache() for the skin restore them instead of sorting.
+		void storeUpdateOrder(Skin &skin);
+
+		/// Restores the update order stored in the skin, or returns false if it doesn't apply to the current attachments.
+		bool restoreUpdateOrder(Skin &skin);
+
+		/// Computes the world transform of a child bone using TransformMode_Normal from its applied transform, as
+		/// Bone::updateWorldTransform() does.
+		static void updateNormalBone(Bone &bone);
 	};
 }
 
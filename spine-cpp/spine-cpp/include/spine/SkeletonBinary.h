@@ -64,6 +64,8 @@ namespace spine {
 	class Sequence;
 
 	class SP_API SkeletonBinary : public SpineObject {
+		friend class BinaryAnimationLoader;
+
 	public:
 		static const int BONE_ROTATE = 0;
 		static const int BONE_TRANSLATE = 1;
@@ -108,10 +110,49 @@ namespace spine {
 
 		String &getError() { return _error; }
 
+		/// If true, each SkeletonData is loaded into an Arena it owns: loading is mostly pointer bumps and deleting the
+		/// SkeletonData releases its memory at once. Objects the attachment loader allocates while loading belong to the
+		/// arena too. Default is false.
+		///
+		/// Strings and containers of the loaded data must only be replaced, grown or freed while its arena is current, see
+		/// SkeletonData::getArena() and Arena::setCurrent().
+		void setUseArena(bool useArena) { _useArena = useArena; }
+
+		bool getUseArena() { return _useArena; }
+
+		/// If true, readSkeletonDataFile() maps the file into memory instead of reading it, if the SpineExtension supports
+		/// mapping files. Names and other strings are then used in place rather than copied, and the mapping stays alive
+		/// until the SkeletonData is deleted. The data is then loaded into an arena as if setUseArena() was set. Default is
+		/// false.
+		void setUseMappedFile(bool useMappedFile) { _useMappedFile = useMappedFile; }
+
+		bool getUseMappedFile() { return _useMappedFile; }
+
+		/// If true, animations are only skimmed while loading and their timelines are decoded on first use, see
+		/// Animation::load() and Animation::evict(). The SkeletonData keeps the animation data of the binary until it is
+		/// deleted, or the mapped file if the file was mapped. Default is false.
+		void setLazyAnimations(bool lazyAnimations) { _lazyAnimations = lazyAnimations; }
+
+		bool getLazyAnimations() { return _lazyAnimations; }
+
+		/// If true, weighted meshes get a fixed width skinning layout, see VertexAttachment::buildSkinningLayout(). This
+		/// speeds up computing world vertices for the cost of more memory per vertex. Default is false.
+		void setSkinningLayout(bool skinningLayout) { _skinningLayout = skinningLayout; }
+
+		bool getSkinningLayout() { return _skinningLayout; }
+
+		/// If true, the timelines are compressed when they are decoded, see Animation::compress(). This reduces the memory
+		/// used by animations for a small cost when applying them and a small loss of precision. Default is false.
+		void setCompressAnimations(bool compressAnimations) { _compressAnimations = compressAnimations; }
+
+		bool getCompressAnimations() { return _compressAnimations; }
+
 	private:
 		struct DataInput : public SpineObject {
 			const unsigned char *cursor;
 			const unsigned char *end;
+			/// Whether strings may be terminated in place, which requires a writable copy of the binary.
+			bool inPlace;
 		};
 
 		AttachmentLoader *_attachmentLoader;
@@ -119,6 +160,17 @@ namespace spine {
 		String _error;
 		float _scale;
 		const bool _ownsLoader;
+		bool _useArena;
+		bool _useMappedFile;
+		bool _lazyAnimations;
+		bool _skinningLayout;
+		bool _compressAnimations;
+
+		SkeletonBinary();
+
+		SkeletonData *readSkeletonData(const unsigned char *binary, int length, bool mapped);
+
+		SkeletonData *loadSkeletonData(const unsigned char *binary, int length, bool inPlace);
 
 		void setError(const char *value1, const char *value2);
 
@@ -128,6 +180,8 @@ namespace spine {
 
 		float readFloat(DataInput *input);
 
+		void readFloats(DataInput *input, float *values, int n, float scale);
+
 		unsigned char readByte(DataInput *input);
 
 		signed char readSByte(DataInput *input);
@@ -155,6 +209,12 @@ namespace spine {
 
 		Animation *readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData);
 
+		bool readTimelines(DataInput *input, SkeletonData *skeletonData, Vector<Timeline *> &timelines);
+
+		bool skipAnimation(DataInput *input, SkeletonData *skeletonData);
+
+		void skipCurveTimeline(DataInput *input, int frameCount, int frameSize, int curveCount);
+
 		void
 		setBezier(DataInput *input, CurveTimeline *timeline, int bezier, int frame, int value, float time1, float time2,
 				  float value1, float value2, float scale);
@@ -31,6 +31,7 @@
 #define Spine_SkeletonClipping_h
 
 #include <spine/Vector.h>
+#include <spine/HashMap.h>
 #include <spine/Triangulator.h>
 
 namespace spine {
@@ -42,6 +43,8 @@ namespace spine {
 	public:
 		SkeletonClipping();
 
+		~SkeletonClipping();
+
 		size_t clipStart(Slot &slot, ClippingAttachment *clip);
 
 		void clipEnd(Slot &slot);
@@ -63,6 +66,8 @@ namespace spine {
 		Vector<float> &getClippedUVs();
 
 	private:
+		class Convex;
+
 		Triangulator _triangulator;
 		Vector<float> _clippingPolygon;
 		Vector<float> _clipOutput;
@@ -72,12 +77,31 @@ namespace spine {
 		Vector<float> _scratch;
 		ClippingAttachment *_clipAttachment;
 		Vector<Vector<float> *> *_clippingPolygons;
+		Vector<Vector<float> *> _transformedPolygons;
+		Vector<Vector<float> *> _transformedPolygonPool;
+		Vector<float> _clippingBounds;
+		bool _clippingRectangle;
+
+		/// The convex decompositions of the clipping attachments that are not weighted, keyed by attachment address. Kept
+		/// here rather than on the attachments, which are shared by all skeletons of the skeleton data, so renderers on
+		/// different threads don't race to build them.
+		HashMap<long long, Convex *> _convexes;
+
+		bool transformConvexPolygons(Slot &slot, ClippingAttachment *clip);
+
+		/** Computes the bounds of each clipping polygon and whether the clipping area is an axis aligned rectangle. */
+		void updateClippingBounds();
 
 		/** Clips the input triangle against the convex, clockwise clipping area. If the triangle lies entirely within the clipping
 		  * area, false is returned. The clipping area must duplicate the first vertex at the end of the vertices list. */
 		bool clip(float x1, float y1, float x2, float y2, float x3, float y3, Vector<float> *clippingArea,
 				  Vector<float> *output);
 
+		/** Clips the input triangle against an axis aligned rectangle. Returns the number of vertices written to output,
+		  * which must have room for 7 vertices. */
+		static int clipRectangle(float x1, float y1, float x2, float y2, float x3, float y3, const float *bounds,
+								 float *output);
+
 		static void makeClockwise(Vector<float> &polygon);
 	};
 }
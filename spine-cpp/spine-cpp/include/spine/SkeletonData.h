@@ -30,12 +30,17 @@
 #ifndef Spine_SkeletonData_h
 #define Spine_SkeletonData_h
 
+#include <spine/Arena.h>
+#include <spine/HashMap.h>
+#include <spine/Property.h>
 #include <spine/Vector.h>
 #include <spine/SpineString.h>
 
 namespace spine {
 	class BoneData;
 
+	class ConstraintData;
+
 	class SlotData;
 
 	class Skin;
@@ -44,6 +49,8 @@ namespace spine {
 
 	class Animation;
 
+	class AnimationLoader;
+
 	class IkConstraintData;
 
 	class TransformConstraintData;
@@ -156,7 +163,26 @@ namespace spine {
 
 		void setFps(float inValue);
 
+		/// The arena owning the memory of this skeleton data, or NULL. See SkeletonBinary::setUseArena().
+		Arena *getArena();
+
+		/// Deletes the decoded timelines of all lazily loaded animations, see Animation::evict().
+		void evictAnimations();
+
+		/// Returns the dense index of the property, assigning the next unused index the first time the property is seen.
+		/// The indices let AnimationState track the properties of its animations with bitsets, see
+		/// Animation::indexProperties(). Thread safe.
+		int getPropertyIndex(PropertyId id);
+
+		/// The number of property indices assigned so far. Thread safe.
+		int getPropertyCount();
+
 	private:
+		static const int ConstraintIk = 0;
+		static const int ConstraintTransform = 1;
+		static const int ConstraintPath = 2;
+
+		ArenaHolder _arena; // Must be the first member, it is released last.
 		String _name;
 		Vector<BoneData *> _bones; // Ordered parents first
 		Vector<SlotData *> _slots; // Setup pose draw order.
@@ -176,6 +202,25 @@ namespace spine {
 		float _fps;
 		String _imagesPath;
 		String _audioPath;
+
+		AnimationLoader *_animationLoader;
+		HashMap<PropertyId, int> _propertyIndices;
+		Vector<int> _constraintOrder; // Per order, the constraint type and index, see getConstraintOrder().
+		Vector<ConstraintData *> _constraintsByOrder; // Per order, the constraint data, or NULL.
+		// The IK, transform and path constraints and their orders when the constraint order was computed.
+		Vector<ConstraintData *> _constraintOrderData;
+		Vector<size_t> _constraintOrderValues;
+		int _constraintOrderSerial; // Incremented each time the constraint order is computed.
+
+		/// Returns the constraint at the index into the IK, then transform, then path constraints, and its type and index
+		/// in its own list.
+		ConstraintData *getConstraint(size_t i, int &type, int &index);
+
+		/// Copies pairs of a constraint type and the index of the constraint with that type, for each order value below
+		/// the number of constraints that a constraint uses, and the constraint data per order value, or NULL. If several
+		/// constraints use an order, the first IK, then transform, then path constraint is used. Computed again when a
+		/// constraint or its order changes. Returns a number that changes each time the order is computed. Thread safe.
+		int getConstraintOrder(Vector<int> &constraintOrder, Vector<ConstraintData *> &constraintsByOrder);
 	};
 }
 
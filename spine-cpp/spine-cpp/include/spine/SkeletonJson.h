@@ -77,12 +77,34 @@ namespace spine {
 
 		String &getError() { return _error; }
 
+		/// See SkeletonBinary::setUseArena().
+		void setUseArena(bool useArena) { _useArena = useArena; }
+
+		bool getUseArena() { return _useArena; }
+
+		/// See SkeletonBinary::setSkinningLayout().
+		void setSkinningLayout(bool skinningLayout) { _skinningLayout = skinningLayout; }
+
+		bool getSkinningLayout() { return _skinningLayout; }
+
+		/// See SkeletonBinary::setCompressAnimations().
+		void setCompressAnimations(bool compressAnimations) { _compressAnimations = compressAnimations; }
+
+		bool getCompressAnimations() { return _compressAnimations; }
+
 	private:
 		AttachmentLoader *_attachmentLoader;
 		Vector<LinkedMesh *> _linkedMeshes;
 		float _scale;
 		const bool _ownsLoader;
 		String _error;
+		bool _useArena;
+		bool _skinningLayout;
+		bool _compressAnimations;
+
+		SkeletonData *readSkeletonData(const char *json, bool inPlace);
+
+		SkeletonData *loadSkeletonData(const char *json, bool inPlace);
 
 		static Sequence *readSequence(Json *sequence);
 
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_SkeletonPose_h
+#define Spine_SkeletonPose_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Bone;
+
+	class Skeleton;
+
+	/// Structure of arrays pose of the bones of a skeleton, indexed by bone index. Enabled per skeleton with
+	/// Skeleton::setUseSkeletonPose(). While enabled, Skeleton::updateWorldTransform() computes runs of bones using
+	/// TransformMode_Normal with a batched kernel: the applied transforms of a run are gathered into the arrays, the world
+	/// transforms are computed from and into the arrays, then written back to the bones once, as constraints and
+	/// attachments read them from the bones.
+	///
+	/// The kernel evaluates sines and cosines with the array variant of MathUtil::sinCosDeg(), which is vectorized when
+	/// MathUtil::setPrecision() selects MathPrecision_Fast. World transforms may then differ in the last bits from bones
+	/// updated by Bone::updateWorldTransform().
+	///
+	/// The block is not used while change tracking is enabled, see Skeleton::setUseChangeTracking().
+	class SP_API SkeletonPose : public SpineObject {
+		friend class Skeleton;
+
+	public:
+		explicit SkeletonPose(Skeleton &skeleton);
+
+		~SkeletonPose();
+
+		size_t getBoneCount();
+
+		/// The applied transforms the kernel computed the world transforms from.
+		Vector<float> &getAX();
+
+		Vector<float> &getAY();
+
+		Vector<float> &getARotation();
+
+		Vector<float> &getAScaleX();
+
+		Vector<float> &getAScaleY();
+
+		Vector<float> &getAShearX();
+
+		Vector<float> &getAShearY();
+
+		/// The world transforms computed by the kernel, a 2x3 matrix per bone. Bones updated otherwise, or changed by a
+		/// constraint after the kernel computed them, hold their world transforms only in the Bone.
+		Vector<float> &getA();
+
+		Vector<float> &getB();
+
+		Vector<float> &getC();
+
+		Vector<float> &getD();
+
+		Vector<float> &getWorldX();
+
+		Vector<float> &getWorldY();
+
+	private:
+		Vector<Bone *> &_bones;
+		Vector<int> _parents; // The parent index of each bone, or -1 for the root.
+		Vector<float> _ax, _ay, _arotation, _ascaleX, _ascaleY, _ashearX, _ashearY;
+		Vector<float> _a, _b, _c, _d, _worldX, _worldY;
+
+		/// For each bone, the run that last computed its world transform into the arrays.
+		Vector<unsigned int> _runs;
+		unsigned int _run;
+
+		// Scratch space for the kernel: angles in, sines and cosines out.
+		Vector<float> _angles1, _angles2, _sin1, _cos1, _sin2, _cos2;
+
+		/// Computes the world transforms of a run of bones from their applied transforms and writes them back to the
+		/// bones. Each bone must use TransformMode_Normal and have a parent, which is either earlier in the run or
+		/// already up to date.
+		/// @param run The bone indices at every other element, as in the update program of Skeleton.
+		void updateWorldTransforms(const int *run, size_t count);
+	};
+}
+
+#endif /* Spine_SkeletonPose_h */
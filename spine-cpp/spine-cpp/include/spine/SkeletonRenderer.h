@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonRenderer_h
+#define Spine_SkeletonRenderer_h
+
+#include <spine/BlendMode.h>
+#include <spine/SkeletonClipping.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Skeleton;
+
+	class Slot;
+
+	class MeshAttachment;
+
+	class ChangeTracker;
+
+	/// A vertex of a RenderCommand. Colors are packed with red in the lowest byte, 0xAABBGGRR, which is RGBA byte order on
+	/// little endian machines.
+	struct SP_API RenderVertex {
+		float x, y;
+		float u, v;
+		unsigned int color;
+		/// The dark color for two color tinting, 0xff000000 if the slot has none.
+		unsigned int darkColor;
+	};
+
+	/// A batch of triangles sharing a texture and blend mode. The vertices and indices point into buffers owned by the
+	/// SkeletonRenderer that produced the command.
+	struct SP_API RenderCommand {
+		RenderVertex *vertices;
+		int numVertices;
+		/// The triangle indices, relative to vertices. Exactly one of indices and indices32 is set, see
+		/// SkeletonRenderer::setUse32BitIndices().
+		unsigned short *indices;
+		unsigned int *indices32;
+		int numIndices;
+		/// The renderer object of the atlas page, as set by the TextureLoader.
+		void *texture;
+		BlendMode blendMode;
+	};
+
+	/// Turns the attachments of a posed skeleton into render commands, so a backend only has to upload the buffers and draw.
+	/// Slots are visited in draw order, world vertices are computed, clipping is applied and colors are multiplied. Consecutive
+	/// slots with the same texture and blend mode are merged into a single command.
+	///
+	/// The buffers are reused for each call to render(), so after the first few frames no memory is allocated. Attachments
+	/// must be created by an AtlasAttachmentLoader, as their renderer objects are expected to be AtlasRegions.
+	///
+	/// If the skeleton uses change tracking, see Skeleton::setUseChangeTracking(), the world vertices of each mesh are kept
+	/// and reused until the world transform of one of its bones or the slot's deform changes.
+	class SP_API SkeletonRenderer : public SpineObject {
+	public:
+		SkeletonRenderer();
+
+		~SkeletonRenderer();
+
+		/// Builds the render commands for the skeleton's current world transforms. The commands and their buffers remain valid
+		/// until the next call.
+		Vector<RenderCommand> &render(Skeleton &skeleton);
+
+		/// The commands built by the last call to render().
+		Vector<RenderCommand> &getCommands();
+
+		/// If true, commands use 32 bit indices and each command may reference any number of vertices. Otherwise commands
+		/// use 16 bit indices and are split so none references more than 65536 vertices. Default is false.
+		void setUse32BitIndices(bool use32BitIndices);
+
+		bool getUse32BitIndices();
+
+	private:
+		struct VertexCache : public SpineObject {
+			MeshAttachment *attachment;
+			/// The indices of the bones the attachment's vertices depend on.
+			Vector<int> bones;
+			/// Per bone, its world version when the vertices were computed.
+			Vector<unsigned int> versions;
+			Vector<float> deform;
+			Vector<float> worldVertices;
+		};
+
+		SkeletonClipping _clipping;
+		Vector<float> _worldVertices;
+		Vector<unsigned short> _quadIndices;
+		Vector<RenderVertex> _vertices;
+		Vector<unsigned short> _indices;
+		Vector<unsigned int> _indices32;
+		Vector<RenderCommand> _commands;
+		bool _use32BitIndices;
+		/// Per slot index, the world vertices of the slot's mesh. Only used with change tracking.
+		Vector<VertexCache *> _vertexCaches;
+		int _cacheTrackerId;
+
+		void computeWorldVertices(ChangeTracker &tracker, Slot &slot, MeshAttachment *mesh, float *worldVertices,
+								  size_t stride);
+	};
+}
+
+#endif /* Spine_SkeletonRenderer_h */
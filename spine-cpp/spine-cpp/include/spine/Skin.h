@@ -42,12 +42,16 @@ namespace spine {
 
 	class ConstraintData;
 
+	class SkeletonData;
+
 /// Stores attachments by slot index and attachment name.
 /// See SkeletonData::getDefaultSkin, Skeleton::getSkin, and
 /// http://esotericsoftware.com/spine-runtime-skins in the Spine Runtimes Guide.
 	class SP_API Skin : public SpineObject {
 		friend class Skeleton;
 
+		friend class SkinCache;
+
 	public:
 		class SP_API AttachmentMap : public SpineObject {
 			friend class Skin;
@@ -57,11 +61,13 @@ namespace spine {
 				size_t _slotIndex;
 				String _name;
 				Attachment *_attachment;
+				size_t _hash; // The hash of the name, see String::hash().
 
 				Entry(size_t slotIndex, const String &name, Attachment *attachment) :
 						_slotIndex(slotIndex),
 						_name(name),
-						_attachment(attachment) {
+						_attachment(attachment),
+						_hash(name.hash()) {
 				}
 			};
 
@@ -101,6 +107,9 @@ namespace spine {
 
 			Attachment *get(size_t slotIndex, const String &attachmentName);
 
+			/// @param hash The hash of the name, see String::hash().
+			Attachment *get(size_t slotIndex, const String &attachmentName, size_t hash);
+
 			void remove(size_t slotIndex, const String &attachmentName);
 
 			Entries getEntries();
@@ -109,10 +118,19 @@ namespace spine {
 			AttachmentMap();
 
 		private:
+			/// Buckets with more entries are indexed by a hash table.
+			static const size_t MaxLinearBucket = 8;
+
+			int findInBucket(size_t slotIndex, const String &attachmentName, size_t hash);
 
-			int findInBucket(Vector <Entry> &, const String &attachmentName);
+			/// Adds the last entry of the bucket to the bucket's hash table, creating or growing the table if needed.
+			void indexEntry(size_t slotIndex);
+
+			void indexBucket(size_t slotIndex);
 
 			Vector <Vector<Entry>> _buckets;
+			/// Per bucket, an open addressing table of entry indices plus 1 by name hash, or empty for small buckets.
+			Vector <Vector<int>> _indices;
 		};
 
 		explicit Skin(const String &name);
@@ -126,6 +144,11 @@ namespace spine {
 		/// Returns the attachment for the specified slot index and name, or NULL.
 		Attachment *getAttachment(size_t slotIndex, const String &name);
 
+		/// Returns the attachment for the specified slot index and name, or NULL. Callers that look up the same name
+		/// repeatedly, like AttachmentTimeline, pass its precomputed hash.
+		/// @param hash The hash of the name, see String::hash().
+		Attachment *getAttachment(size_t slotIndex, const String &name, size_t hash);
+
 		// Removes the attachment from the skin.
 		void removeAttachment(size_t slotIndex, const String &name);
 
@@ -141,6 +164,10 @@ namespace spine {
 
 		const String &getName();
 
+		/// A unique ID for this skin, so caches keyed by skin can tell a skin apart from a deleted one whose memory was
+		/// reused.
+		int getId();
+
 		/// Adds all attachments, bones, and constraints from the specified skin to this skin.
 		void addSkin(Skin *other);
 
@@ -155,10 +182,23 @@ namespace spine {
 
 	private:
 		const String _name;
+		const int _id;
 		AttachmentMap _attachments;
 		Vector<BoneData *> _bones;
 		Vector<ConstraintData *> _constraints;
 
+		/// For composites built by a SkinCache, the skeleton data the update order below was computed for, else NULL.
+		SkeletonData *_updateOrderData;
+		/// The skeleton data's constraint order serial when the update order below was computed.
+		int _updateOrderSerial;
+		/// The update program of a skeleton using this skin, see Skeleton::updateCache().
+		Vector<int> _updateOrder;
+		/// Whether each bone, then each IK, transform, and path constraint is active when this skin is used.
+		Vector<bool> _updateOrderActive;
+
+		/// The attachments for the slot, or NULL if the skin has none.
+		Vector<AttachmentMap::Entry> *getSlotAttachments(size_t slotIndex);
+
 		/// Attach all attachments from this skin if the corresponding attachment from the old skin is currently attached.
 		void attachAll(Skeleton &skeleton, Skin &oldSkin);
 	};
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkinCache_h
+#define Spine_SkinCache_h
+
+#include <spine/HashMap.h>
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Skeleton;
+
+	class SkeletonData;
+
+	class Skin;
+
+	/// Shares composite skins between skeletons of the same skeleton data, e.g. mix-and-match characters that combine
+	/// component skins for the body, clothes and accessories. The first request for a sequence of component skins builds a
+	/// composite with Skin::addSkin() and stores the update cache and the bones and constraints active for it. Every
+	/// other request for the same sequence returns the same composite, and Skeleton::setSkin() restores the stored update
+	/// cache instead of sorting it again.
+	///
+	/// The cache owns the composites. They must not be changed, and skeletons using them must be given another skin
+	/// before clear() is called or the cache is deleted. getSkin() is thread safe.
+	class SP_API SkinCache : public SpineObject {
+	public:
+		explicit SkinCache(SkeletonData *skeletonData);
+
+		~SkinCache();
+
+		/// Returns the composite of the skins in the given order, building it if it isn't cached. The composite's name is
+		/// the skins' names separated by "+".
+		Skin *getSkin(Vector<Skin *> &skins);
+
+		/// Deletes the composites. Must not be called while getSkin() runs on another thread.
+		void clear();
+
+		SkeletonData *getSkeletonData();
+
+		size_t getSkinCount();
+
+		/// The number of times a cached composite was returned.
+		int getHits();
+
+		/// The number of times a composite was built.
+		int getMisses();
+
+	private:
+		class SkinKey : public SpineObject {
+		public:
+			Skin **_skins;
+			size_t _count;
+			size_t _hash;
+
+			explicit SkinKey(Skin **skins = NULL, size_t count = 0);
+
+			bool operator==(const SkinKey &other) const;
+
+			size_t hash() const;
+		};
+
+		/// A composite and the component skins its key refers to.
+		class Composite : public SpineObject {
+		public:
+			Vector<Skin *> _skins;
+			Skin *_skin;
+		};
+
+		SkeletonData *_skeletonData;
+		HashMap<SkinKey, Composite *> _composites;
+		Vector<Composite *> _compositeList;
+		Skeleton *_scratchSkeleton;
+		int _hits, _misses;
+	};
+}
+
+#endif /* Spine_SkinCache_h */
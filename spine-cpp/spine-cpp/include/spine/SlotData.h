@@ -101,6 +101,9 @@ namespace spine {
 
 		void setAttachmentName(const String &inValue);
 
+		/// The hash of the attachment name, see String::hash().
+		size_t getAttachmentNameHash();
+
 		BlendMode getBlendMode();
 
 		void setBlendMode(BlendMode inValue);
@@ -114,6 +117,7 @@ namespace spine {
 
 		bool _hasDarkColor;
 		String _attachmentName;
+		size_t _attachmentNameHash;
 		BlendMode _blendMode;
 	};
 }
@@ -85,6 +85,15 @@ namespace spine {
 			return _buffer;
 		}
 
+		/// An FNV-1a hash of the characters. Equal strings have equal hashes, so lookups of the same name can compute it
+		/// once, see Skin::getAttachment().
+		size_t hash() const {
+			size_t hash = 2166136261u;
+			for (size_t i = 0; i < _length; i++)
+				hash = (hash ^ (unsigned char) _buffer[i]) * 16777619u;
+			return hash;
+		}
+
 		void own(const String &other) {
 			if (this == &other) return;
 			if (_buffer) {
@@ -43,6 +43,8 @@ namespace spine {
 	class Event;
 
 	class SP_API Timeline : public SpineObject {
+		friend class AnimationState;
+
 	RTTI_DECL
 
 	public:
@@ -74,7 +76,19 @@ namespace spine {
 
 		virtual Vector <PropertyId> &getPropertyIds();
 
+		/// Reduces the memory used by the keys. The frames are not changed, but curve and deform timelines store their
+		/// curves and keys compactly, see CurveTimeline::compress(). Returns the largest difference between an original
+		/// and a decompressed value.
+		virtual float compress();
+
 	protected:
+		/// Like apply(), but passes the frame index hint at the cursor to Animation::search() when finding the keys for
+		/// the time. AnimationState keeps a cursor per timeline. The default calls apply() and ignores the cursor.
+		/// @param cursor The frame index hint, or NULL for no hint.
+		virtual void
+		applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+					MixDirection direction, int *cursor);
+
 		void setPropertyIds(PropertyId propertyIds[], size_t propertyIdsCount);
 
 		Vector <PropertyId> _propertyIds;
@@ -94,6 +94,17 @@ namespace spine {
 			_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
 		}
 
+		/// Reduces the capacity to the size, releasing the unused memory.
+		inline void shrinkToFit() {
+			if (_capacity == _size) return;
+			_capacity = _size;
+			if (_size == 0) {
+				deallocate(_buffer);
+				_buffer = NULL;
+			} else
+				_buffer = SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
+		}
+
 		inline void add(const T &inValue) {
 			if (_size == _capacity) {
 				// inValue might reference an element in this buffer
@@ -164,6 +175,12 @@ namespace spine {
 			return _buffer[inIndex];
 		}
 
+		inline const T &operator[](size_t inIndex) const {
+			assert(inIndex < _size);
+
+			return _buffer[inIndex];
+		}
+
 		inline friend bool operator==(Vector<T> &lhs, Vector<T> &rhs) {
 			if (lhs.size() != rhs.size()) {
 				return false;
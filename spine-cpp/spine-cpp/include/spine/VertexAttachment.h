@@ -85,12 +85,41 @@ namespace spine {
 
 		void copyTo(VertexAttachment *other);
 
+		/// Precomputes a fixed width layout of the weighted vertices, which computeWorldVertices() uses instead of decoding
+		/// the bones and vertices when computing all vertices. Vertices are grouped by their number of bones and stored as
+		/// separate arrays of local positions, weights and bone indices. No layout is built if the vertices are not
+		/// weighted, a vertex has more than MaxSkinningWidth bones or more than MaxSkinningBones bones are used. Must be
+		/// called again after the bones or vertices are changed.
+		void buildSkinningLayout();
+
+		/// Returns true if computeWorldVertices() uses the fixed width layout, see buildSkinningLayout().
+		bool hasSkinningLayout();
+
+		/// The maximum number of bones an attachment with a fixed width layout may use.
+		static const int MaxSkinningBones = 128;
+
+		/// The maximum number of bones per vertex of an attachment with a fixed width layout.
+		static const int MaxSkinningWidth = 8;
+
 	protected:
 		Vector <size_t> _bones;
 		Vector<float> _vertices;
 		size_t _worldVerticesLength;
 		Attachment *_timelineAttachment;
 
+		/// The number of vertices with 1 to MaxSkinningWidth bones in the fixed width layout, which stores the groups in that
+		/// order.
+		size_t _skinCounts[MaxSkinningWidth];
+		/// The skeleton bone indices used by the fixed width layout, which are indexed by _skinIndices.
+		Vector<int> _skinBones;
+		/// For each vertex of the layout, its index and the index of its first bone in the deform array divided by 2.
+		Vector<int> _skinVertices, _skinDeform;
+		/// For each bone of each vertex of the layout.
+		Vector<unsigned short> _skinIndices;
+		Vector<float> _skinX, _skinY, _skinWeights;
+
+		void copySkinningLayout(VertexAttachment *other);
+
 	private:
 		const int _id;
 
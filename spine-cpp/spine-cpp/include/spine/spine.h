@@ -31,23 +31,29 @@
 #define SPINE_SPINE_H_
 
 #include <spine/Animation.h>
+#include <spine/AnimationBaker.h>
+#include <spine/AnimationLoader.h>
 #include <spine/AnimationState.h>
 #include <spine/AnimationStateData.h>
+#include <spine/Arena.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
 #include <spine/AttachmentLoader.h>
 #include <spine/AttachmentTimeline.h>
 #include <spine/AttachmentType.h>
+#include <spine/BakedAnimation.h>
 #include <spine/BlendMode.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
 #include <spine/BoundingBoxAttachment.h>
+#include <spine/ChangeTracker.h>
 #include <spine/ClippingAttachment.h>
 #include <spine/Color.h>
 #include <spine/ColorTimeline.h>
 #include <spine/ConstraintData.h>
 #include <spine/ContainerUtil.h>
+#include <spine/CrowdUpdater.h>
 #include <spine/CurveTimeline.h>
 #include <spine/DeformTimeline.h>
 #include <spine/DrawOrderTimeline.h>
@@ -62,6 +68,7 @@
 #include <spine/IkConstraintTimeline.h>
 #include <spine/Json.h>
 #include <spine/LinkedMesh.h>
+#include <spine/MathPrecision.h>
 #include <spine/MathUtil.h>
 #include <spine/MeshAttachment.h>
 #include <spine/MixBlend.h>
@@ -73,6 +80,7 @@
 #include <spine/PathConstraintPositionTimeline.h>
 #include <spine/PathConstraintSpacingTimeline.h>
 #include <spine/PointAttachment.h>
+#include <spine/PoseCache.h>
 #include <spine/Pool.h>
 #include <spine/PositionMode.h>
 #include <spine/RegionAttachment.h>
@@ -87,7 +95,10 @@
 #include <spine/SkeletonClipping.h>
 #include <spine/SkeletonData.h>
 #include <spine/SkeletonJson.h>
+#include <spine/SkeletonPose.h>
+#include <spine/SkeletonRenderer.h>
 #include <spine/Skin.h>
+#include <spine/SkinCache.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
 #include <spine/SpacingMode.h>
@@ -28,21 +28,60 @@
  *****************************************************************************/
 
 #include <spine/Animation.h>
+#include <spine/AnimationLoader.h>
+#include <spine/AttachmentTimeline.h>
+#include <spine/DrawOrderTimeline.h>
 #include <spine/Event.h>
+#include <spine/EventTimeline.h>
+#include <spine/MathUtil.h>
+#include <spine/RotateTimeline.h>
 #include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
 #include <spine/Timeline.h>
 
 #include <spine/ContainerUtil.h>
 
 #include <stdint.h>
 
+#ifndef SPINE_NO_THREADS
+#include <mutex>
+#endif
+
 using namespace spine;
 
-Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) : _timelines(timelines),
+namespace {
+	// Guards indexing the properties of animations, which AnimationStates updated on several threads may share.
+#ifndef SPINE_NO_THREADS
+	std::mutex indexMutex;
+#define SPINE_INDEX_LOCK() std::lock_guard<std::mutex> lock(indexMutex)
+#else
+#define SPINE_INDEX_LOCK()
+#endif
+}
+
+Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) : _timelines(),
 																						  _timelineIds(),
-																						  _duration(duration),
-																						  _name(name) {
+																						  _timelineTypes(),
+																						  _propertyIndices(),
+																						  _propertyOffsets(),
+																						  _propertyBits(),
+																						  _propertySkeletonData(NULL),
+																						  _duration(0),
+																						  _name(name),
+																						  _loader(NULL),
+																						  _loaderIndex(0) {
 	assert(_name.length() > 0);
+	setTimelines(timelines, duration);
+}
+
+void Animation::setTimelines(Vector<Timeline *> &timelines, float duration) {
+	_timelines.clearAndAddAll(timelines);
+	_duration = duration;
+	_timelineTypes.clear();
+	_propertyIndices.clear();
+	_propertyOffsets.clear();
+	_propertyBits.clear();
+	_propertySkeletonData = NULL;
 	for (size_t i = 0; i < timelines.size(); i++) {
 		Vector<PropertyId> propertyIds = timelines[i]->getPropertyIds();
 		for (size_t ii = 0; ii < propertyIds.size(); ii++)
@@ -51,18 +90,71 @@ Animation::Animation(const String &name, Vector<Timeline *> &timelines, float du
 }
 
 bool Animation::hasTimeline(Vector<PropertyId> &ids) {
+	load();
 	for (size_t i = 0; i < ids.size(); i++) {
 		if (_timelineIds.containsKey(ids[i])) return true;
 	}
 	return false;
 }
 
+void Animation::indexProperties(SkeletonData &skeletonData) {
+	load();
+	SPINE_INDEX_LOCK();
+	if (_propertySkeletonData == &skeletonData && _timelineTypes.size() == _timelines.size()) return;
+	computePropertyIndices(skeletonData);
+}
+
+void Animation::computePropertyIndices(SkeletonData &skeletonData) {
+	// The indices are recomputed after loading, so they are allocated outside of any arena.
+	Arena *arena = Arena::setCurrent(NULL);
+	_timelineTypes.clear();
+	_propertyIndices.clear();
+	_propertyOffsets.clear();
+	_propertyBits.clear();
+	for (size_t i = 0, n = _timelines.size(); i < n; i++) {
+		const RTTI &rtti = _timelines[i]->getRTTI();
+		if (rtti.isExactly(RotateTimeline::rtti))
+			_timelineTypes.add(TimelineRotate);
+		else if (rtti.isExactly(AttachmentTimeline::rtti))
+			_timelineTypes.add(TimelineAttachment);
+		else if (rtti.isExactly(DrawOrderTimeline::rtti))
+			_timelineTypes.add(TimelineDrawOrder);
+		else if (rtti.isExactly(EventTimeline::rtti))
+			_timelineTypes.add(TimelineEvent);
+		else
+			_timelineTypes.add(TimelineOther);
+
+		_propertyOffsets.add((int) _propertyIndices.size());
+		Vector<PropertyId> &ids = _timelines[i]->getPropertyIds();
+		for (size_t ii = 0; ii < ids.size(); ii++) {
+			int index = skeletonData.getPropertyIndex(ids[ii]);
+			_propertyIndices.add(index);
+			size_t word = (size_t) index >> 5;
+			if (word >= _propertyBits.size()) _propertyBits.setSize(word + 1, 0);
+			_propertyBits[word] |= 1u << (index & 31);
+		}
+	}
+	_propertyOffsets.add((int) _propertyIndices.size());
+	_propertySkeletonData = &skeletonData;
+	Arena::setCurrent(arena);
+}
+
+bool Animation::hasProperties(const int *indices, size_t count) {
+	size_t words = _propertyBits.size();
+	for (size_t i = 0; i < count; i++) {
+		size_t word = (size_t) indices[i] >> 5;
+		if (word < words && (_propertyBits[word] & (1u << (indices[i] & 31)))) return true;
+	}
+	return false;
+}
+
 Animation::~Animation() {
 	ContainerUtil::cleanUpVectorOfPointers(_timelines);
 }
 
 void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
 					  MixBlend blend, MixDirection direction) {
+	load();
 	if (loop && _duration != 0) {
 		time = MathUtil::fmod(time, _duration);
 		if (lastTime > 0) {
@@ -80,28 +172,77 @@ const String &Animation::getName() {
 }
 
 Vector<Timeline *> &Animation::getTimelines() {
+	load();
 	return _timelines;
 }
 
 float Animation::getDuration() {
+	load();
 	return _duration;
 }
 
 void Animation::setDuration(float inValue) {
+	load();
 	_duration = inValue;
 }
 
+bool Animation::load() {
+	return !_loader || _loader->load(*this, _loaderIndex);
+}
+
+void Animation::evict() {
+	if (_loader) _loader->evict(*this, _loaderIndex);
+}
+
+bool Animation::isLoaded() {
+	return !_loader || _loader->isLoaded(_loaderIndex);
+}
+
+AnimationLoader *Animation::getLoader() {
+	return _loader;
+}
+
+float Animation::compress() {
+	float error = 0;
+	for (size_t i = 0, n = _timelines.size(); i < n; i++)
+		error = MathUtil::max(error, _timelines[i]->compress());
+	return error;
+}
+
 int Animation::search(Vector<float> &frames, float target) {
-	size_t n = (int) frames.size();
-	for (size_t i = 1; i < n; i++) {
-		if (frames[i] > target) return (int) (i - 1);
-	}
-	return (int) (n - 1);
+	return search(frames, target, 1);
 }
 
 int Animation::search(Vector<float> &frames, float target, int step) {
-	size_t n = frames.size();
-	for (size_t i = step; i < n; i += step)
-		if (frames[i] > target) return (int) (i - step);
-	return (int) (n - step);
+	return search(frames, target, step, NULL);
+}
+
+int Animation::search(Vector<float> &frames, float target, int step, int *cursor) {
+	int n = (int) frames.size();
+	if (cursor) {
+		// Try the last result and the frame after it. Frame i is the result if the next frame is after the target and,
+		// unless it's the first frame, frame i is not.
+		int i = *cursor;
+		if (i >= 0 && i % step == 0) {
+			for (int last = i + step; i <= last && i + step <= n; i += step) {
+				if (i != 0 && frames[i] > target) break;
+				if (i + step == n || frames[i + step] > target) {
+					*cursor = i;
+					return i;
+				}
+			}
+		}
+	}
+
+	// Binary search for the first frame after the target, skipping the first frame like a linear search would.
+	int low = 1, high = n / step;
+	while (low < high) {
+		int mid = (low + high) >> 1;
+		if (frames[mid * step] > target) high = mid;
+		else
+			low = mid + 1;
+	}
+	int i = (low - 1) * step;
+	if (cursor) *cursor = i;
+	return i;
 }
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/AnimationBaker.h>
+
+#include <spine/Animation.h>
+#include <spine/BakedAnimation.h>
+#include <spine/Bone.h>
+#include <spine/IkConstraint.h>
+#include <spine/MathUtil.h>
+#include <spine/PathConstraint.h>
+#include <spine/Skeleton.h>
+#include <spine/TransformConstraint.h>
+
+using namespace spine;
+
+AnimationBaker::AnimationBaker(SkeletonData *skeletonData) : _skeleton(new (__FILE__, __LINE__) Skeleton(skeletonData)) {
+}
+
+AnimationBaker::~AnimationBaker() {
+	delete _skeleton;
+}
+
+static float *sampleLocal(Skeleton &skeleton, float *values) {
+	Vector<Bone *> &bones = skeleton.getBones();
+	for (size_t i = 0, n = bones.size(); i < n; i++, values += 7) {
+		Bone &bone = *bones[i];
+		values[0] = bone.getX();
+		values[1] = bone.getY();
+		values[2] = bone.getRotation();
+		values[3] = bone.getScaleX();
+		values[4] = bone.getScaleY();
+		values[5] = bone.getShearX();
+		values[6] = bone.getShearY();
+	}
+	Vector<IkConstraint *> &ikConstraints = skeleton.getIkConstraints();
+	for (size_t i = 0, n = ikConstraints.size(); i < n; i++, values += 5) {
+		IkConstraint &constraint = *ikConstraints[i];
+		values[0] = constraint.getMix();
+		values[1] = constraint.getSoftness();
+		values[2] = (float) constraint.getBendDirection();
+		values[3] = constraint.getCompress() ? 1.0f : 0.0f;
+		values[4] = constraint.getStretch() ? 1.0f : 0.0f;
+	}
+	Vector<TransformConstraint *> &transformConstraints = skeleton.getTransformConstraints();
+	for (size_t i = 0, n = transformConstraints.size(); i < n; i++, values += 6) {
+		TransformConstraint &constraint = *transformConstraints[i];
+		values[0] = constraint.getMixRotate();
+		values[1] = constraint.getMixX();
+		values[2] = constraint.getMixY();
+		values[3] = constraint.getMixScaleX();
+		values[4] = constraint.getMixScaleY();
+		values[5] = constraint.getMixShearY();
+	}
+	Vector<PathConstraint *> &pathConstraints = skeleton.getPathConstraints();
+	for (size_t i = 0, n = pathConstraints.size(); i < n; i++, values += 5) {
+		PathConstraint &constraint = *pathConstraints[i];
+		values[0] = constraint.getPosition();
+		values[1] = constraint.getSpacing();
+		values[2] = constraint.getMixRotate();
+		values[3] = constraint.getMixX();
+		values[4] = constraint.getMixY();
+	}
+	return values;
+}
+
+static float *sampleWorld(Skeleton &skeleton, float *values) {
+	Vector<Bone *> &bones = skeleton.getBones();
+	for (size_t i = 0, n = bones.size(); i < n; i++, values += 6) {
+		Bone &bone = *bones[i];
+		values[0] = bone.getA();
+		values[1] = bone.getB();
+		values[2] = bone.getC();
+		values[3] = bone.getD();
+		values[4] = bone.getWorldX();
+		values[5] = bone.getWorldY();
+	}
+	return values;
+}
+
+BakedAnimation *AnimationBaker::bake(Animation &animation, float fps, bool world) {
+	Skeleton &skeleton = *_skeleton;
+	float duration = animation.getDuration();
+	int frameCount = (int) (duration * fps);
+	if (frameCount < duration * fps) frameCount++;
+	frameCount++;
+
+	// The values of each bone, then for local tables of each IK, transform and path constraint.
+	Vector<int> widths;
+	widths.setSize(skeleton.getBones().size(), world ? 6 : 7);
+	if (!world) {
+		widths.setSize(widths.size() + skeleton.getIkConstraints().size(), 5);
+		widths.setSize(widths.size() + skeleton.getTransformConstraints().size(), 6);
+		widths.setSize(widths.size() + skeleton.getPathConstraints().size(), 5);
+	}
+	size_t frameSize = 0;
+	for (size_t i = 0, n = widths.size(); i < n; i++)
+		frameSize += widths[i];
+
+	// Sample all frames, then store each item's values contiguously, once if they never change.
+	Vector<float> samples;
+	samples.setSize(frameCount * frameSize, 0);
+	for (int frame = 0; frame < frameCount; frame++) {
+		float time = MathUtil::min(frame / fps, duration);
+		skeleton.setToSetupPose();
+		animation.apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		float *values = samples.buffer() + frame * frameSize;
+		if (world) {
+			skeleton.updateWorldTransform();
+			sampleWorld(skeleton, values);
+		} else
+			sampleLocal(skeleton, values);
+	}
+
+	BakedAnimation *baked = new (__FILE__, __LINE__) BakedAnimation(animation.getName(), fps, duration, frameCount, world);
+	baked->_boneCount = (int) skeleton.getBones().size();
+	const float *first = samples.buffer();
+	for (size_t i = 0, n = widths.size(); i < n; first += widths[i], i++) {
+		int width = widths[i];
+		bool constant = true;
+		for (int frame = 1; frame < frameCount && constant; frame++) {
+			const float *values = first + frame * frameSize;
+			for (int ii = 0; ii < width; ii++) {
+				if (values[ii] != first[ii]) {
+					constant = false;
+					break;
+				}
+			}
+		}
+		baked->_offsets.add((int) baked->_frames.size());
+		baked->_strides.add(constant ? 0 : width);
+		for (int frame = 0, nn = constant ? 1 : frameCount; frame < nn; frame++) {
+			const float *values = first + frame * frameSize;
+			for (int ii = 0; ii < width; ii++)
+				baked->_frames.add(values[ii]);
+		}
+	}
+	return baked;
+}
+
+Skeleton &AnimationBaker::getSkeleton() {
+	return *_skeleton;
+}
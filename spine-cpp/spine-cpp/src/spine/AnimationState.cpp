@@ -33,9 +33,8 @@
 #include <spine/AttachmentTimeline.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
-#include <spine/DrawOrderTimeline.h>
 #include <spine/Event.h>
-#include <spine/EventTimeline.h>
+#include <spine/PoseCache.h>
 #include <spine/RotateTimeline.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonData.h>
@@ -192,6 +191,7 @@ void TrackEntry::reset() {
 	_timelineMode.clear();
 	_timelineHoldMix.clear();
 	_timelinesRotation.clear();
+	_timelineCursors.clear();
 
 	_listener = dummyOnAnimationEventFunc;
 	_listenerObject = NULL;
@@ -320,7 +320,8 @@ AnimationState::AnimationState(AnimationStateData *data) : _data(data),
 														   _listener(dummyOnAnimationEventFunc),
 														   _listenerObject(NULL),
 														   _unkeyedState(0),
-														   _timeScale(1) {
+														   _timeScale(1),
+														   _poseCache(NULL) {
 }
 
 AnimationState::~AnimationState() {
@@ -444,23 +445,40 @@ bool AnimationState::apply(Skeleton &skeleton) {
 			applyTime = current._animation->getDuration() - applyTime;
 			applyEvents = NULL;
 		}
-		size_t timelineCount = current._animation->_timelines.size();
-		Vector<Timeline *> &timelines = current._animation->_timelines;
-		if ((i == 0 && mix == 1) || blend == MixBlend_Add) {
+		Animation *animation = current._animation;
+		size_t timelineCount = animation->_timelines.size();
+		Timeline **timelines = animation->_timelines.buffer();
+		const int *timelineTypes = animation->_timelineTypes.buffer();
+		if (current._timelineCursors.size() != timelineCount) current._timelineCursors.setSize(timelineCount, 0);
+		int *timelineCursors = current._timelineCursors.buffer();
+		if (_poseCache && i == 0 && mix == 1) {
+			// The cached pose replaces all timelines but the events. Attachments are set as applyAttachmentTimeline() does.
+			PoseCache::applyPose(*_poseCache->findPose(skeleton, *animation, applyTime), skeleton, false);
+			for (size_t ii = 0; ii < timelineCount; ++ii) {
+				if (timelineTypes[ii] == Animation::TimelineEvent) {
+					timelines[ii]->applyCursor(skeleton, animationLast, applyTime, applyEvents, mix, blend, MixDirection_In,
+											   &timelineCursors[ii]);
+				} else if (timelineTypes[ii] == Animation::TimelineAttachment) {
+					Slot *slot = skeleton.getSlots()[static_cast<AttachmentTimeline *>(timelines[ii])->getSlotIndex()];
+					if (slot->getBone().isActive()) slot->setAttachmentState(_unkeyedState + Current);
+				}
+			}
+		} else if ((i == 0 && mix == 1) || blend == MixBlend_Add) {
 			for (size_t ii = 0; ii < timelineCount; ++ii) {
 				Timeline *timeline = timelines[ii];
-				if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
+				if (timelineTypes[ii] == Animation::TimelineAttachment)
 					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime, blend,
-											true);
+											true, &timelineCursors[ii]);
 				else
-					timeline->apply(skeleton, animationLast, applyTime, applyEvents, mix, blend, MixDirection_In);
+					timeline->applyCursor(skeleton, animationLast, applyTime, applyEvents, mix, blend, MixDirection_In,
+										  &timelineCursors[ii]);
 			}
 		} else {
-			Vector<int> &timelineMode = current._timelineMode;
+			const int *timelineMode = current._timelineMode.buffer();
 
 			bool shortestRotation = current._shortestRotation;
-			bool firstFrame = !shortestRotation && current._timelinesRotation.size() != timelines.size() << 1;
-			if (firstFrame) current._timelinesRotation.setSize(timelines.size() << 1, 0);
+			bool firstFrame = !shortestRotation && current._timelinesRotation.size() != timelineCount << 1;
+			if (firstFrame) current._timelinesRotation.setSize(timelineCount << 1, 0);
 			Vector<float> &timelinesRotation = current._timelinesRotation;
 
 			for (size_t ii = 0; ii < timelineCount; ++ii) {
@@ -469,15 +487,25 @@ bool AnimationState::apply(Skeleton &skeleton) {
 
 				MixBlend timelineBlend = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
 
-				if (!shortestRotation && timeline->getRTTI().isExactly(RotateTimeline::rtti))
-					applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, applyTime, mix,
-										timelineBlend, timelinesRotation, ii << 1, firstFrame);
-				else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime,
-											timelineBlend, true);
-				else
-					timeline->apply(skeleton, animationLast, applyTime, applyEvents, mix, timelineBlend,
-									MixDirection_In);
+				switch (timelineTypes[ii]) {
+					case Animation::TimelineRotate:
+						if (!shortestRotation) {
+							applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, applyTime, mix,
+												timelineBlend, timelinesRotation, ii << 1, firstFrame,
+												&timelineCursors[ii]);
+							break;
+						}
+						timeline->applyCursor(skeleton, animationLast, applyTime, applyEvents, mix, timelineBlend,
+											  MixDirection_In, &timelineCursors[ii]);
+						break;
+					case Animation::TimelineAttachment:
+						applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime,
+												timelineBlend, true, &timelineCursors[ii]);
+						break;
+					default:
+						timeline->applyCursor(skeleton, animationLast, applyTime, applyEvents, mix, timelineBlend,
+											  MixDirection_In, &timelineCursors[ii]);
+				}
 			}
 		}
 
@@ -492,8 +520,11 @@ bool AnimationState::apply(Skeleton &skeleton) {
 	for (int i = 0, n = (int) slots.size(); i < n; i++) {
 		Slot *slot = slots[i];
 		if (slot->getAttachmentState() == setupState) {
-			const String &attachmentName = slot->getData().getAttachmentName();
-			slot->setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot->getData().getIndex(), attachmentName));
+			SlotData &slotData = slot->getData();
+			const String &attachmentName = slotData.getAttachmentName();
+			slot->setAttachment(attachmentName.isEmpty() ? NULL
+														: skeleton.getAttachment(slotData.getIndex(), attachmentName,
+																				 slotData.getAttachmentNameHash()));
 		}
 	}
 	_unkeyedState += 2;
@@ -648,6 +679,14 @@ void AnimationState::setTimeScale(float inValue) {
 	_timeScale = inValue;
 }
 
+void AnimationState::setPoseCache(PoseCache *poseCache) {
+	_poseCache = poseCache;
+}
+
+PoseCache *AnimationState::getPoseCache() {
+	return _poseCache;
+}
+
 void AnimationState::setListener(AnimationStateListener inValue) {
 	_listener = inValue;
 	_listenerObject = NULL;
@@ -673,17 +712,19 @@ Animation *AnimationState::getEmptyAnimation() {
 }
 
 void AnimationState::applyAttachmentTimeline(AttachmentTimeline *attachmentTimeline, Skeleton &skeleton, float time,
-											 MixBlend blend, bool attachments) {
+											 MixBlend blend, bool attachments, int *cursor) {
 	Slot *slot = skeleton.getSlots()[attachmentTimeline->getSlotIndex()];
 	if (!slot->getBone().isActive()) return;
 
 	Vector<float> &frames = attachmentTimeline->getFrames();
 	if (time < frames[0]) {
 		if (blend == MixBlend_Setup || blend == MixBlend_First)
-			setAttachment(skeleton, *slot, slot->getData().getAttachmentName(), attachments);
+			setAttachment(skeleton, *slot, slot->getData().getAttachmentName(),
+						  slot->getData().getAttachmentNameHash(), attachments);
 	} else {
-		setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[Animation::search(frames, time)],
-					  attachments);
+		int frame = Animation::search(frames, time, 1, cursor);
+		setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[frame],
+					  attachmentTimeline->getAttachmentNameHashes()[frame], attachments);
 	}
 
 	/* If an attachment wasn't set (ie before the first frame or attachments is false), set the setup attachment later.*/
@@ -692,11 +733,12 @@ void AnimationState::applyAttachmentTimeline(AttachmentTimeline *attachmentTimel
 
 
 void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleton &skeleton, float time, float alpha,
-										 MixBlend blend, Vector<float> &timelinesRotation, size_t i, bool firstFrame) {
+										 MixBlend blend, Vector<float> &timelinesRotation, size_t i, bool firstFrame,
+										 int *cursor) {
 	if (firstFrame) timelinesRotation[i] = 0;
 
 	if (alpha == 1) {
-		rotateTimeline->apply(skeleton, 0, time, NULL, 1, blend, MixDirection_In);
+		rotateTimeline->applyCursor(skeleton, 0, time, NULL, 1, blend, MixDirection_In, cursor);
 		return;
 	}
 
@@ -716,7 +758,7 @@ void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleto
 		}
 	} else {
 		r1 = blend == MixBlend_Setup ? bone->_data._rotation : bone->_rotation;
-		r2 = bone->_data._rotation + rotateTimeline->getCurveValue(time);
+		r2 = bone->_data._rotation + rotateTimeline->getCurveValue(time, cursor);
 	}
 
 	// Mix between rotations using the direction of the shortest route on the first frame while detecting crosses.
@@ -799,40 +841,48 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	}
 
 	bool attachments = mix < from->_attachmentThreshold, drawOrder = mix < from->_drawOrderThreshold;
-	Vector<Timeline *> &timelines = from->_animation->_timelines;
-	size_t timelineCount = timelines.size();
+	Animation *animation = from->_animation;
+	size_t timelineCount = animation->_timelines.size();
+	Timeline **timelines = animation->_timelines.buffer();
+	const int *timelineTypes = animation->_timelineTypes.buffer();
 	float alphaHold = from->_alpha * to->_interruptAlpha, alphaMix = alphaHold * (1 - mix);
 	float animationLast = from->_animationLast, animationTime = from->getAnimationTime();
 	float applyTime = animationTime;
 	Vector<Event *> *events = NULL;
 	if (from->_reverse) {
-		applyTime = from->_animation->_duration - applyTime;
+		applyTime = animation->_duration - applyTime;
 	} else {
 		if (mix < from->_eventThreshold) events = &_events;
 	}
 
+	if (from->_timelineCursors.size() != timelineCount) from->_timelineCursors.setSize(timelineCount, 0);
+	int *timelineCursors = from->_timelineCursors.buffer();
+
 	if (blend == MixBlend_Add) {
-		for (size_t i = 0; i < timelineCount; i++)
-			timelines[i]->apply(skeleton, animationLast, applyTime, events, alphaMix, blend, MixDirection_Out);
+		for (size_t i = 0; i < timelineCount; i++) {
+			timelines[i]->applyCursor(skeleton, animationLast, applyTime, events, alphaMix, blend, MixDirection_Out,
+									  &timelineCursors[i]);
+		}
 	} else {
-		Vector<int> &timelineMode = from->_timelineMode;
-		Vector<TrackEntry *> &timelineHoldMix = from->_timelineHoldMix;
+		const int *timelineMode = from->_timelineMode.buffer();
+		TrackEntry **timelineHoldMix = from->_timelineHoldMix.buffer();
 
 		bool shortestRotation = from->_shortestRotation;
-		bool firstFrame = !shortestRotation && from->_timelinesRotation.size() != timelines.size() << 1;
-		if (firstFrame) from->_timelinesRotation.setSize(timelines.size() << 1, 0);
+		bool firstFrame = !shortestRotation && from->_timelinesRotation.size() != timelineCount << 1;
+		if (firstFrame) from->_timelinesRotation.setSize(timelineCount << 1, 0);
 
 		Vector<float> &timelinesRotation = from->_timelinesRotation;
 
 		from->_totalAlpha = 0;
 		for (size_t i = 0; i < timelineCount; i++) {
 			Timeline *timeline = timelines[i];
+			int timelineType = timelineTypes[i];
 			MixDirection direction = MixDirection_Out;
 			MixBlend timelineBlend;
 			float alpha;
 			switch (timelineMode[i]) {
 				case Subsequent:
-					if (!drawOrder && (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))) continue;
+					if (!drawOrder && timelineType == Animation::TimelineDrawOrder) continue;
 					timelineBlend = blend;
 					alpha = alphaMix;
 					break;
@@ -855,17 +905,28 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 					break;
 			}
 			from->_totalAlpha += alpha;
-			if (!shortestRotation && (timeline->getRTTI().isExactly(RotateTimeline::rtti))) {
-				applyRotateTimeline((RotateTimeline *) timeline, skeleton, applyTime, alpha, timelineBlend,
-									timelinesRotation, i << 1, firstFrame);
-			} else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
-				applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime, timelineBlend,
-										attachments);
-			} else {
-				if (drawOrder && timeline->getRTTI().isExactly(DrawOrderTimeline::rtti) &&
-					timelineBlend == MixBlend_Setup)
-					direction = MixDirection_In;
-				timeline->apply(skeleton, animationLast, applyTime, events, alpha, timelineBlend, direction);
+			switch (timelineType) {
+				case Animation::TimelineRotate:
+					if (!shortestRotation) {
+						applyRotateTimeline((RotateTimeline *) timeline, skeleton, applyTime, alpha, timelineBlend,
+											timelinesRotation, i << 1, firstFrame, &timelineCursors[i]);
+						break;
+					}
+					timeline->applyCursor(skeleton, animationLast, applyTime, events, alpha, timelineBlend, direction,
+										  &timelineCursors[i]);
+					break;
+				case Animation::TimelineAttachment:
+					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime,
+											timelineBlend, attachments, &timelineCursors[i]);
+					break;
+				case Animation::TimelineDrawOrder:
+					if (drawOrder && timelineBlend == MixBlend_Setup) direction = MixDirection_In;
+					timeline->applyCursor(skeleton, animationLast, applyTime, events, alpha, timelineBlend, direction,
+										  &timelineCursors[i]);
+					break;
+				default:
+					timeline->applyCursor(skeleton, animationLast, applyTime, events, alpha, timelineBlend, direction,
+										  &timelineCursors[i]);
 			}
 		}
 	}
@@ -881,9 +942,10 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	return mix;
 }
 
-void AnimationState::setAttachment(Skeleton &skeleton, Slot &slot, const String &attachmentName, bool attachments) {
+void AnimationState::setAttachment(Skeleton &skeleton, Slot &slot, const String &attachmentName, size_t hash,
+								   bool attachments) {
 	slot.setAttachment(
-			attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot.getData().getIndex(), attachmentName));
+			attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot.getData().getIndex(), attachmentName, hash));
 	if (attachments) slot.setAttachmentState(_unkeyedState + Current);
 }
 
@@ -951,6 +1013,7 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 	TrackEntry *entryP = _trackEntryPool.obtain();// Pooling
 	TrackEntry &entry = *entryP;
 
+	animation->indexProperties(*_data->getSkeletonData());
 	entry._trackIndex = (int) trackIndex;
 	entry._animation = animation;
 	entry._loop = loop;
@@ -997,7 +1060,8 @@ void AnimationState::clearNext(TrackEntry *entry) {
 void AnimationState::animationsChanged() {
 	_animationsChanged = false;
 
-	_propertyIDs.clear();
+	for (size_t i = 0, n = _propertyBits.size(); i < n; ++i)
+		_propertyBits[i] = 0;
 
 	for (size_t i = 0, n = _tracks.size(); i < n; ++i) {
 		TrackEntry *entry = _tracks[i];
@@ -1013,19 +1077,34 @@ void AnimationState::animationsChanged() {
 	}
 }
 
+bool AnimationState::addProperties(const int *indices, size_t count) {
+	bool added = false;
+	for (size_t i = 0; i < count; i++) {
+		size_t word = (size_t) indices[i] >> 5;
+		unsigned int bit = 1u << (indices[i] & 31);
+		if (word >= _propertyBits.size()) _propertyBits.setSize(word + 1, 0);
+		if (_propertyBits[word] & bit) continue;
+		_propertyBits[word] |= bit;
+		added = true;
+	}
+	return added;
+}
+
 void AnimationState::computeHold(TrackEntry *entry) {
 	TrackEntry *to = entry->_mixingTo;
-	Vector<Timeline *> &timelines = entry->_animation->_timelines;
-	size_t timelinesCount = timelines.size();
+	Animation *animation = entry->_animation;
+	size_t timelinesCount = animation->_timelines.size();
 	Vector<int> &timelineMode = entry->_timelineMode;
 	timelineMode.setSize(timelinesCount, 0);
 	Vector<TrackEntry *> &timelineHoldMix = entry->_timelineHoldMix;
 	timelineHoldMix.setSize(timelinesCount, 0);
+	const int *timelineTypes = animation->_timelineTypes.buffer();
+	const int *indices = animation->_propertyIndices.buffer();
+	const int *offsets = animation->_propertyOffsets.buffer();
 
 	if (to != NULL && to->_holdPrevious) {
-		for (size_t i = 0; i < timelinesCount; i++) {
-			timelineMode[i] = _propertyIDs.addAll(timelines[i]->getPropertyIds(), true) ? HoldFirst : HoldSubsequent;
-		}
+		for (size_t i = 0; i < timelinesCount; i++)
+			timelineMode[i] = addProperties(indices + offsets[i], offsets[i + 1] - offsets[i]) ? HoldFirst : HoldSubsequent;
 		return;
 	}
 
@@ -1033,18 +1112,19 @@ void AnimationState::computeHold(TrackEntry *entry) {
 	size_t i = 0;
 continue_outer:
 	for (; i < timelinesCount; ++i) {
-		Timeline *timeline = timelines[i];
-		Vector<PropertyId> &ids = timeline->getPropertyIds();
-		if (!_propertyIDs.addAll(ids, true)) {
+		const int *ids = indices + offsets[i];
+		size_t count = offsets[i + 1] - offsets[i];
+		if (!addProperties(ids, count)) {
 			timelineMode[i] = Subsequent;
 		} else {
-			if (to == NULL || timeline->getRTTI().isExactly(AttachmentTimeline::rtti) ||
-				timeline->getRTTI().isExactly(DrawOrderTimeline::rtti) ||
-				timeline->getRTTI().isExactly(EventTimeline::rtti) || !to->_animation->hasTimeline(ids)) {
+			int timelineType = timelineTypes[i];
+			if (to == NULL || timelineType == Animation::TimelineAttachment ||
+				timelineType == Animation::TimelineDrawOrder || timelineType == Animation::TimelineEvent ||
+				!to->_animation->hasProperties(ids, count)) {
 				timelineMode[i] = First;
 			} else {
 				for (TrackEntry *next = to->_mixingTo; next != NULL; next = next->_mixingTo) {
-					if (next->_animation->hasTimeline(ids)) continue;
+					if (next->_animation->hasProperties(ids, count)) continue;
 					if (next->_mixDuration > 0) {
 						timelineMode[i] = HoldMix;
 						timelineHoldMix[i] = next;
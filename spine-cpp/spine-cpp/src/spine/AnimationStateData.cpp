@@ -84,3 +84,14 @@ AnimationStateData::AnimationPair::AnimationPair(Animation *a1, Animation *a2) :
 bool AnimationStateData::AnimationPair::operator==(const AnimationPair &other) const {
 	return _a1->_name == other._a1->_name && _a2->_name == other._a2->_name;
 }
+
+size_t AnimationStateData::AnimationPair::hash() const {
+	// Equality compares animation names, so the hash must be derived from the names as well (FNV-1a).
+	size_t h = 2166136261u;
+	for (const char *c = _a1->_name.buffer(); c && *c; c++)
+		h = (h ^ (unsigned char) *c) * 16777619u;
+	h = (h ^ 0xff) * 16777619u;
+	for (const char *c = _a2->_name.buffer(); c && *c; c++)
+		h = (h ^ (unsigned char) *c) * 16777619u;
+	return h;
+}
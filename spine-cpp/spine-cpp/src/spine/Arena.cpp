@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/Arena.h>
+
+#include <spine/Extension.h>
+
+#include <string.h>
+
+using namespace spine;
+
+namespace spine {
+	struct ArenaChunk {
+		ArenaChunk *next;
+		size_t size;
+		size_t used;
+	};
+
+	struct ArenaAdopted {
+		ArenaAdopted *next;
+		void *memory;
+		size_t size;
+		void (*release)(void *memory, size_t size);
+	};
+
+	struct ArenaRange {
+		const char *start, *end;
+		bool adopted;
+	};
+}
+
+namespace {
+	// Each allocation is preceded by its size, which keeps the payload 8 byte aligned.
+	const size_t HEADER_SIZE = 8;
+
+	const size_t CHUNK_HEADER_SIZE = (sizeof(ArenaChunk) + 7) & ~(size_t) 7;
+
+	inline char *chunkData(ArenaChunk *chunk) {
+		return (char *) chunk + CHUNK_HEADER_SIZE;
+	}
+
+	inline size_t blockSize(const void *ptr) {
+		return *(const size_t *) ((const char *) ptr - HEADER_SIZE);
+	}
+
+#ifndef SPINE_NO_THREADS
+	thread_local Arena *currentArena = NULL;
+#else
+	Arena *currentArena = NULL;
+#endif
+}
+
+Arena::Arena(size_t chunkSize) : _chunks(NULL), _chunkSize(chunkSize), _used(0), _capacity(0), _last(NULL),
+							   _adopted(NULL), _ranges(NULL), _rangeCount(0), _rangeCapacity(0) {
+}
+
+Arena::~Arena() {
+	if (currentArena == this) currentArena = NULL;
+	while (_adopted) {
+		ArenaAdopted *next = _adopted->next;
+		_adopted->release(_adopted->memory, _adopted->size);
+		SpineExtension::getInstance()->_free(_adopted, __FILE__, __LINE__);
+		_adopted = next;
+	}
+	while (_chunks) {
+		ArenaChunk *next = _chunks->next;
+		SpineExtension::getInstance()->_free(_chunks, __FILE__, __LINE__);
+		_chunks = next;
+	}
+	if (_ranges) SpineExtension::getInstance()->_free(_ranges, __FILE__, __LINE__);
+}
+
+ArenaChunk *Arena::addChunk(size_t dataSize, bool single) {
+	ArenaChunk *chunk = (ArenaChunk *) SpineExtension::getInstance()->_calloc(CHUNK_HEADER_SIZE + dataSize, __FILE__,
+																			  __LINE__);
+	chunk->size = dataSize;
+	chunk->used = 0;
+	_capacity += dataSize;
+
+	// Allocations are bumped from the first chunk. A chunk for a single large allocation goes behind it, so the space left
+	// in the first chunk is not wasted and the last allocation stays in the first chunk.
+	if (_chunks && single) {
+		chunk->next = _chunks->next;
+		_chunks->next = chunk;
+	} else {
+		chunk->next = _chunks;
+		_chunks = chunk;
+	}
+
+	addRange(chunkData(chunk), chunkData(chunk) + dataSize, false);
+	return chunk;
+}
+
+void *Arena::alloc(size_t size) {
+	if (size == 0) return NULL;
+	size_t total = HEADER_SIZE + ((size + 7) & ~(size_t) 7);
+	_used += total;
+	if (total > _chunkSize / 4) {
+		ArenaChunk *chunk = addChunk(total, true);
+		chunk->used = total;
+		*(size_t *) chunkData(chunk) = size;
+		return chunkData(chunk) + HEADER_SIZE;
+	}
+	if (!_chunks || _chunks->size - _chunks->used < total) addChunk(_chunkSize, false);
+	char *block = chunkData(_chunks) + _chunks->used;
+	*(size_t *) block = size;
+	_chunks->used += total;
+	_last = block + HEADER_SIZE;
+	return _last;
+}
+
+void Arena::free(void *ptr) {
+	if (!ptr || ptr != _last) return;
+	size_t total = HEADER_SIZE + ((blockSize(ptr) + 7) & ~(size_t) 7);
+	_chunks->used -= total;
+	_used -= total;
+	memset((char *) ptr - HEADER_SIZE, 0, total);
+	_last = NULL;
+}
+
+void Arena::adopt(void *memory, size_t size, void (*release)(void *memory, size_t size)) {
+	ArenaAdopted *adopted = (ArenaAdopted *) SpineExtension::getInstance()->_calloc(sizeof(ArenaAdopted), __FILE__,
+																					 __LINE__);
+	adopted->memory = memory;
+	adopted->size = size;
+	adopted->release = release;
+	adopted->next = _adopted;
+	_adopted = adopted;
+	addRange((const char *) memory, (const char *) memory + size, true);
+}
+
+void *Arena::realloc(void *ptr, size_t size) {
+	if (!ptr) return alloc(size);
+	if (size == 0) return NULL;
+	if (ptr == _last) {
+		size_t oldSize = blockSize(ptr);
+		size_t oldTotal = (oldSize + 7) & ~(size_t) 7, newTotal = (size + 7) & ~(size_t) 7;
+		if (newTotal <= oldTotal || _chunks->size - _chunks->used >= newTotal - oldTotal) {
+			if (newTotal < oldTotal) memset((char *) ptr + newTotal, 0, oldTotal - newTotal);
+			_chunks->used = _chunks->used - oldTotal + newTotal;
+			_used = _used - oldTotal + newTotal;
+			*(size_t *) ((char *) ptr - HEADER_SIZE) = size;
+			return ptr;
+		}
+	}
+	size_t oldSize = getSize(ptr);
+	void *mem = alloc(size);
+	memcpy(mem, ptr, oldSize < size ? oldSize : size);
+	return mem;
+}
+
+bool Arena::owns(const void *ptr) {
+	return findRange(ptr) != NULL;
+}
+
+size_t Arena::getSize(const void *ptr) {
+	const ArenaRange *range = findRange(ptr);
+	return range && range->adopted ? range->end - (const char *) ptr : blockSize(ptr);
+}
+
+size_t Arena::getUsed() {
+	return _used;
+}
+
+size_t Arena::getCapacity() {
+	return _capacity;
+}
+
+Arena *Arena::getCurrent() {
+	return currentArena;
+}
+
+Arena *Arena::setCurrent(Arena *arena) {
+	Arena *previous = currentArena;
+	currentArena = arena;
+	return previous;
+}
+
+void Arena::addRange(const char *start, const char *end, bool adopted) {
+	// Allocated directly from the extension, as the ranges must never be allocated from an arena.
+	if (_rangeCount == _rangeCapacity) {
+		_rangeCapacity = _rangeCapacity ? _rangeCapacity * 2 : 8;
+		_ranges = (ArenaRange *) SpineExtension::getInstance()->_realloc(_ranges, sizeof(ArenaRange) * _rangeCapacity,
+																		 __FILE__, __LINE__);
+	}
+	size_t index = _rangeCount;
+	while (index > 0 && _ranges[index - 1].start > start)
+		index--;
+	memmove(_ranges + index + 1, _ranges + index, sizeof(ArenaRange) * (_rangeCount - index));
+	_ranges[index].start = start;
+	_ranges[index].end = end;
+	_ranges[index].adopted = adopted;
+	_rangeCount++;
+}
+
+const ArenaRange *Arena::findRange(const void *ptr) {
+	if (!ptr) return NULL;
+	size_t low = 0, high = _rangeCount;
+	while (low < high) {
+		size_t middle = (low + high) >> 1;
+		if (_ranges[middle].start <= (const char *) ptr)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	if (low == 0 || (const char *) ptr >= _ranges[low - 1].end) return NULL;
+	return &_ranges[low - 1];
+}
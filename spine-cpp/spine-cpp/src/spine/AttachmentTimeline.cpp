@@ -51,16 +51,22 @@ AttachmentTimeline::AttachmentTimeline(size_t frameCount, int slotIndex) : Timel
 	for (size_t i = 0; i < frameCount; ++i) {
 		_attachmentNames.add(String());
 	}
+	_attachmentNameHashes.setSize(frameCount, String().hash());
 }
 
 AttachmentTimeline::~AttachmentTimeline() {}
 
-void AttachmentTimeline::setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName) {
-	slot.setAttachment(attachmentName == NULL || attachmentName->isEmpty() ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName));
+void AttachmentTimeline::setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName, size_t hash) {
+	slot.setAttachment(attachmentName == NULL || attachmentName->isEmpty() ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName, hash));
 }
 
 void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 							   MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void AttachmentTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+									 MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(alpha);
@@ -69,32 +75,39 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 	if (!slot->_bone._active) return;
 
 	if (direction == MixDirection_Out) {
-		if (blend == MixBlend_Setup) setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+		if (blend == MixBlend_Setup)
+			setAttachment(skeleton, *slot, &slot->_data._attachmentName, slot->_data._attachmentNameHash);
 		return;
 	}
 
 	if (time < _frames[0]) {
 		// Time is before first frame.
 		if (blend == MixBlend_Setup || blend == MixBlend_First) {
-			setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+			setAttachment(skeleton, *slot, &slot->_data._attachmentName, slot->_data._attachmentNameHash);
 		}
 		return;
 	}
 
 	if (time < _frames[0]) {
 		if (blend == MixBlend_Setup || blend == MixBlend_First)
-			setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+			setAttachment(skeleton, *slot, &slot->_data._attachmentName, slot->_data._attachmentNameHash);
 		return;
 	}
 
-	setAttachment(skeleton, *slot, &_attachmentNames[Animation::search(_frames, time)]);
+	int frame = Animation::search(_frames, time, 1, cursor);
+	setAttachment(skeleton, *slot, &_attachmentNames[frame], _attachmentNameHashes[frame]);
 }
 
 void AttachmentTimeline::setFrame(int frame, float time, const String &attachmentName) {
 	_frames[frame] = time;
 	_attachmentNames[frame] = attachmentName;
+	_attachmentNameHashes[frame] = attachmentName.hash();
 }
 
-Vector<String> &AttachmentTimeline::getAttachmentNames() {
+const Vector<String> &AttachmentTimeline::getAttachmentNames() {
 	return _attachmentNames;
 }
+
+const Vector<size_t> &AttachmentTimeline::getAttachmentNameHashes() {
+	return _attachmentNameHashes;
+}
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/BakedAnimation.h>
+
+#include <spine/Bone.h>
+#include <spine/ChangeTracker.h>
+#include <spine/IkConstraint.h>
+#include <spine/MathUtil.h>
+#include <spine/PathConstraint.h>
+#include <spine/Skeleton.h>
+#include <spine/TransformConstraint.h>
+
+using namespace spine;
+
+BakedAnimation::BakedAnimation(const String &name, float fps, float duration, int frameCount, bool world) : _name(name),
+																											 _fps(fps),
+																											 _duration(duration),
+																											 _frameCount(frameCount),
+																											 _world(world),
+																											 _boneCount(0) {
+}
+
+BakedAnimation::~BakedAnimation() {
+}
+
+void BakedAnimation::apply(Skeleton &skeleton, float time, bool loop, bool interpolate) {
+	if (loop && _duration != 0) time = MathUtil::fmod(time, _duration);
+	// The last frame is at the duration, so the interval before it may be shorter.
+	int last = _frameCount - 1, frame1 = last, frame2 = last;
+	float alpha = 0;
+	if (time < _duration) {
+		frame1 = time > 0 ? MathUtil::min((int) (time * _fps), last) : 0;
+		frame2 = MathUtil::min(frame1 + 1, last);
+		if (interpolate && frame2 != frame1) {
+			float start = frame1 / _fps;
+			alpha = MathUtil::clamp((time - start) / (MathUtil::min(frame2 / _fps, _duration) - start), 0, 1);
+		}
+	}
+
+	Vector<Bone *> &bones = skeleton.getBones();
+	assert((int) bones.size() == _boneCount);
+	const float *frames = _frames.buffer();
+	if (_world) {
+		// The tables were sampled with the skeleton at the origin and unscaled.
+		float sx = skeleton.getScaleX(), sy = skeleton.getScaleY() * (Bone::isYDown() ? -1 : 1);
+		float x = skeleton.getX(), y = skeleton.getY();
+		for (size_t i = 0, n = bones.size(); i < n; i++) {
+			Bone &bone = *bones[i];
+			int stride = _strides[i];
+			const float *from = frames + _offsets[i] + frame1 * stride, *to = frames + _offsets[i] + frame2 * stride;
+			bone._a = (from[0] + (to[0] - from[0]) * alpha) * sx;
+			bone._b = (from[1] + (to[1] - from[1]) * alpha) * sx;
+			bone._c = (from[2] + (to[2] - from[2]) * alpha) * sy;
+			bone._d = (from[3] + (to[3] - from[3]) * alpha) * sy;
+			bone._worldX = (from[4] + (to[4] - from[4]) * alpha) * sx + x;
+			bone._worldY = (from[5] + (to[5] - from[5]) * alpha) * sy + y;
+		}
+		// The world transforms were set without updateWorldTransform(), so the tracker must compare them itself.
+		ChangeTracker *tracker = skeleton.getChangeTracker();
+		if (tracker) {
+			tracker->updateVersions(skeleton, true);
+			tracker->invalidate();
+		}
+		return;
+	}
+
+	size_t item = 0;
+	for (size_t i = 0, n = bones.size(); i < n; i++, item++) {
+		Bone &bone = *bones[i];
+		int stride = _strides[item];
+		const float *from = frames + _offsets[item] + frame1 * stride, *to = frames + _offsets[item] + frame2 * stride;
+		float r = to[2] - from[2];
+		r -= (16384 - (int) (16384.499999999996 - r / 360)) * 360;
+		bone._x = from[0] + (to[0] - from[0]) * alpha;
+		bone._y = from[1] + (to[1] - from[1]) * alpha;
+		bone._rotation = from[2] + r * alpha;
+		bone._scaleX = from[3] + (to[3] - from[3]) * alpha;
+		bone._scaleY = from[4] + (to[4] - from[4]) * alpha;
+		bone._shearX = from[5] + (to[5] - from[5]) * alpha;
+		bone._shearY = from[6] + (to[6] - from[6]) * alpha;
+	}
+
+	// Like the constraint timelines, the bend direction, compress and stretch are not interpolated.
+	Vector<IkConstraint *> &ikConstraints = skeleton.getIkConstraints();
+	for (size_t i = 0, n = ikConstraints.size(); i < n; i++, item++) {
+		IkConstraint &constraint = *ikConstraints[i];
+		int stride = _strides[item];
+		const float *from = frames + _offsets[item] + frame1 * stride, *to = frames + _offsets[item] + frame2 * stride;
+		constraint.setMix(from[0] + (to[0] - from[0]) * alpha);
+		constraint.setSoftness(from[1] + (to[1] - from[1]) * alpha);
+		constraint.setBendDirection((int) from[2]);
+		constraint.setCompress(from[3] != 0);
+		constraint.setStretch(from[4] != 0);
+	}
+	Vector<TransformConstraint *> &transformConstraints = skeleton.getTransformConstraints();
+	for (size_t i = 0, n = transformConstraints.size(); i < n; i++, item++) {
+		TransformConstraint &constraint = *transformConstraints[i];
+		int stride = _strides[item];
+		const float *from = frames + _offsets[item] + frame1 * stride, *to = frames + _offsets[item] + frame2 * stride;
+		constraint.setMixRotate(from[0] + (to[0] - from[0]) * alpha);
+		constraint.setMixX(from[1] + (to[1] - from[1]) * alpha);
+		constraint.setMixY(from[2] + (to[2] - from[2]) * alpha);
+		constraint.setMixScaleX(from[3] + (to[3] - from[3]) * alpha);
+		constraint.setMixScaleY(from[4] + (to[4] - from[4]) * alpha);
+		constraint.setMixShearY(from[5] + (to[5] - from[5]) * alpha);
+	}
+	Vector<PathConstraint *> &pathConstraints = skeleton.getPathConstraints();
+	for (size_t i = 0, n = pathConstraints.size(); i < n; i++, item++) {
+		PathConstraint &constraint = *pathConstraints[i];
+		int stride = _strides[item];
+		const float *from = frames + _offsets[item] + frame1 * stride, *to = frames + _offsets[item] + frame2 * stride;
+		constraint.setPosition(from[0] + (to[0] - from[0]) * alpha);
+		constraint.setSpacing(from[1] + (to[1] - from[1]) * alpha);
+		constraint.setMixRotate(from[2] + (to[2] - from[2]) * alpha);
+		constraint.setMixX(from[3] + (to[3] - from[3]) * alpha);
+		constraint.setMixY(from[4] + (to[4] - from[4]) * alpha);
+	}
+}
+
+const String &BakedAnimation::getName() {
+	return _name;
+}
+
+float BakedAnimation::getFps() {
+	return _fps;
+}
+
+float BakedAnimation::getDuration() {
+	return _duration;
+}
+
+int BakedAnimation::getFrameCount() {
+	return _frameCount;
+}
+
+bool BakedAnimation::isWorld() {
+	return _world;
+}
+
+int BakedAnimation::getAnimatedBoneCount() {
+	int count = 0;
+	for (int i = 0; i < _boneCount; i++)
+		if (_strides[i] != 0) count++;
+	return count;
+}
+
+size_t BakedAnimation::getMemorySize() {
+	return _frames.size() * sizeof(float) + (_offsets.size() + _strides.size()) * sizeof(int);
+}
@@ -0,0 +1,371 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/ChangeTracker.h>
+
+#include <spine/Bone.h>
+#include <spine/BoneData.h>
+#include <spine/IkConstraint.h>
+#include <spine/PathAttachment.h>
+#include <spine/PathConstraint.h>
+#include <spine/Skeleton.h>
+#include <spine/Slot.h>
+#include <spine/TransformConstraint.h>
+
+#ifndef SPINE_NO_THREADS
+#include <atomic>
+#endif
+
+using namespace spine;
+
+namespace {
+	// Trackers may be created on several threads, e.g. for skeletons set up by a CrowdUpdater.
+#ifndef SPINE_NO_THREADS
+	std::atomic<int> nextTrackerId(0);
+#else
+	int nextTrackerId = 0;
+#endif
+
+	/// Copies the values into the snapshot and returns true if any differed.
+	inline bool updateSnapshot(float *snapshot, const float *values, int count) {
+		bool changed = false;
+		for (int i = 0; i < count; i++) {
+			if (snapshot[i] != values[i]) {
+				snapshot[i] = values[i];
+				changed = true;
+			}
+		}
+		return changed;
+	}
+
+	/// The bone a constraint reads besides the bones it constrains, or NULL for other updatables.
+	inline Bone *getInput(Updatable *updatable) {
+		const RTTI &rtti = updatable->getRTTI();
+		if (rtti.isExactly(IkConstraint::rtti)) return ((IkConstraint *) updatable)->getTarget();
+		if (rtti.isExactly(TransformConstraint::rtti)) return ((TransformConstraint *) updatable)->getTarget();
+		if (rtti.isExactly(PathConstraint::rtti)) return &((PathConstraint *) updatable)->getTarget()->getBone();
+		return NULL;
+	}
+}
+
+ChangeTracker::ChangeTracker() : _id(getNextID()), _valid(false), _boneEntries(0), _constraintEntries(0), _hasOther(false),
+								 _bonesUpdated(0), _bonesSkipped(0), _constraintsUpdated(0), _constraintsSkipped(0),
+								 _verticesComputed(0), _verticesReused(0) {
+	for (int i = 0; i < 4; i++)
+		_skeletonValues[i] = 0;
+}
+
+ChangeTracker::~ChangeTracker() {
+}
+
+void ChangeTracker::invalidate() {
+	_valid = false;
+}
+
+unsigned int ChangeTracker::getWorldVersion(size_t boneIndex) {
+	return _versions[boneIndex];
+}
+
+int ChangeTracker::getId() {
+	return _id;
+}
+
+int ChangeTracker::getBonesUpdated() {
+	return _bonesUpdated;
+}
+
+int ChangeTracker::getBonesSkipped() {
+	return _bonesSkipped;
+}
+
+int ChangeTracker::getConstraintsUpdated() {
+	return _constraintsUpdated;
+}
+
+int ChangeTracker::getConstraintsSkipped() {
+	return _constraintsSkipped;
+}
+
+int ChangeTracker::getVerticesComputed() {
+	return _verticesComputed;
+}
+
+int ChangeTracker::getVerticesReused() {
+	return _verticesReused;
+}
+
+void ChangeTracker::resetStats() {
+	_bonesUpdated = _bonesSkipped = _constraintsUpdated = _constraintsSkipped = 0;
+	_verticesComputed = _verticesReused = 0;
+}
+
+void ChangeTracker::build(Skeleton &skeleton) {
+	size_t boneCount = skeleton.getBones().size();
+	_locals.setSize(boneCount * 7, 0);
+	_worlds.setSize(boneCount * 6, 0);
+	_versions.setSize(boneCount, 0);
+	_dirty.setSize(boneCount, false);
+	_changed.setSize(boneCount, false);
+	_updated.setSize(boneCount, false);
+
+	_entryTypes.clear();
+	_entryBoneStart.clear();
+	_entryBoneCount.clear();
+	_entryOutputCount.clear();
+	_entryValueStart.clear();
+	_entryBones.clear();
+	_entryValues.clear();
+	_entryAttachments.clear();
+	_entryInputs.clear();
+	_boneEntries = _constraintEntries = 0;
+	_hasOther = false;
+	Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+	for (size_t i = 0, n = updateCache.size(); i < n; i++) {
+		Updatable *updatable = updateCache[i];
+		const RTTI &rtti = updatable->getRTTI();
+		int type, valueCount = 0;
+		Vector<Bone *> *bones = NULL;
+		Bone *input = getInput(updatable);
+		if (rtti.isExactly(Bone::rtti)) {
+			type = EntryType_Bone;
+			Bone *parent = ((Bone *) updatable)->getParent();
+			_entryBones.add(((Bone *) updatable)->getData().getIndex());
+			_entryBones.add(parent ? parent->getData().getIndex() : -1);
+		} else if (rtti.isExactly(IkConstraint::rtti)) {
+			type = EntryType_Ik;
+			bones = &((IkConstraint *) updatable)->getBones();
+			valueCount = 5;
+		} else if (rtti.isExactly(TransformConstraint::rtti)) {
+			type = EntryType_Transform;
+			bones = &((TransformConstraint *) updatable)->getBones();
+			valueCount = 6;
+		} else if (rtti.isExactly(PathConstraint::rtti)) {
+			type = EntryType_Path;
+			bones = &((PathConstraint *) updatable)->getBones();
+			valueCount = 5;
+		} else
+			type = EntryType_Other;
+		_entryTypes.add(type);
+		_entryBoneStart.add(type == EntryType_Bone ? (int) _entryBones.size() - 2 : (int) _entryBones.size());
+		if (type == EntryType_Bone) _boneEntries++;
+		else
+			_constraintEntries++;
+		if (type == EntryType_Other) _hasOther = true;
+		if (bones) {
+			for (size_t ii = 0; ii < bones->size(); ii++)
+				_entryBones.add((*bones)[ii]->getData().getIndex());
+			_entryBones.add(input->getData().getIndex());
+		}
+		_entryBoneCount.add(bones ? (int) bones->size() + 1 : 0);
+		_entryOutputCount.add(bones ? (int) bones->size() : 0);
+		_entryValueStart.add((int) _entryValues.size());
+		_entryValues.setSize(_entryValues.size() + valueCount, 0);
+		_entryAttachments.add(NULL);
+		_entryInputs.add(input);
+	}
+	_entryChanged.setSize(_entryTypes.size(), false);
+	_entryRun.setSize(_entryTypes.size(), false);
+	_valid = false;
+}
+
+void ChangeTracker::updateWorldTransform(Skeleton &skeleton) {
+	Vector<Bone *> &bones = skeleton.getBones();
+	Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+
+	// A constraint given another target reads another bone, so the entries are collected again.
+	for (size_t i = 0, n = _entryTypes.size(); i < n; i++) {
+		if (_entryInputs[i] && getInput(updateCache[i]) != _entryInputs[i]) {
+			build(skeleton);
+			break;
+		}
+	}
+
+	// A change of the skeleton's position or scale changes all world transforms.
+	float skeletonValues[] = {skeleton.getX(), skeleton.getY(), skeleton.getScaleX(), skeleton.getScaleY()};
+	bool all = updateSnapshot(_skeletonValues, skeletonValues, 4) || !_valid;
+	bool changes = all || _hasOther;
+
+	bool *dirty = _dirty.buffer();
+	float *locals = _locals.buffer();
+	for (size_t i = 0, n = bones.size(); i < n; i++, locals += 7) {
+		Bone &bone = *bones[i];
+		float local[] = {bone._x, bone._y, bone._rotation, bone._scaleX, bone._scaleY, bone._shearX, bone._shearY};
+		dirty[i] = updateSnapshot(locals, local, 7) || all;
+		changes |= dirty[i];
+	}
+
+	for (size_t i = 0, n = _entryTypes.size(); i < n; i++) {
+		Updatable *updatable = updateCache[i];
+		float *snapshot = _entryValues.buffer() + _entryValueStart[i];
+		bool changed = all;
+		switch (_entryTypes[i]) {
+			case EntryType_Ik: {
+				IkConstraint &constraint = *(IkConstraint *) updatable;
+				float values[] = {constraint.getMix(), constraint.getSoftness(), (float) constraint.getBendDirection(),
+								  constraint.getCompress() ? 1.0f : 0.0f, constraint.getStretch() ? 1.0f : 0.0f};
+				changed |= updateSnapshot(snapshot, values, 5);
+				break;
+			}
+			case EntryType_Transform: {
+				TransformConstraint &constraint = *(TransformConstraint *) updatable;
+				float values[] = {constraint.getMixRotate(), constraint.getMixX(), constraint.getMixY(),
+								  constraint.getMixScaleX(), constraint.getMixScaleY(), constraint.getMixShearY()};
+				changed |= updateSnapshot(snapshot, values, 6);
+				break;
+			}
+			case EntryType_Path: {
+				PathConstraint &constraint = *(PathConstraint *) updatable;
+				float values[] = {constraint.getPosition(), constraint.getSpacing(), constraint.getMixRotate(),
+								  constraint.getMixX(), constraint.getMixY()};
+				changed |= updateSnapshot(snapshot, values, 5);
+				// The path is computed from the target slot's attachment, which may be deformed.
+				Slot *target = constraint.getTarget();
+				if (_entryAttachments[i] != target->getAttachment() || target->getDeform().size() > 0) {
+					_entryAttachments[i] = target->getAttachment();
+					changed = true;
+				}
+				break;
+			}
+			default:
+				break;
+		}
+		_entryChanged[i] = changed;
+		changes |= changed;
+	}
+
+	// A held pose skips everything.
+	if (!changes) {
+		_bonesSkipped += _boneEntries;
+		_constraintsSkipped += _constraintEntries;
+		return;
+	}
+
+	while (!plan(skeleton)) {
+	}
+
+	for (size_t i = 0, n = bones.size(); i < n; i++) {
+		if (!_updated[i]) continue;
+		Bone &bone = *bones[i];
+		bone._ax = bone._x;
+		bone._ay = bone._y;
+		bone._arotation = bone._rotation;
+		bone._ascaleX = bone._scaleX;
+		bone._ascaleY = bone._scaleY;
+		bone._ashearX = bone._shearX;
+		bone._ashearY = bone._shearY;
+	}
+
+	for (size_t i = 0, n = _entryTypes.size(); i < n; i++) {
+		bool bone = _entryTypes[i] == EntryType_Bone;
+		if (_entryRun[i]) {
+			updateCache[i]->update();
+			if (bone) _bonesUpdated++;
+			else
+				_constraintsUpdated++;
+		} else if (bone)
+			_bonesSkipped++;
+		else
+			_constraintsSkipped++;
+	}
+
+	updateVersions(skeleton, false);
+	_valid = true;
+}
+
+bool ChangeTracker::plan(Skeleton &skeleton) {
+	size_t boneCount = skeleton.getBones().size();
+	Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+	bool *dirty = _dirty.buffer(), *changed = _changed.buffer(), *updated = _updated.buffer();
+	for (size_t i = 0; i < boneCount; i++) {
+		changed[i] = false;
+		updated[i] = false;
+	}
+
+	bool complete = true;
+	for (size_t i = 0, n = _entryTypes.size(); i < n; i++) {
+		int *entryBones = _entryBones.buffer() + _entryBoneStart[i];
+		bool run = _entryChanged[i];
+		switch (_entryTypes[i]) {
+			case EntryType_Bone: {
+				int boneIndex = entryBones[0], parentIndex = entryBones[1];
+				run |= dirty[boneIndex] || (parentIndex != -1 && changed[parentIndex]);
+				if (run) changed[boneIndex] = updated[boneIndex] = true;
+				break;
+			}
+			case EntryType_Other:
+				// Unknown updatables may change any bone.
+				run = true;
+				for (size_t ii = 0; ii < boneCount; ii++)
+					changed[ii] = true;
+				break;
+			default: {
+				for (int ii = 0, nn = _entryBoneCount[i]; ii < nn && !run; ii++)
+					run = changed[entryBones[ii]];
+				if (!run && _entryTypes[i] == EntryType_Path) {
+					// A weighted path depends on the bones of its attachment.
+					Attachment *attachment = ((PathConstraint *) updateCache[i])->getTarget()->getAttachment();
+					if (attachment && attachment->getRTTI().isExactly(PathAttachment::rtti)) {
+						Vector<size_t> &pathBones = ((PathAttachment *) attachment)->getBones();
+						for (size_t ii = 0, nn = pathBones.size(); ii < nn && !run; ii += pathBones[ii] + 1) {
+							for (size_t iii = ii + 1, end = ii + 1 + pathBones[ii]; iii < end && !run; iii++)
+								run = changed[pathBones[iii]];
+						}
+					}
+				}
+				if (!run) break;
+				// The constraint modifies the world transforms of its bones, so they must have been computed from their
+				// local transforms first.
+				for (int ii = 0, nn = _entryOutputCount[i]; ii < nn; ii++) {
+					int boneIndex = entryBones[ii];
+					if (!updated[boneIndex] && !dirty[boneIndex]) {
+						dirty[boneIndex] = true;
+						complete = false;
+					}
+					changed[boneIndex] = true;
+				}
+			}
+		}
+		_entryRun[i] = run;
+	}
+	return complete;
+}
+
+void ChangeTracker::updateVersions(Skeleton &skeleton, bool all) {
+	Vector<Bone *> &bones = skeleton.getBones();
+	for (size_t i = 0, n = bones.size(); i < n; i++) {
+		if (!all && !_changed[i]) continue;
+		Bone &bone = *bones[i];
+		float world[] = {bone._a, bone._b, bone._c, bone._d, bone._worldX, bone._worldY};
+		if (updateSnapshot(&_worlds[i * 6], world, 6)) _versions[i]++;
+	}
+}
+
+int ChangeTracker::getNextID() {
+	return nextTrackerId++;
+}
@@ -56,6 +56,11 @@ RGBATimeline::~RGBATimeline() {
 
 void RGBATimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						 MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void RGBATimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+							   MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -79,7 +84,7 @@ void RGBATimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<
 	}
 
 	float r = 0, g = 0, b = 0, a = 0;
-	int i = Animation::search(_frames, time, RGBATimeline::ENTRIES);
+	int i = Animation::search(_frames, time, RGBATimeline::ENTRIES, cursor);
 	int curveType = (int) _curves[i / RGBATimeline::ENTRIES];
 	switch (curveType) {
 		case RGBATimeline::LINEAR: {
@@ -145,6 +150,11 @@ RGBTimeline::~RGBTimeline() {
 
 void RGBTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void RGBTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+							  MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -168,7 +178,7 @@ void RGBTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<E
 	}
 
 	float r = 0, g = 0, b = 0;
-	int i = Animation::search(_frames, time, RGBTimeline::ENTRIES);
+	int i = Animation::search(_frames, time, RGBTimeline::ENTRIES, cursor);
 	int curveType = (int) _curves[i / RGBTimeline::ENTRIES];
 	switch (curveType) {
 		case RGBTimeline::LINEAR: {
@@ -228,6 +238,11 @@ AlphaTimeline::~AlphaTimeline() {
 
 void AlphaTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						  MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void AlphaTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+								MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -249,7 +264,7 @@ void AlphaTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 		return;
 	}
 
-	float a = getCurveValue(time);
+	float a = getCurveValue(time, cursor);
 	if (alpha == 1)
 		slot->_color.a = a;
 	else {
@@ -275,6 +290,11 @@ RGBA2Timeline::~RGBA2Timeline() {
 
 void RGBA2Timeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						  MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void RGBA2Timeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+								MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -303,7 +323,7 @@ void RGBA2Timeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	}
 
 	float r = 0, g = 0, b = 0, a = 0, r2 = 0, g2 = 0, b2 = 0;
-	int i = Animation::search(_frames, time, RGBA2Timeline::ENTRIES);
+	int i = Animation::search(_frames, time, RGBA2Timeline::ENTRIES, cursor);
 	int curveType = (int) _curves[i / RGBA2Timeline::ENTRIES];
 	switch (curveType) {
 		case RGBA2Timeline::LINEAR: {
@@ -395,6 +415,11 @@ RGB2Timeline::~RGB2Timeline() {
 
 void RGB2Timeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						 MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void RGB2Timeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+							   MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -422,7 +447,7 @@ void RGB2Timeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<
 	}
 
 	float r = 0, g = 0, b = 0, r2 = 0, g2 = 0, b2 = 0;
-	int i = Animation::search(_frames, time, RGB2Timeline::ENTRIES);
+	int i = Animation::search(_frames, time, RGB2Timeline::ENTRIES, cursor);
 	int curveType = (int) _curves[i / RGB2Timeline::ENTRIES];
 	switch (curveType) {
 		case RGB2Timeline::LINEAR: {
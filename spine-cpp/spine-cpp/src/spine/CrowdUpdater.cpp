@@ -0,0 +1,285 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/CrowdUpdater.h>
+
+#include <spine/AnimationState.h>
+#include <spine/Skeleton.h>
+
+#ifndef SPINE_NO_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+using namespace spine;
+
+#ifndef SPINE_NO_THREADS
+namespace spine {
+	/// Worker threads plus one range of item indices per thread. Index 0 belongs to the thread calling parallelFor().
+	class CrowdThreadPool : public SpineObject {
+	public:
+		explicit CrowdThreadPool(int numThreads) : _task(NULL), _generation(0), _active(0), _quit(false) {
+			for (int i = 0; i < numThreads; i++) {
+				Worker *worker = new (__FILE__, __LINE__) Worker();
+				_workers.add(worker);
+			}
+			for (int i = 1; i < numThreads; i++)
+				_workers[i]->thread = std::thread(&CrowdThreadPool::workerMain, this, i);
+		}
+
+		~CrowdThreadPool() {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_quit = true;
+			}
+			_wake.notify_all();
+			for (size_t i = 0; i < _workers.size(); i++) {
+				if (_workers[i]->thread.joinable()) _workers[i]->thread.join();
+				delete _workers[i];
+			}
+		}
+
+		int getNumThreads() {
+			return (int) _workers.size();
+		}
+
+		void parallelFor(size_t count, CrowdTask &task) {
+			size_t n = _workers.size();
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				for (size_t i = 0; i < n; i++) {
+					_workers[i]->start = count * i / n;
+					_workers[i]->end = count * (i + 1) / n;
+				}
+				_task = &task;
+				_active = (int) n - 1;
+				_generation++;
+			}
+			_wake.notify_all();
+
+			work(0);
+
+			std::unique_lock<std::mutex> lock(_mutex);
+			while (_active > 0) _done.wait(lock);
+			_task = NULL;
+		}
+
+	private:
+		class Worker : public SpineObject {
+		public:
+			Worker() : start(0), end(0) {
+			}
+
+			std::thread thread;
+			std::mutex mutex;
+			size_t start, end;
+		};
+
+		Vector<Worker *> _workers;
+		std::mutex _mutex;
+		std::condition_variable _wake, _done;
+		CrowdTask *_task;
+		unsigned int _generation;
+		int _active;
+		bool _quit;
+
+		void workerMain(int index) {
+			unsigned int generation = 0;
+			while (true) {
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					while (!_quit && _generation == generation) _wake.wait(lock);
+					if (_quit) return;
+					generation = _generation;
+				}
+				work(index);
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (--_active == 0) _done.notify_one();
+				}
+			}
+		}
+
+		/// Runs items from the thread's own range, stealing from other threads when it is empty, until no items are left.
+		void work(size_t index) {
+			Worker *worker = _workers[index];
+			while (true) {
+				size_t item = 0;
+				bool found = false;
+				{
+					std::lock_guard<std::mutex> lock(worker->mutex);
+					if (worker->start < worker->end) {
+						item = worker->start++;
+						found = true;
+					}
+				}
+				if (found)
+					_task->run(item);
+				else if (!steal(index))
+					return;
+			}
+		}
+
+		/// Moves the second half of the remaining items of another thread to this thread. Returns false if every thread is
+		/// out of items.
+		bool steal(size_t index) {
+			size_t n = _workers.size();
+			for (size_t i = 1; i < n; i++) {
+				Worker *victim = _workers[(index + i) % n];
+				size_t start, end;
+				{
+					std::lock_guard<std::mutex> lock(victim->mutex);
+					size_t remaining = victim->end - victim->start;
+					if (remaining == 0) continue;
+					end = victim->end;
+					start = end - (remaining + 1) / 2;
+					victim->end = start;
+				}
+				Worker *worker = _workers[index];
+				std::lock_guard<std::mutex> lock(worker->mutex);
+				worker->start = start;
+				worker->end = end;
+				return true;
+			}
+			return false;
+		}
+	};
+}
+#endif
+
+ThreadPoolExecutor::ThreadPoolExecutor(int numThreads) : _pool(NULL) {
+#ifndef SPINE_NO_THREADS
+	if (numThreads <= 0) numThreads = (int) std::thread::hardware_concurrency();
+	if (numThreads > 1) _pool = new (__FILE__, __LINE__) CrowdThreadPool(numThreads);
+#else
+	SP_UNUSED(numThreads);
+#endif
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+#ifndef SPINE_NO_THREADS
+	delete _pool;
+#endif
+}
+
+int ThreadPoolExecutor::getNumThreads() {
+#ifndef SPINE_NO_THREADS
+	if (_pool) return _pool->getNumThreads();
+#endif
+	return 1;
+}
+
+void ThreadPoolExecutor::parallelFor(size_t count, CrowdTask &task) {
+#ifndef SPINE_NO_THREADS
+	if (_pool && count > 1) {
+		_pool->parallelFor(count, task);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < count; i++)
+		task.run(i);
+}
+
+CrowdUpdater::CrowdUpdater(CrowdExecutor *executor) : _executor(executor), _ownedExecutor(NULL), _delta(0) {
+	if (!_executor) {
+		_ownedExecutor = new (__FILE__, __LINE__) ThreadPoolExecutor();
+		_executor = _ownedExecutor;
+	}
+}
+
+CrowdUpdater::~CrowdUpdater() {
+	delete _ownedExecutor;
+}
+
+void CrowdUpdater::add(Skeleton *skeleton, AnimationState *state) {
+	_skeletons.add(skeleton);
+	_states.add(state);
+}
+
+void CrowdUpdater::remove(Skeleton *skeleton) {
+	int index = _skeletons.indexOf(skeleton);
+	if (index < 0) return;
+	_skeletons.removeAt(index);
+	_states.removeAt(index);
+}
+
+void CrowdUpdater::clear() {
+	_skeletons.clear();
+	_states.clear();
+}
+
+size_t CrowdUpdater::size() {
+	return _skeletons.size();
+}
+
+Vector<Skeleton *> &CrowdUpdater::getSkeletons() {
+	return _skeletons;
+}
+
+Vector<AnimationState *> &CrowdUpdater::getAnimationStates() {
+	return _states;
+}
+
+CrowdExecutor *CrowdUpdater::getExecutor() {
+	return _executor;
+}
+
+void CrowdUpdater::update(float delta) {
+	size_t n = _skeletons.size();
+	AnimationState **states = _states.buffer();
+
+	// Hold back listener callbacks while the executor runs, they are delivered below on this thread.
+	_drainDisabled.setSize(n, false);
+	for (size_t i = 0; i < n; i++) {
+		if (!states[i]) continue;
+		_drainDisabled[i] = states[i]->_queue->_drainDisabled;
+		states[i]->_queue->_drainDisabled = true;
+	}
+
+	_delta = delta;
+	_executor->parallelFor(n, *this);
+
+	for (size_t i = 0; i < n; i++) {
+		if (!states[i]) continue;
+		states[i]->_queue->_drainDisabled = _drainDisabled[i];
+		states[i]->_queue->drain();
+	}
+}
+
+void CrowdUpdater::run(size_t index) {
+	Skeleton *skeleton = _skeletons[index];
+	AnimationState *state = _states[index];
+	if (state) {
+		state->update(_delta);
+		state->apply(*skeleton);
+	}
+	skeleton->updateWorldTransform();
+}
@@ -29,6 +29,7 @@
 
 #include <spine/CurveTimeline.h>
 
+#include <spine/Animation.h>
 #include <spine/MathUtil.h>
 
 using namespace spine;
@@ -36,7 +37,9 @@ using namespace spine;
 RTTI_IMPL(CurveTimeline, Timeline)
 
 CurveTimeline::CurveTimeline(size_t frameCount, size_t frameEntries, size_t bezierCount) : Timeline(frameCount,
-																									frameEntries) {
+																									frameEntries),
+																						   _packedMin(0),
+																						   _packedScale(0) {
 	_curves.setSize(frameCount + bezierCount * BEZIER_SIZE, 0);
 	_curves[frameCount - 1] = STEPPED;
 }
@@ -54,16 +57,22 @@ void CurveTimeline::setStepped(size_t frame) {
 
 void CurveTimeline::setBezier(size_t bezier, size_t frame, float value, float time1, float value1, float cx1, float cy1,
 							  float cx2, float cy2, float time2, float value2) {
+	assert(!isCompressed());
 	size_t i = getFrameCount() + bezier * BEZIER_SIZE;
 	if (value == 0) _curves[frame] = BEZIER + i;
+	computeBezier(_curves.buffer() + i, time1, value1, cx1, cy1, cx2, cy2, time2, value2);
+}
+
+void CurveTimeline::computeBezier(float *curves, float time1, float value1, float cx1, float cy1, float cx2, float cy2,
+								  float time2, float value2) {
 	float tmpx = (time1 - cx1 * 2 + cx2) * 0.03, tmpy = (value1 - cy1 * 2 + cy2) * 0.03;
 	float dddx = ((cx1 - cx2) * 3 - time1 + time2) * 0.006, dddy = ((cy1 - cy2) * 3 - value1 + value2) * 0.006;
 	float ddx = tmpx * 2 + dddx, ddy = tmpy * 2 + dddy;
 	float dx = (cx1 - time1) * 0.3 + tmpx + dddx * 0.16666667, dy = (cy1 - value1) * 0.3 + tmpy + dddy * 0.16666667;
 	float x = time1 + dx, y = value1 + dy;
-	for (size_t n = i + BEZIER_SIZE; i < n; i += 2) {
-		_curves[i] = x;
-		_curves[i + 1] = y;
+	for (int i = 0; i < BEZIER_SIZE; i += 2) {
+		curves[i] = x;
+		curves[i + 1] = y;
 		dx += ddx;
 		dy += ddy;
 		ddx += dddx;
@@ -74,19 +83,26 @@ void CurveTimeline::setBezier(size_t bezier, size_t frame, float value, float ti
 }
 
 float CurveTimeline::getBezierValue(float time, size_t frameIndex, size_t valueOffset, size_t i) {
-	if (_curves[i] > time) {
+	float expanded[BEZIER_SIZE];
+	const float *curves = _curves.buffer() + i;
+	if (isCompressed()) {
+		size_t next = frameIndex + getFrameEntries();
+		expandBezier(i, _frames[frameIndex], _frames[frameIndex + valueOffset], _frames[next],
+					 _frames[next + valueOffset], expanded);
+		curves = expanded;
+	}
+	if (curves[0] > time) {
 		float x = _frames[frameIndex], y = _frames[frameIndex + valueOffset];
-		return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
+		return y + (time - x) / (curves[0] - x) * (curves[1] - y);
 	}
-	size_t n = i + BEZIER_SIZE;
-	for (i += 2; i < n; i += 2) {
-		if (_curves[i] >= time) {
-			float x = _curves[i - 2], y = _curves[i - 1];
-			return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
+	for (i = 2; i < BEZIER_SIZE; i += 2) {
+		if (curves[i] >= time) {
+			float x = curves[i - 2], y = curves[i - 1];
+			return y + (time - x) / (curves[i] - x) * (curves[i + 1] - y);
 		}
 	}
 	frameIndex += getFrameEntries();
-	float x = _curves[n - 2], y = _curves[n - 1];
+	float x = curves[BEZIER_SIZE - 2], y = curves[BEZIER_SIZE - 1];
 	return y + (time - x) / (_frames[frameIndex] - x) * (_frames[frameIndex + valueOffset] - y);
 }
 
@@ -94,6 +110,119 @@ Vector<float> &CurveTimeline::getCurves() {
 	return _curves;
 }
 
+float CurveTimeline::compress() {
+	Timeline::compress();
+	return compressCurves(false);
+}
+
+bool CurveTimeline::isCompressed() {
+	return _packedCurves.size() > 0;
+}
+
+float CurveTimeline::compressCurves(bool percent) {
+	size_t frameCount = getFrameCount(), frameEntries = getFrameEntries();
+	size_t bezierCount = (_curves.size() - frameCount) / BEZIER_SIZE;
+	if (isCompressed() || bezierCount == 0) return 0;
+
+	// The beziers of a frame are consecutive, one per value following the time.
+	size_t bezierFrames = 0;
+	for (size_t frame = 0; frame < frameCount; frame++)
+		if (_curves[frame] >= BEZIER) bezierFrames++;
+	if (bezierFrames == 0 || bezierCount % bezierFrames != 0) return 0;
+	size_t beziersPerFrame = bezierCount / bezierFrames;
+
+	// Fit the inner control points of each bezier to its points with least squares, the end points are the frames.
+	// The points are at t = 0.1, 0.2, ... 0.9.
+	double b1[9], b2[9], b11 = 0, b12 = 0, b22 = 0;
+	for (int k = 0; k < 9; k++) {
+		double t = (k + 1) * 0.1, u = 1 - t;
+		b1[k] = 3 * u * u * t;
+		b2[k] = 3 * u * t * t;
+		b11 += b1[k] * b1[k];
+		b12 += b1[k] * b2[k];
+		b22 += b2[k] * b2[k];
+	}
+	double det = b11 * b22 - b12 * b12;
+	Vector<float> controls, ends;
+	controls.setSize(bezierCount * 4, 0);
+	ends.setSize(bezierCount * 4, 0);
+	float yMin = 0, yMax = 0, expanded[BEZIER_SIZE];
+	bool first = true;
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		if (_curves[frame] < BEZIER) continue;
+		size_t start = (size_t) _curves[frame] - BEZIER;
+		size_t frameIndex = frame * frameEntries, next = frameIndex + frameEntries;
+		for (size_t v = 0; v < beziersPerFrame; v++) {
+			size_t i = start + v * BEZIER_SIZE, bezier = (i - frameCount) / BEZIER_SIZE;
+			float *end = ends.buffer() + bezier * 4;
+			end[0] = _frames[frameIndex];
+			end[1] = percent ? 0 : _frames[frameIndex + 1 + v];
+			end[2] = _frames[next];
+			end[3] = percent ? 1 : _frames[next + 1 + v];
+			for (int axis = 0; axis < 2; axis++) {
+				double p0 = end[axis], p3 = end[2 + axis], r1 = 0, r2 = 0;
+				for (int k = 0; k < 9; k++) {
+					double t = (k + 1) * 0.1, u = 1 - t;
+					double r = _curves[i + k * 2 + axis] - u * u * u * p0 - t * t * t * p3;
+					r1 += b1[k] * r;
+					r2 += b2[k] * r;
+				}
+				controls[bezier * 4 + axis] = (float) ((b22 * r1 - b12 * r2) / det);
+				controls[bezier * 4 + 2 + axis] = (float) ((b11 * r2 - b12 * r1) / det);
+			}
+			float *control = controls.buffer() + bezier * 4;
+			// The editor keeps the handles within the frame's time span, so the time of a bezier is monotonic.
+			float span = end[2] - end[0];
+			if (control[0] < end[0] - span * 0.001f || control[0] > end[2] + span * 0.001f ||
+				control[2] < end[0] - span * 0.001f || control[2] > end[2] + span * 0.001f)
+				return 0;
+			computeBezier(expanded, end[0], end[1], control[0], control[1], control[2], control[3], end[2], end[3]);
+			float tolerance = 0.001f * (1 + span + MathUtil::abs(end[3] - end[1]));
+			for (int ii = 0; ii < BEZIER_SIZE; ii++)
+				if (MathUtil::abs(expanded[ii] - _curves[i + ii]) > tolerance) return 0;
+			if (first) {
+				yMin = yMax = control[1];
+				first = false;
+			}
+			yMin = MathUtil::min(yMin, MathUtil::min(control[1], control[3]));
+			yMax = MathUtil::max(yMax, MathUtil::max(control[1], control[3]));
+		}
+	}
+
+	_packedMin = yMin;
+	_packedScale = (yMax - yMin) / 65535;
+	_packedCurves.setSize(bezierCount * 4, 0);
+	for (size_t bezier = 0; bezier < bezierCount; bezier++) {
+		float *control = controls.buffer() + bezier * 4, *end = ends.buffer() + bezier * 4;
+		float span = end[2] - end[0];
+		unsigned short *packed = _packedCurves.buffer() + bezier * 4;
+		packed[0] = (unsigned short) (MathUtil::clamp((control[0] - end[0]) / span, 0, 1) * 65535 + 0.5f);
+		packed[1] = (unsigned short) (_packedScale > 0 ? (control[1] - yMin) / _packedScale + 0.5f : 0);
+		packed[2] = (unsigned short) (MathUtil::clamp((control[2] - end[0]) / span, 0, 1) * 65535 + 0.5f);
+		packed[3] = (unsigned short) (_packedScale > 0 ? (control[3] - yMin) / _packedScale + 0.5f : 0);
+	}
+
+	// Measure the error against the original points before dropping them.
+	float error = 0;
+	for (size_t bezier = 0; bezier < bezierCount; bezier++) {
+		size_t i = frameCount + bezier * BEZIER_SIZE;
+		float *end = ends.buffer() + bezier * 4;
+		expandBezier(i, end[0], end[1], end[2], end[3], expanded);
+		for (int ii = 0; ii < BEZIER_SIZE; ii++)
+			error = MathUtil::max(error, MathUtil::abs(expanded[ii] - _curves[i + ii]));
+	}
+	_curves.setSize(frameCount, 0);
+	_curves.shrinkToFit();
+	return error;
+}
+
+void CurveTimeline::expandBezier(size_t i, float time1, float value1, float time2, float value2, float *curves) {
+	const unsigned short *packed = _packedCurves.buffer() + (i - getFrameCount()) / BEZIER_SIZE * 4;
+	float span = (time2 - time1) / 65535;
+	computeBezier(curves, time1, value1, time1 + packed[0] * span, _packedMin + packed[1] * _packedScale,
+				  time1 + packed[2] * span, _packedMin + packed[3] * _packedScale, time2, value2);
+}
+
 RTTI_IMPL(CurveTimeline1, CurveTimeline)
 
 CurveTimeline1::CurveTimeline1(size_t frameCount, size_t bezierCount) : CurveTimeline(frameCount,
@@ -110,14 +239,8 @@ void CurveTimeline1::setFrame(size_t frame, float time, float value) {
 	_frames[frame + CurveTimeline1::VALUE] = value;
 }
 
-float CurveTimeline1::getCurveValue(float time) {
-	int i = (int) _frames.size() - 2;
-	for (int ii = 2; ii <= i; ii += 2) {
-		if (_frames[ii] > time) {
-			i = ii - 2;
-			break;
-		}
-	}
+float CurveTimeline1::getCurveValue(float time, int *cursor) {
+	int i = Animation::search(_frames, time, CurveTimeline1::ENTRIES, cursor);
 
 	int curveType = (int) _curves[i >> 1];
 	switch (curveType) {
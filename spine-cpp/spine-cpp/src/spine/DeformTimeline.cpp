@@ -36,16 +36,178 @@
 
 #include <spine/Animation.h>
 #include <spine/Bone.h>
+#include <spine/MathUtil.h>
 #include <spine/Property.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
 
 using namespace spine;
 
+/// The vertices of a compressed key, decompressed on access.
+struct DeformTimeline::PackedKey {
+	const short *values;
+	size_t start, end;
+	float scale;
+	const float *setupVertices;
+
+	PackedKey(DeformTimeline &timeline, size_t frame) {
+		const int *key = timeline._packedKeys.buffer() + frame * 3;
+		values = timeline._packedVertices.buffer() + key[0];
+		start = (size_t) key[1];
+		end = (size_t) key[2];
+		scale = timeline._packedVertexScale;
+		setupVertices = timeline._attachment->getBones().size() == 0 ? timeline._attachment->getVertices().buffer() : NULL;
+	}
+
+	inline float operator[](size_t i) const {
+		float value = i >= start && i < end ? values[i - start] * scale : 0;
+		return setupVertices ? setupVertices[i] + value : value;
+	}
+};
+
+namespace {
+	inline short quantize(float value, float scale) {
+		return (short) (value >= 0 ? value / scale + 0.5f : value / scale - 0.5f);
+	}
+
+	/// Sets the deform from the vertices of the last key. Vertices is a Vector<float> or a DeformTimeline::PackedKey.
+	template<typename Vertices>
+	void applyLast(Vector<float> &deform, Vertices &lastVertices, size_t vertexCount, VertexAttachment *vertexAttachment,
+				   float alpha, MixBlend blend) {
+		if (alpha == 1) {
+			if (blend == MixBlend_Add) {
+				if (vertexAttachment->getBones().size() == 0) {
+					// Unweighted vertex positions, no alpha.
+					Vector<float> &setupVertices = vertexAttachment->getVertices();
+					for (size_t i = 0; i < vertexCount; i++)
+						deform[i] += lastVertices[i] - setupVertices[i];
+				} else {
+					// Weighted deform offsets, no alpha.
+					for (size_t i = 0; i < vertexCount; i++)
+						deform[i] += lastVertices[i];
+				}
+			} else {
+				// Vertex positions or deform offsets, no alpha.
+				for (size_t i = 0; i < vertexCount; i++)
+					deform[i] = lastVertices[i];
+			}
+		} else {
+			switch (blend) {
+				case MixBlend_Setup: {
+					if (vertexAttachment->getBones().size() == 0) {
+						// Unweighted vertex positions, with alpha.
+						Vector<float> &setupVertices = vertexAttachment->getVertices();
+						for (size_t i = 0; i < vertexCount; i++) {
+							float setup = setupVertices[i];
+							deform[i] = setup + (lastVertices[i] - setup) * alpha;
+						}
+					} else {
+						// Weighted deform offsets, with alpha.
+						for (size_t i = 0; i < vertexCount; i++)
+							deform[i] = lastVertices[i] * alpha;
+					}
+					break;
+				}
+				case MixBlend_First:
+				case MixBlend_Replace:
+					// Vertex positions or deform offsets, with alpha.
+					for (size_t i = 0; i < vertexCount; i++)
+						deform[i] += (lastVertices[i] - deform[i]) * alpha;
+					break;
+				case MixBlend_Add:
+					if (vertexAttachment->getBones().size() == 0) {
+						// Unweighted vertex positions, no alpha.
+						Vector<float> &setupVertices = vertexAttachment->getVertices();
+						for (size_t i = 0; i < vertexCount; i++)
+							deform[i] += (lastVertices[i] - setupVertices[i]) * alpha;
+					} else {
+						// Weighted deform offsets, alpha.
+						for (size_t i = 0; i < vertexCount; i++)
+							deform[i] += lastVertices[i] * alpha;
+					}
+			}
+		}
+	}
+
+	/// Sets the deform from the vertices of two keys. Vertices is a Vector<float> or a DeformTimeline::PackedKey.
+	template<typename Vertices>
+	void applyBetween(Vector<float> &deform, Vertices &prevVertices, Vertices &nextVertices, float percent,
+					  size_t vertexCount, VertexAttachment *vertexAttachment, float alpha, MixBlend blend) {
+		if (alpha == 1) {
+			if (blend == MixBlend_Add) {
+				if (vertexAttachment->getBones().size() == 0) {
+					// Unweighted vertex positions, no alpha.
+					Vector<float> &setupVertices = vertexAttachment->getVertices();
+					for (size_t i = 0; i < vertexCount; i++) {
+						float prev = prevVertices[i];
+						deform[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
+					}
+				} else {
+					// Weighted deform offsets, no alpha.
+					for (size_t i = 0; i < vertexCount; i++) {
+						float prev = prevVertices[i];
+						deform[i] += prev + (nextVertices[i] - prev) * percent;
+					}
+				}
+			} else {
+				// Vertex positions or deform offsets, no alpha.
+				for (size_t i = 0; i < vertexCount; i++) {
+					float prev = prevVertices[i];
+					deform[i] = prev + (nextVertices[i] - prev) * percent;
+				}
+			}
+		} else {
+			switch (blend) {
+				case MixBlend_Setup: {
+					if (vertexAttachment->getBones().size() == 0) {
+						// Unweighted vertex positions, with alpha.
+						Vector<float> &setupVertices = vertexAttachment->getVertices();
+						for (size_t i = 0; i < vertexCount; i++) {
+							float prev = prevVertices[i], setup = setupVertices[i];
+							deform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
+						}
+					} else {
+						// Weighted deform offsets, with alpha.
+						for (size_t i = 0; i < vertexCount; i++) {
+							float prev = prevVertices[i];
+							deform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
+						}
+					}
+					break;
+				}
+				case MixBlend_First:
+				case MixBlend_Replace:
+					// Vertex positions or deform offsets, with alpha.
+					for (size_t i = 0; i < vertexCount; i++) {
+						float prev = prevVertices[i];
+						deform[i] += (prev + (nextVertices[i] - prev) * percent - deform[i]) * alpha;
+					}
+					break;
+				case MixBlend_Add:
+					if (vertexAttachment->getBones().size() == 0) {
+						// Unweighted vertex positions, with alpha.
+						Vector<float> &setupVertices = vertexAttachment->getVertices();
+						for (size_t i = 0; i < vertexCount; i++) {
+							float prev = prevVertices[i];
+							deform[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
+						}
+					} else {
+						// Weighted deform offsets, with alpha.
+						for (size_t i = 0; i < vertexCount; i++) {
+							float prev = prevVertices[i];
+							deform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
+						}
+					}
+			}
+		}
+	}
+}
+
 RTTI_IMPL(DeformTimeline, CurveTimeline)
 
 DeformTimeline::DeformTimeline(size_t frameCount, size_t bezierCount, int slotIndex, VertexAttachment *attachment)
-	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _attachment(attachment) {
+	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _packedVertexScale(0), _vertexCount(0),
+	  _attachment(attachment) {
 	PropertyId ids[] = {((PropertyId) Property_Deform << 32) | ((slotIndex << 16 | attachment->_id) & 0xffffffff)};
 	setPropertyIds(ids, 1);
 
@@ -58,6 +220,11 @@ DeformTimeline::DeformTimeline(size_t frameCount, size_t bezierCount, int slotIn
 
 void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						   MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void DeformTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+								 MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -82,7 +249,7 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	Vector<Vector<float>> &vertices = _vertices;
-	size_t vertexCount = vertices[0].size();
+	size_t vertexCount = _packedKeys.size() > 0 ? _vertexCount : vertices[0].size();
 
 	Vector<float> &frames = _frames;
 	if (time < _frames[0]) {
@@ -120,147 +287,30 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	Vector<float> &deform = deformArray;
 
 	if (time >= frames[frames.size() - 1]) {// Time is after last frame.
-		Vector<float> &lastVertices = vertices[frames.size() - 1];
-		if (alpha == 1) {
-			if (blend == MixBlend_Add) {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] - setupVertices[i];
-				} else {
-					// Weighted deform offsets, no alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i];
-				}
-			} else {
-				// Vertex positions or deform offsets, no alpha.
-				memcpy(deform.buffer(), lastVertices.buffer(), vertexCount * sizeof(float));
-			}
-		} else {
-			switch (blend) {
-				case MixBlend_Setup: {
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, with alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++) {
-							float setup = setupVertices[i];
-							deform[i] = setup + (lastVertices[i] - setup) * alpha;
-						}
-					} else {
-						// Weighted deform offsets, with alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] = lastVertices[i] * alpha;
-					}
-					break;
-				}
-				case MixBlend_First:
-				case MixBlend_Replace:
-					// Vertex positions or deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += (lastVertices[i] - deform[i]) * alpha;
-					break;
-				case MixBlend_Add:
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, no alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += (lastVertices[i] - setupVertices[i]) * alpha;
-					} else {
-						// Weighted deform offsets, alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += lastVertices[i] * alpha;
-					}
-			}
-		}
+		size_t frame = frames.size() - 1;
+		if (_packedKeys.size() > 0) {
+			PackedKey lastVertices(*this, frame);
+			applyLast(deform, lastVertices, vertexCount, attachment, alpha, blend);
+		} else
+			applyLast(deform, vertices[frame], vertexCount, attachment, alpha, blend);
 		return;
 	}
 
 	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::search(frames, time);
+	int frame = Animation::search(frames, time, 1, cursor);
 	float percent = getCurvePercent(time, frame);
-	Vector<float> &prevVertices = vertices[frame];
-	Vector<float> &nextVertices = vertices[frame + 1];
-
-	if (alpha == 1) {
-		if (blend == MixBlend_Add) {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, no alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
-				}
-			} else {
-				// Weighted deform offsets, no alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent;
-				}
-			}
-		} else {
-			// Vertex positions or deform offsets, no alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deform[i] = prev + (nextVertices[i] - prev) * percent;
-			}
-		}
-	} else {
-		switch (blend) {
-			case MixBlend_Setup: {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i], setup = setupVertices[i];
-						deform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-				break;
-			}
-			case MixBlend_First:
-			case MixBlend_Replace:
-				// Vertex positions or deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent - deform[i]) * alpha;
-				}
-				break;
-			case MixBlend_Add:
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-		}
-	}
+	if (_packedKeys.size() > 0) {
+		PackedKey prevVertices(*this, frame), nextVertices(*this, frame + 1);
+		applyBetween(deform, prevVertices, nextVertices, percent, vertexCount, attachment, alpha, blend);
+	} else
+		applyBetween(deform, vertices[frame], vertices[frame + 1], percent, vertexCount, attachment, alpha, blend);
 }
 
 void DeformTimeline::setBezier(size_t bezier, size_t frame, float value, float time1, float value1, float cx1, float cy1,
 							   float cx2, float cy2, float time2, float value2) {
 	SP_UNUSED(value1);
 	SP_UNUSED(value2);
+	assert(!isCompressed());
 	size_t i = getFrameCount() + bezier * DeformTimeline::BEZIER_SIZE;
 	if (value == 0) _curves[frame] = DeformTimeline::BEZIER + i;
 	float tmpx = (time1 - cx1 * 2 + cx2) * 0.03, tmpy = cy2 * 0.03 - cy1 * 0.06;
@@ -294,27 +344,82 @@ float DeformTimeline::getCurvePercent(float time, int frame) {
 		}
 	}
 	i -= DeformTimeline::BEZIER;
-	if (_curves[i] > time) {
+	float expanded[DeformTimeline::BEZIER_SIZE];
+	const float *curves = _curves.buffer() + i;
+	if (isCompressed()) {
+		expandBezier(i, _frames[frame], 0, _frames[frame + getFrameEntries()], 1, expanded);
+		curves = expanded;
+	}
+	if (curves[0] > time) {
 		float x = _frames[frame];
-		return _curves[i + 1] * (time - x) / (_curves[i] - x);
+		return curves[1] * (time - x) / (curves[0] - x);
 	}
-	int n = i + DeformTimeline::BEZIER_SIZE;
-	for (i += 2; i < n; i += 2) {
-		if (_curves[i] >= time) {
-			float x = _curves[i - 2], y = _curves[i - 1];
-			return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
+	for (i = 2; i < DeformTimeline::BEZIER_SIZE; i += 2) {
+		if (curves[i] >= time) {
+			float x = curves[i - 2], y = curves[i - 1];
+			return y + (time - x) / (curves[i] - x) * (curves[i + 1] - y);
 		}
 	}
-	float x = _curves[n - 2], y = _curves[n - 1];
+	float x = curves[DeformTimeline::BEZIER_SIZE - 2], y = curves[DeformTimeline::BEZIER_SIZE - 1];
 	return y + (1 - y) * (time - x) / (_frames[frame + getFrameEntries()] - x);
 }
 
 void DeformTimeline::setFrame(int frame, float time, Vector<float> &vertices) {
+	assert(_packedKeys.size() == 0);
 	_frames[frame] = time;
 	_vertices[frame].clear();
 	_vertices[frame].addAll(vertices);
 }
 
+float DeformTimeline::compress() {
+	Timeline::compress();
+	float error = compressCurves(true);
+	if (_packedKeys.size() > 0 || _vertices.size() == 0) return error;
+
+	// Unweighted keys are stored relative to the setup vertices, so unchanged vertices are 0 like weighted offsets.
+	size_t frameCount = _vertices.size(), vertexCount = _vertices[0].size();
+	float *setupVertices = _attachment->getBones().size() == 0 ? _attachment->getVertices().buffer() : NULL;
+	float max = 0;
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		float *vertices = _vertices[frame].buffer();
+		for (size_t i = 0; i < vertexCount; i++)
+			max = MathUtil::max(max, MathUtil::abs(setupVertices ? vertices[i] - setupVertices[i] : vertices[i]));
+	}
+	_packedVertexScale = max / 32767;
+
+	_packedKeys.setSize(frameCount * 3, 0);
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		float *vertices = _vertices[frame].buffer();
+		size_t start = vertexCount, end = 0, offset = _packedVertices.size();
+		for (size_t i = 0; i < vertexCount; i++) {
+			float value = setupVertices ? vertices[i] - setupVertices[i] : vertices[i];
+			if (_packedVertexScale > 0 && quantize(value, _packedVertexScale) != 0) {
+				if (start == vertexCount) start = i;
+				end = i + 1;
+			}
+		}
+		if (start > end) start = end = 0;
+		for (size_t i = start; i < end; i++) {
+			float value = setupVertices ? vertices[i] - setupVertices[i] : vertices[i];
+			_packedVertices.add(quantize(value, _packedVertexScale));
+		}
+		_packedKeys[frame * 3] = (int) offset;
+		_packedKeys[frame * 3 + 1] = (int) start;
+		_packedKeys[frame * 3 + 2] = (int) end;
+	}
+	_packedVertices.shrinkToFit();
+
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		PackedKey key(*this, frame);
+		for (size_t i = 0; i < vertexCount; i++)
+			error = MathUtil::max(error, MathUtil::abs(key[i] - _vertices[frame][i]));
+	}
+	_vertexCount = vertexCount;
+	_vertices.clear();
+	_vertices.shrinkToFit();
+	return error;
+}
+
 Vector<Vector<float>> &DeformTimeline::getVertices() {
 	return _vertices;
 }
@@ -54,6 +54,11 @@ DrawOrderTimeline::DrawOrderTimeline(size_t frameCount) : Timeline(frameCount, 1
 
 void DrawOrderTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 							  MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void DrawOrderTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+									MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(alpha);
@@ -80,7 +85,7 @@ void DrawOrderTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 		return;
 	}
 
-	Vector<int> &drawOrderToSetupIndex = _drawOrders[Animation::search(_frames, time)];
+	Vector<int> &drawOrderToSetupIndex = _drawOrders[Animation::search(_frames, time, 1, cursor)];
 	if (drawOrderToSetupIndex.size() == 0) {
 		drawOrder.clear();
 		for (size_t i = 0, n = slots.size(); i < n; ++i)
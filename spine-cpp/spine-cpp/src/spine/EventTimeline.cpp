@@ -57,6 +57,11 @@ EventTimeline::~EventTimeline() {
 
 void EventTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						  MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void EventTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+								MixBlend blend, MixDirection direction, int *cursor) {
 	if (pEvents == NULL) return;
 
 	Vector<Event *> &events = *pEvents;
@@ -78,7 +83,7 @@ void EventTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	if (lastTime < _frames[0]) {
 		i = 0;
 	} else {
-		i = Animation::search(_frames, lastTime) + 1;
+		i = Animation::search(_frames, lastTime, 1, cursor) + 1;
 		float frameTime = _frames[i];
 		while (i > 0) {
 			// Fire multiple events with the same i.
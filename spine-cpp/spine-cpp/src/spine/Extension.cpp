@@ -32,6 +32,19 @@
 
 #include <assert.h>
 
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPINE_MMAP
+#endif
+
 using namespace spine;
 
 SpineExtension *SpineExtension::_instance = NULL;
@@ -119,5 +132,51 @@ char *DefaultSpineExtension::_readFile(const String &path, int *length) {
 	return data;
 }
 
+char *DefaultSpineExtension::_mapFile(const String &path, int *length) {
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.buffer(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return NULL;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || size.QuadPart > 0x7fffffff) {
+		CloseHandle(file);
+		return NULL;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	CloseHandle(file);
+	if (!mapping) return NULL;
+	char *data = (char *) MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!data) return NULL;
+	*length = (int) size.QuadPart;
+	return data;
+#elif defined(SPINE_MMAP)
+	int file = open(path.buffer(), O_RDONLY);
+	if (file < 0) return NULL;
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0 || info.st_size > 0x7fffffff) {
+		close(file);
+		return NULL;
+	}
+	void *data = mmap(NULL, (size_t) info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED) return NULL;
+	*length = (int) info.st_size;
+	return (char *) data;
+#else
+	return SpineExtension::_mapFile(path, length);
+#endif
+}
+
+void DefaultSpineExtension::_unmapFile(char *data, int length) {
+#if defined(_WIN32)
+	SP_UNUSED(length);
+	UnmapViewOfFile(data);
+#elif defined(SPINE_MMAP)
+	munmap(data, (size_t) length);
+#else
+	SpineExtension::_unmapFile(data, length);
+#endif
+}
+
 DefaultSpineExtension::DefaultSpineExtension() : SpineExtension() {
 }
@@ -51,6 +51,11 @@ IkConstraintTimeline::IkConstraintTimeline(size_t frameCount, size_t bezierCount
 
 void IkConstraintTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 								 MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void IkConstraintTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+									   MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 
@@ -80,7 +85,7 @@ void IkConstraintTimeline::apply(Skeleton &skeleton, float lastTime, float time,
 	}
 
 	float mix = 0, softness = 0;
-	int i = Animation::search(_frames, time, IkConstraintTimeline::ENTRIES);
+	int i = Animation::search(_frames, time, IkConstraintTimeline::ENTRIES, cursor);
 	int curveType = (int) _curves[i / IkConstraintTimeline::ENTRIES];
 	switch (curveType) {
 		case IkConstraintTimeline::LINEAR: {
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #endif
 
 #include <spine/Json.h>
+#include <spine/Arena.h>
 #include <spine/Extension.h>
 #include <spine/SpineString.h>
 
@@ -54,6 +55,14 @@ const int Json::JSON_OBJECT = 6;
 const char *Json::_error = NULL;
 
 Json *Json::getItem(Json *object, const char *string) {
+	if (object->_index && string) {
+		/* The slots are never all used, so the probe ends at the first child with the name or an empty slot. */
+		size_t mask = getIndexCapacity(object->_size) - 1;
+		for (size_t i = hashName(string) & mask;; i = (i + 1) & mask) {
+			Json *c = object->_index[i];
+			if (!c || !json_strcasecmp(c->_name, string)) return c;
+		}
+	}
 	Json *c = object->_child;
 	while (c && json_strcasecmp(c->_name, string)) {
 		c = c->_next;
@@ -114,35 +123,65 @@ Json::Json(const char *value) : _next(NULL),
 								_child(NULL),
 								_type(0),
 								_size(0),
+								_index(NULL),
 								_valueString(NULL),
 								_valueInt(0),
 								_valueFloat(0),
 								_name(NULL) {
-	if (value) {
-		value = parseValue(this, skip(value));
+	if (value) parse((char *) value, false);
+}
 
-		assert(value);
-	}
+Json::Json(char *value, bool inPlace) : _next(NULL),
+#if SPINE_JSON_HAVE_PREV
+										_prev(NULL),
+#endif
+										_child(NULL),
+										_type(0),
+										_size(0),
+										_index(NULL),
+										_valueString(NULL),
+										_valueInt(0),
+										_valueFloat(0),
+										_name(NULL) {
+	if (value) parse(value, inPlace);
 }
 
 Json::~Json() {
-	spine::Json *curr = NULL;
-	spine::Json *next = _child;
-	do {
-		curr = next;
-		if (curr) {
-			next = curr->_next;
-		}
-		delete curr;
-	} while (next);
+	/* Only the root is deleted, releasing all items at once. */
+	delete _arena;
+}
 
-	if (_valueString) {
-		SpineExtension::free(_valueString, __FILE__, __LINE__);
+struct Json::Items {
+	/* Items are never freed individually, so blocks of them avoid a header per item. Blocks of 16 fill the 16 KB chunks. */
+	static const int BLOCK_SIZE = 16;
+
+	Arena *arena;
+	Json *next, *end;
+
+	Json *create() {
+		if (next == end) {
+			next = (Json *) arena->alloc(sizeof(Json) * BLOCK_SIZE);
+			end = next + BLOCK_SIZE;
+		}
+		return new (next++) Json(NULL);
 	}
+};
 
-	if (_name) {
-		SpineExtension::free(_name, __FILE__, __LINE__);
+void Json::parse(char *value, bool inPlace) {
+	Arena *previous = Arena::setCurrent(NULL);
+	_arena = new (__FILE__, __LINE__) Arena(16 * 1024);
+	Arena::setCurrent(previous);
+	if (!inPlace) {
+		size_t length = strlen(value) + 1;
+		char *copy = (char *) _arena->alloc(length);
+		memcpy(copy, value, length);
+		value = copy;
 	}
+	Items items = {_arena, NULL, NULL};
+	const char *end = parseValue(this, skip(value), items);
+
+	assert(end);
+	SP_UNUSED(end);
 }
 
 const char *Json::skip(const char *inValue) {
@@ -158,7 +197,7 @@ const char *Json::skip(const char *inValue) {
 	return inValue;
 }
 
-const char *Json::parseValue(Json *item, const char *value) {
+const char *Json::parseValue(Json *item, const char *value, Items &items) {
 	/* Referenced by constructor, parseArray(), and parseObject(). */
 	/* Always called with the result of skip(). */
 #ifdef SPINE_JSON_DEBUG /* Checked at entry to graph, constructor, and after every parse call. */
@@ -195,9 +234,9 @@ const char *Json::parseValue(Json *item, const char *value) {
 		case '\"':
 			return parseString(item, value);
 		case '[':
-			return parseArray(item, value);
+			return parseArray(item, value, items);
 		case '{':
-			return parseObject(item, value);
+			return parseObject(item, value, items);
 		case '-': /* fallthrough */
 		case '0': /* fallthrough */
 		case '1': /* fallthrough */
@@ -218,13 +257,21 @@ const char *Json::parseValue(Json *item, const char *value) {
 	return NULL; /* failure. */
 }
 
+/* Powers of ten up to 1e22 are exact doubles, so looking them up gives the same result as pow(). */
+static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+									1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static inline double powerOf10(int n) {
+	return n < 23 ? powersOf10[n] : pow(10.0, n);
+}
+
 static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
 
 const char *Json::parseString(Json *item, const char *str) {
-	const char *ptr = str + 1;
+	char *ptr = (char *) str + 1;
 	char *ptr2;
-	char *out;
-	int len = 0;
+	char *out = ptr;
+	int len;
 	unsigned uc, uc2;
 	if (*str != '\"') {
 		/* TODO: don't need this check when called from parseValue, but do need from parseObject */
@@ -232,19 +279,12 @@ const char *Json::parseString(Json *item, const char *str) {
 		return 0;
 	} /* not a string! */
 
-	while (*ptr != '\"' && *ptr && ++len) {
-		if (*ptr++ == '\\') {
-			ptr++; /* Skip escaped quotes. */
-		}
+	/* Escapes only shorten the string, so it is unescaped in place. Most strings have none and are only terminated. */
+	while (*ptr != '\"' && *ptr != '\\' && *ptr) {
+		ptr++;
 	}
 
-	out = SpineExtension::alloc<char>(len + 1, __FILE__, __LINE__); /* The length needed for the string, roughly. */
-	if (!out) {
-		return 0;
-	}
-
-	ptr = str + 1;
-	ptr2 = out;
+	ptr2 = ptr;
 	while (*ptr != '\"' && *ptr) {
 		if (*ptr != '\\') {
 			*ptr2++ = *ptr++;
@@ -325,12 +365,12 @@ const char *Json::parseString(Json *item, const char *str) {
 		}
 	}
 
-	*ptr2 = 0;
-
 	if (*ptr == '\"') {
 		ptr++; /* TODO error handling if not \" or \0 ? */
 	}
 
+	*ptr2 = 0; /* May overwrite the closing quote. */
+
 	item->_valueString = out;
 	item->_type = JSON_STRING;
 
@@ -362,7 +402,7 @@ const char *Json::parseNumber(Json *item, const char *num) {
 			++ptr;
 			++n;
 		}
-		result += fraction / pow(10.0, n);
+		result += fraction / powerOf10(n);
 	}
 
 	if (negative) {
@@ -388,10 +428,11 @@ const char *Json::parseNumber(Json *item, const char *num) {
 			++n;
 		}
 
+		double scale = exponent < 23 ? powersOf10[(int) exponent] : pow(10, exponent);
 		if (expNegative) {
-			result = result / pow(10, exponent);
+			result = result / scale;
 		} else {
-			result = result * pow(10, exponent);
+			result = result * scale;
 		}
 	}
 
@@ -408,7 +449,7 @@ const char *Json::parseNumber(Json *item, const char *num) {
 	}
 }
 
-const char *Json::parseArray(Json *item, const char *value) {
+const char *Json::parseArray(Json *item, const char *value, Items &items) {
 	Json *child;
 
 #ifdef SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -424,12 +465,12 @@ const char *Json::parseArray(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new (__FILE__, __LINE__) Json(NULL);
+	item->_child = child = items.create();
 	if (!item->_child) {
 		return NULL; /* memory fail */
 	}
 
-	value = skip(parseValue(child, skip(value))); /* skip any spacing, get the value. */
+	value = skip(parseValue(child, skip(value), items)); /* skip any spacing, get the value. */
 
 	if (!value) {
 		return NULL;
@@ -438,7 +479,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new (__FILE__, __LINE__) Json(NULL);
+		Json *new_item = items.create();
 		if (!new_item) {
 			return NULL; /* memory fail */
 		}
@@ -447,7 +488,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parseValue(child, skip(value + 1)));
+		value = skip(parseValue(child, skip(value + 1), items));
 		if (!value) {
 			return NULL; /* parse fail */
 		}
@@ -464,7 +505,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 }
 
 /* Build an object from the text. */
-const char *Json::parseObject(Json *item, const char *value) {
+const char *Json::parseObject(Json *item, const char *value, Items &items) {
 	Json *child;
 
 #ifdef SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -480,7 +521,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new (__FILE__, __LINE__) Json(NULL);
+	item->_child = child = items.create();
 	if (!item->_child) {
 		return NULL;
 	}
@@ -495,7 +536,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 		return NULL;
 	} /* fail! */
 
-	value = skip(parseValue(child, skip(value + 1))); /* skip any spacing, get the value. */
+	value = skip(parseValue(child, skip(value + 1), items)); /* skip any spacing, get the value. */
 	if (!value) {
 		return NULL;
 	}
@@ -503,7 +544,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new (__FILE__, __LINE__) Json(NULL);
+		Json *new_item = items.create();
 		if (!new_item) {
 			return NULL; /* memory fail */
 		}
@@ -523,7 +564,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 			return NULL;
 		} /* fail! */
 
-		value = skip(parseValue(child, skip(value + 1))); /* skip any spacing, get the value. */
+		value = skip(parseValue(child, skip(value + 1), items)); /* skip any spacing, get the value. */
 		if (!value) {
 			return NULL;
 		}
@@ -531,6 +572,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 	}
 
 	if (*value == '}') {
+		if (item->_size >= INDEX_SIZE) buildIndex(item, items.arena);
 		return value + 1; /* end of array */
 	}
 
@@ -544,11 +586,16 @@ int Json::json_strcasecmp(const char *s1, const char *s2) {
 	 * the graph and input (only callsite is Json_getItem) should not have NULLs
 	 */
 	if (s1 && s2) {
-#if defined(_WIN32)
-		return _stricmp(s1, s2);
-#else
-		return strcasecmp(s1, s2);
-#endif
+		/* Keys are ASCII, so skip the locale aware library compare. */
+		for (;; s1++, s2++) {
+			int c1 = (unsigned char) *s1, c2 = (unsigned char) *s2;
+			if (c1 != c2) {
+				if (c1 >= 'A' && c1 <= 'Z') c1 += 'a' - 'A';
+				if (c2 >= 'A' && c2 <= 'Z') c2 += 'a' - 'A';
+				if (c1 != c2) return c1 - c2;
+			}
+			if (!c1) return 0;
+		}
 	} else {
 		if (s1 < s2) {
 			return -1; /* s1 is null, s2 is not */
@@ -559,3 +606,33 @@ int Json::json_strcasecmp(const char *s1, const char *s2) {
 		}
 	}
 }
+
+size_t Json::hashName(const char *name) {
+	size_t hash = 2166136261u;
+	for (; *name; name++) {
+		int c = (unsigned char) *name;
+		if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+		hash = (hash ^ (size_t) c) * 16777619u;
+	}
+	return hash;
+}
+
+size_t Json::getIndexCapacity(int size) {
+	size_t capacity = INDEX_SIZE * 2;
+	while (capacity < (size_t) size * 2)
+		capacity <<= 1;
+	return capacity;
+}
+
+void Json::buildIndex(Json *item, Arena *arena) {
+	/* Children are added in order, so for duplicate names the probe finds the first, as the linear search does. */
+	size_t capacity = getIndexCapacity(item->_size), mask = capacity - 1;
+	item->_index = (Json **) arena->alloc(sizeof(Json *) * capacity);
+	memset(item->_index, 0, sizeof(Json *) * capacity);
+	for (Json *c = item->_child; c; c = c->_next) {
+		size_t i = hashName(c->_name) & mask;
+		while (item->_index[i])
+			i = (i + 1) & mask;
+		item->_index[i] = c;
+	}
+}
@@ -31,6 +31,14 @@
 #include <math.h>
 #include <stdlib.h>
 
+#if !defined(SPINE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SPINE_MATH_SSE2
+#include <emmintrin.h>
+#elif !defined(SPINE_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define SPINE_MATH_NEON
+#include <arm_neon.h>
+#endif
+
 // Required for division by 0 in _isNaN on MSVC
 #ifdef _MSC_VER
 #pragma warning(disable : 4723)
@@ -60,19 +68,168 @@ float MathUtil::fmod(float a, float b) {
 	return (float) ::fmod(a, b);
 }
 
-/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-/// degrees), largest error of 0.00488 radians (0.2796 degrees).
+#ifdef SPINE_FAST_MATH
+static MathPrecision _precision = MathPrecision_Fast;
+#else
+static MathPrecision _precision = MathPrecision_Precise;
+#endif
+
+namespace {
+	// Sine and cosine minimax polynomials for [-pi/4, pi/4] (Cephes sinf/cosf).
+	const float SIN1 = -1.6666654611e-1f, SIN2 = 8.3321608736e-3f, SIN3 = -1.9515295891e-4f;
+	const float COS1 = 4.166664568298827e-2f, COS2 = -1.388731625493765e-3f, COS3 = 2.443315711809948e-5f;
+	// Arctangent minimax polynomial for [-tan(pi/8), tan(pi/8)] (Cephes atanf).
+	const float ATAN1 = -3.33329491539e-1f, ATAN2 = 1.99777106478e-1f, ATAN3 = -1.38776856032e-1f,
+				ATAN4 = 8.05374449538e-2f;
+	const float TAN_PI_8 = 0.4142135623730950f;
+	// pi / 2 split in three parts so the first products of the range reduction are exact (Cody-Waite).
+	const float PI_2_1 = 1.5703125f, PI_2_2 = 4.837512969970703125e-4f, PI_2_3 = 7.54978995489188216e-8f;
+
+	inline unsigned int floatBits(float value) {
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	inline float bitsFloat(unsigned int bits) {
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	/// Rounds half away from zero. Adds 0.5 with the sign of the value copied over, so there is no unpredictable branch.
+	inline int roundToInt(float value) {
+		return (int) (value + bitsFloat(floatBits(0.5f) | (floatBits(value) & 0x80000000u)));
+	}
+
+	/// Evaluates both polynomials for r in [-pi/4, pi/4], then swaps or negates them for the angle r + q * pi / 2. The
+	/// quadrant of arbitrary angles is unpredictable, so this is done with bit masks rather than branches.
+	inline void polySinCos(float r, int q, float &outSin, float &outCos) {
+		float r2 = r * r;
+		unsigned int s = floatBits(r + r * r2 * (SIN1 + r2 * (SIN2 + r2 * SIN3)));
+		unsigned int c = floatBits(1 - 0.5f * r2 + r2 * r2 * (COS1 + r2 * (COS2 + r2 * COS3)));
+		unsigned int swap = 0u - (unsigned int) (q & 1);
+		outSin = bitsFloat(((c & swap) | (s & ~swap)) ^ ((unsigned int) (q & 2) << 30));
+		outCos = bitsFloat(((s & swap) | (c & ~swap)) ^ ((unsigned int) ((q + 1) & 2) << 30));
+	}
+
+	/// Reduces the angle to [-45, 45] degrees around the nearest multiple of 90 degrees. Reducing in degrees is exact for
+	/// the angles bones use, which avoids the rounding error of reducing by an inexact pi / 2.
+	inline void fastSinCosDeg(float degrees, float &outSin, float &outCos) {
+		int q = roundToInt(degrees * (1 / 90.0f));
+		polySinCos((degrees - (float) q * 90) * MathUtil::Deg_Rad, q, outSin, outCos);
+	}
+
+	inline void fastSinCos(float radians, float &outSin, float &outCos) {
+		int q = roundToInt(radians * (2 / MathUtil::Pi));
+		float qf = (float) q;
+		polySinCos(((radians - qf * PI_2_1) - qf * PI_2_2) - qf * PI_2_3, q, outSin, outCos);
+	}
+
+	/// Reduces to the first octant using the ratio of the smaller to the larger magnitude, then reduces once more around
+	/// pi / 4 so the polynomial only sees [-tan(pi/8), tan(pi/8)].
+	inline float fastAtan2(float y, float x) {
+		float ax = x < 0 ? -x : x, ay = y < 0 ? -y : y;
+		float mx = ax > ay ? ax : ay, mn = ax > ay ? ay : ax;
+		if (mx == 0) return signbit(x) ? (signbit(y) ? -MathUtil::Pi : MathUtil::Pi) : y;
+		float t = mn / mx, offset = 0;
+		if (t > TAN_PI_8) {
+			t = (t - 1) / (t + 1);
+			offset = MathUtil::Pi / 4;
+		}
+		float t2 = t * t;
+		float r = offset + t + t * t2 * (ATAN1 + t2 * (ATAN2 + t2 * (ATAN3 + t2 * ATAN4)));
+		if (ay > ax) r = MathUtil::Pi / 2 - r;
+		if (x < 0) r = MathUtil::Pi - r;
+		return signbit(y) ? -r : r;
+	}
+
+#if defined(SPINE_MATH_SSE2)
+	inline void fastSinCosDeg4(const float *degrees, float *outSin, float *outCos) {
+		__m128 d = _mm_loadu_ps(degrees);
+		// Rounds half away from zero like roundToInt(), _mm_cvtps_epi32() would round half to even.
+		__m128 qf = _mm_mul_ps(d, _mm_set1_ps(1 / 90.0f));
+		__m128 half = _mm_or_ps(_mm_set1_ps(0.5f), _mm_and_ps(qf, _mm_set1_ps(-0.0f)));
+		__m128i q = _mm_cvttps_epi32(_mm_add_ps(qf, half));
+		__m128 r = _mm_mul_ps(_mm_sub_ps(d, _mm_mul_ps(_mm_cvtepi32_ps(q), _mm_set1_ps(90))),
+							  _mm_set1_ps(MathUtil::Deg_Rad));
+		__m128 r2 = _mm_mul_ps(r, r);
+		__m128 s = _mm_add_ps(_mm_set1_ps(SIN2), _mm_mul_ps(r2, _mm_set1_ps(SIN3)));
+		s = _mm_add_ps(_mm_set1_ps(SIN1), _mm_mul_ps(r2, s));
+		s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), s));
+		__m128 c = _mm_add_ps(_mm_set1_ps(COS2), _mm_mul_ps(r2, _mm_set1_ps(COS3)));
+		c = _mm_add_ps(_mm_set1_ps(COS1), _mm_mul_ps(r2, c));
+		c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1), _mm_mul_ps(_mm_set1_ps(0.5f), r2)), _mm_mul_ps(_mm_mul_ps(r2, r2), c));
+
+		__m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+		__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+		__m128 sinV = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+		__m128 cosV = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+		__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, two), 30));
+		__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30));
+		_mm_storeu_ps(outSin, _mm_xor_ps(sinV, sinSign));
+		_mm_storeu_ps(outCos, _mm_xor_ps(cosV, cosSign));
+	}
+#elif defined(SPINE_MATH_NEON)
+	inline void fastSinCosDeg4(const float *degrees, float *outSin, float *outCos) {
+		float32x4_t d = vld1q_f32(degrees);
+		float32x4_t qf = vmulq_n_f32(d, 1 / 90.0f);
+		uint32x4_t negative = vcltq_f32(qf, vdupq_n_f32(0));
+		int32x4_t q = vcvtq_s32_f32(vaddq_f32(qf, vbslq_f32(negative, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f))));
+		float32x4_t r = vmulq_n_f32(vsubq_f32(d, vmulq_n_f32(vcvtq_f32_s32(q), 90)), MathUtil::Deg_Rad);
+		float32x4_t r2 = vmulq_f32(r, r);
+		float32x4_t s = vaddq_f32(vdupq_n_f32(SIN2), vmulq_n_f32(r2, SIN3));
+		s = vaddq_f32(vdupq_n_f32(SIN1), vmulq_f32(r2, s));
+		s = vaddq_f32(r, vmulq_f32(vmulq_f32(r, r2), s));
+		float32x4_t c = vaddq_f32(vdupq_n_f32(COS2), vmulq_n_f32(r2, COS3));
+		c = vaddq_f32(vdupq_n_f32(COS1), vmulq_f32(r2, c));
+		c = vaddq_f32(vsubq_f32(vdupq_n_f32(1), vmulq_n_f32(r2, 0.5f)), vmulq_f32(vmulq_f32(r2, r2), c));
+
+		int32x4_t one = vdupq_n_s32(1), two = vdupq_n_s32(2);
+		uint32x4_t swap = vceqq_s32(vandq_s32(q, one), one);
+		float32x4_t sinV = vbslq_f32(swap, c, s);
+		float32x4_t cosV = vbslq_f32(swap, s, c);
+		uint32x4_t sinSign = vreinterpretq_u32_s32(vshlq_n_s32(vandq_s32(q, two), 30));
+		uint32x4_t cosSign = vreinterpretq_u32_s32(vshlq_n_s32(vandq_s32(vaddq_s32(q, one), two), 30));
+		vst1q_f32(outSin, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sinV), sinSign)));
+		vst1q_f32(outCos, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosV), cosSign)));
+	}
+#else
+	inline void fastSinCosDeg4(const float *degrees, float *outSin, float *outCos) {
+		for (int i = 0; i < 4; i++)
+			fastSinCosDeg(degrees[i], outSin[i], outCos[i]);
+	}
+#endif
+}
+
+void MathUtil::setPrecision(MathPrecision precision) {
+	_precision = precision;
+}
+
+MathPrecision MathUtil::getPrecision() {
+	return _precision;
+}
+
 float MathUtil::atan2(float y, float x) {
+	if (_precision == MathPrecision_Fast) return fastAtan2(y, x);
 	return (float) ::atan2(y, x);
 }
 
-/// Returns the cosine in radians from a lookup table.
 float MathUtil::cos(float radians) {
+	if (_precision == MathPrecision_Fast) {
+		float s, c;
+		fastSinCos(radians, s, c);
+		return c;
+	}
 	return (float) ::cos(radians);
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sin(float radians) {
+	if (_precision == MathPrecision_Fast) {
+		float s, c;
+		fastSinCos(radians, s, c);
+		return s;
+	}
 	return (float) ::sin(radians);
 }
 
@@ -84,16 +241,44 @@ float MathUtil::acos(float v) {
 	return (float) ::acos(v);
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sinDeg(float degrees) {
+	if (_precision == MathPrecision_Fast) {
+		float s, c;
+		fastSinCosDeg(degrees, s, c);
+		return s;
+	}
 	return (float) ::sin(degrees * MathUtil::Deg_Rad);
 }
 
-/// Returns the cosine in radians from a lookup table.
 float MathUtil::cosDeg(float degrees) {
+	if (_precision == MathPrecision_Fast) {
+		float s, c;
+		fastSinCosDeg(degrees, s, c);
+		return c;
+	}
 	return (float) ::cos(degrees * MathUtil::Deg_Rad);
 }
 
+void MathUtil::sinCosDeg(float degrees, float &outSin, float &outCos) {
+	if (_precision == MathPrecision_Fast) {
+		fastSinCosDeg(degrees, outSin, outCos);
+		return;
+	}
+	float radians = degrees * MathUtil::Deg_Rad;
+	outSin = (float) ::sin(radians);
+	outCos = (float) ::cos(radians);
+}
+
+void MathUtil::sinCosDeg(const float *degrees, float *outSin, float *outCos, size_t count) {
+	size_t i = 0;
+	if (_precision == MathPrecision_Fast) {
+		for (; i + 4 <= count; i += 4)
+			fastSinCosDeg4(degrees + i, outSin + i, outCos + i);
+	}
+	for (; i < count; i++)
+		sinCosDeg(degrees[i], outSin[i], outCos[i]);
+}
+
 /* Need to pass 0 as an argument, so VC++ doesn't error with C2124 */
 static bool _isNan(float value, float zero) {
 	float _nan = (float) 0.0 / zero;
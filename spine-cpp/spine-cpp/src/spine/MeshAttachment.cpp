@@ -166,6 +166,7 @@ void MeshAttachment::setParentMesh(MeshAttachment *inValue) {
 		_bones.clearAndAddAll(inValue->_bones);
 		_vertices.clearAndAddAll(inValue->_vertices);
 		_worldVerticesLength = inValue->_worldVerticesLength;
+		inValue->copySkinningLayout(this);
 		_regionUVs.clearAndAddAll(inValue->_regionUVs);
 		_triangles.clearAndAddAll(inValue->_triangles);
 		_hullLength = inValue->_hullLength;
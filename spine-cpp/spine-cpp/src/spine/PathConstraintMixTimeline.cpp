@@ -52,6 +52,11 @@ PathConstraintMixTimeline::PathConstraintMixTimeline(size_t frameCount, size_t b
 
 void PathConstraintMixTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 									  MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void PathConstraintMixTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+											MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -78,7 +83,7 @@ void PathConstraintMixTimeline::apply(Skeleton &skeleton, float lastTime, float
 	}
 
 	float rotate, x, y;
-	int i = Animation::search(_frames, time, PathConstraintMixTimeline::ENTRIES);
+	int i = Animation::search(_frames, time, PathConstraintMixTimeline::ENTRIES, cursor);
 	int curveType = (int) _curves[i >> 2];
 	switch (curveType) {
 		case LINEAR: {
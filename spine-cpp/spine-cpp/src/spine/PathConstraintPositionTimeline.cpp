@@ -57,6 +57,11 @@ PathConstraintPositionTimeline::~PathConstraintPositionTimeline() {
 
 void PathConstraintPositionTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
 										   float alpha, MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void PathConstraintPositionTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
+												 float alpha, MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -78,7 +83,7 @@ void PathConstraintPositionTimeline::apply(Skeleton &skeleton, float lastTime, f
 		}
 	}
 
-	float position = getCurveValue(time);
+	float position = getCurveValue(time, cursor);
 
 	if (blend == MixBlend_Setup)
 		constraint._position = constraint._data._position + (position - constraint._data._position) * alpha;
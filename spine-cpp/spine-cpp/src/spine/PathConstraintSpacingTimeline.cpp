@@ -54,6 +54,11 @@ PathConstraintSpacingTimeline::PathConstraintSpacingTimeline(size_t frameCount,
 
 void PathConstraintSpacingTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
 										  float alpha, MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void PathConstraintSpacingTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
+												float alpha, MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -75,7 +80,7 @@ void PathConstraintSpacingTimeline::apply(Skeleton &skeleton, float lastTime, fl
 		}
 	}
 
-	float spacing = getCurveValue(time);
+	float spacing = getCurveValue(time, cursor);
 
 	if (blend == MixBlend_Setup)
 		constraint._spacing = constraint._data._spacing + (spacing - constraint._data._spacing) * alpha;
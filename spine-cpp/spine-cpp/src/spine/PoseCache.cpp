@@ -0,0 +1,519 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/PoseCache.h>
+
+#include <spine/Animation.h>
+#include <spine/Bone.h>
+#include <spine/ChangeTracker.h>
+#include <spine/ContainerUtil.h>
+#include <spine/IkConstraint.h>
+#include <spine/MathUtil.h>
+#include <spine/PathConstraint.h>
+#include <spine/Property.h>
+#include <spine/Skeleton.h>
+#include <spine/Skin.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+#include <spine/Timeline.h>
+#include <spine/TransformConstraint.h>
+
+#include <string.h>
+
+#ifndef SPINE_NO_THREADS
+#include <mutex>
+#endif
+
+using namespace spine;
+
+#ifndef SPINE_NO_THREADS
+#define SPINE_POSE_LOCK() std::lock_guard<std::mutex> lock(_lock->_mutex)
+#else
+#define SPINE_POSE_LOCK()
+#endif
+
+namespace spine {
+	/// Guards the poses and scratch skeletons of one cache.
+	class PoseCache::Lock : public SpineObject {
+	public:
+#ifndef SPINE_NO_THREADS
+		std::mutex _mutex;
+#endif
+	};
+
+	/// The values of the properties an animation keys at one time. Each operation is a property type followed by the
+	/// index of the bone, slot or constraint, and consumes its values in order.
+	class PoseCache::Pose : public SpineObject {
+	public:
+		Vector<int> _operations;
+		Vector<float> _values;
+		Vector<Attachment *> _attachments;
+		Vector<int> _drawOrder;
+		Vector<float> _world; // Per bone a, b, c, d, worldX and worldY, for the skeleton at the origin and unscaled.
+	};
+}
+
+PoseCache::PoseKey::PoseKey(SkeletonData *skeletonData, Animation *animation, int skinId, long long time)
+	: _skeletonData(skeletonData), _animation(animation), _skinId(skinId), _time(time) {
+}
+
+bool PoseCache::PoseKey::operator==(const PoseKey &other) const {
+	return _time == other._time && _animation == other._animation && _skinId == other._skinId &&
+		   _skeletonData == other._skeletonData;
+}
+
+size_t PoseCache::PoseKey::hash() const {
+	size_t h = HashMapHasher<long long>::hash(_time);
+	h = h * 31 + HashMapHasher<long long>::hash((long long) (size_t) _animation);
+	h = h * 31 + HashMapHasher<long long>::hash(_skinId);
+	return h * 31 + HashMapHasher<long long>::hash((long long) (size_t) _skeletonData);
+}
+
+PoseCache::PoseCache(float timeStep, bool world) : _timeStep(timeStep), _world(world),
+												   _lock(new (__FILE__, __LINE__) Lock()), _hits(0), _misses(0) {
+}
+
+PoseCache::~PoseCache() {
+	clear();
+	ContainerUtil::cleanUpVectorOfPointers(_freePoses);
+	ContainerUtil::cleanUpVectorOfPointers(_scratchSkeletons);
+	delete _lock;
+}
+
+void PoseCache::apply(Skeleton &skeleton, Animation &animation, float time, bool loop) {
+	if (loop) {
+		float duration = animation.getDuration();
+		if (duration != 0) time = MathUtil::fmod(time, duration);
+	}
+	applyPose(*findPose(skeleton, animation, time), skeleton, _world);
+}
+
+void PoseCache::clear() {
+	SPINE_POSE_LOCK();
+	_poses.clear();
+	for (size_t i = 0; i < _usedPoses.size(); i++)
+		_freePoses.add(_usedPoses[i]);
+	_usedPoses.clear();
+}
+
+void PoseCache::setTimeStep(float timeStep) {
+	_timeStep = timeStep;
+	clear();
+}
+
+float PoseCache::getTimeStep() {
+	return _timeStep;
+}
+
+void PoseCache::setWorld(bool world) {
+	_world = world;
+	clear();
+}
+
+bool PoseCache::isWorld() {
+	return _world;
+}
+
+size_t PoseCache::getPoseCount() {
+	return _usedPoses.size();
+}
+
+int PoseCache::getHits() {
+	return _hits;
+}
+
+int PoseCache::getMisses() {
+	return _misses;
+}
+
+PoseCache::Pose *PoseCache::findPose(Skeleton &skeleton, Animation &animation, float time) {
+	long long key;
+	if (_timeStep > 0) {
+		float steps = time / _timeStep;
+		key = (long long) (steps < 0 ? steps - 0.5f : steps + 0.5f);
+		time = key * _timeStep;
+	} else {
+		union {
+			float value;
+			int bits;
+		} timeBits;
+		timeBits.value = time;
+		key = timeBits.bits;
+	}
+	// The skin is identified by its ID, a skin allocated where a deleted one was must not get the deleted one's poses.
+	Skin *skin = skeleton.getSkin();
+	PoseKey poseKey(skeleton.getData(), &animation, skin ? skin->getId() : -1, key);
+
+	Pose *pose = NULL;
+	Skeleton *scratch = NULL;
+	{
+		SPINE_POSE_LOCK();
+		if (_poses.containsKey(poseKey)) {
+			_hits++;
+			return _poses[poseKey];
+		}
+		_misses++;
+		if (_freePoses.size() > 0) {
+			pose = _freePoses[_freePoses.size() - 1];
+			_freePoses.removeAt(_freePoses.size() - 1);
+		}
+		for (size_t i = 0; i < _scratchSkeletons.size(); i++) {
+			if (_scratchSkeletons[i]->getData() == skeleton.getData()) {
+				scratch = _scratchSkeletons[i];
+				_scratchSkeletons.removeAt(i);
+				break;
+			}
+		}
+	}
+
+	// The pose is computed without the lock, with a scratch skeleton no other thread uses.
+	if (!pose) pose = new (__FILE__, __LINE__) Pose();
+	if (!scratch) scratch = new (__FILE__, __LINE__) Skeleton(skeleton.getData());
+	computePose(*pose, *scratch, skin, animation, time);
+
+	SPINE_POSE_LOCK();
+	_scratchSkeletons.add(scratch);
+	if (_poses.containsKey(poseKey)) {
+		// Another thread computed the same pose meanwhile.
+		_freePoses.add(pose);
+		return _poses[poseKey];
+	}
+	_usedPoses.add(pose);
+	_poses.put(poseKey, pose);
+	return pose;
+}
+
+void PoseCache::computePose(Pose &pose, Skeleton &scratch, Skin *skin, Animation &animation, float time) {
+	scratch.setSkin(skin);
+	scratch.setToSetupPose();
+	animation.apply(scratch, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+
+	pose._operations.clear();
+	pose._values.clear();
+	pose._attachments.clear();
+	pose._drawOrder.clear();
+	pose._world.clear();
+
+	Vector<float> &values = pose._values;
+	Vector<Bone *> &bones = scratch.getBones();
+	Vector<Slot *> &slots = scratch.getSlots();
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		Vector<PropertyId> &ids = timelines[i]->getPropertyIds();
+		for (size_t ii = 0; ii < ids.size(); ii++) {
+			int type = (int) (ids[ii] >> 32), index = (int) (ids[ii] & 0xffffffff);
+			// Deform and sequence ids also hold the attachment or sequence, the slot is in the high bits.
+			if (type == Property_Deform || type == Property_Sequence) index >>= 16;
+			// Timelines don't change inactive bones, slots and constraints, which are the same for skeletons with the skin.
+			bool active = true;
+			switch (type) {
+				case Property_Rotate:
+				case Property_X:
+				case Property_Y:
+				case Property_ScaleX:
+				case Property_ScaleY:
+				case Property_ShearX:
+				case Property_ShearY:
+					active = bones[index]->isActive();
+					break;
+				case Property_Rgb:
+				case Property_Alpha:
+				case Property_Rgb2:
+				case Property_Attachment:
+				case Property_Deform:
+				case Property_Sequence:
+					active = slots[index]->getBone().isActive();
+					break;
+				case Property_IkConstraint:
+					active = scratch.getIkConstraints()[index]->isActive();
+					break;
+				case Property_TransformConstraint:
+					active = scratch.getTransformConstraints()[index]->isActive();
+					break;
+				case Property_PathConstraintPosition:
+				case Property_PathConstraintSpacing:
+				case Property_PathConstraintMix:
+					active = scratch.getPathConstraints()[index]->isActive();
+					break;
+			}
+			if (!active) continue;
+			switch (type) {
+				case Property_Rotate:
+					values.add(bones[index]->_rotation);
+					break;
+				case Property_X:
+					values.add(bones[index]->_x);
+					break;
+				case Property_Y:
+					values.add(bones[index]->_y);
+					break;
+				case Property_ScaleX:
+					values.add(bones[index]->_scaleX);
+					break;
+				case Property_ScaleY:
+					values.add(bones[index]->_scaleY);
+					break;
+				case Property_ShearX:
+					values.add(bones[index]->_shearX);
+					break;
+				case Property_ShearY:
+					values.add(bones[index]->_shearY);
+					break;
+				case Property_Rgb: {
+					Color &color = slots[index]->getColor();
+					values.add(color.r);
+					values.add(color.g);
+					values.add(color.b);
+					break;
+				}
+				case Property_Alpha:
+					values.add(slots[index]->getColor().a);
+					break;
+				case Property_Rgb2: {
+					Color &color = slots[index]->getDarkColor();
+					values.add(color.r);
+					values.add(color.g);
+					values.add(color.b);
+					break;
+				}
+				case Property_Attachment:
+					pose._attachments.add(slots[index]->getAttachment());
+					break;
+				case Property_Deform: {
+					Vector<float> &deform = slots[index]->getDeform();
+					pose._attachments.add(slots[index]->getAttachment());
+					values.add((float) deform.size());
+					for (size_t iii = 0; iii < deform.size(); iii++)
+						values.add(deform[iii]);
+					break;
+				}
+				case Property_DrawOrder: {
+					Vector<Slot *> &drawOrder = scratch.getDrawOrder();
+					pose._drawOrder.clear();
+					for (size_t iii = 0; iii < drawOrder.size(); iii++)
+						pose._drawOrder.add(drawOrder[iii]->getData().getIndex());
+					break;
+				}
+				case Property_IkConstraint: {
+					IkConstraint &constraint = *scratch.getIkConstraints()[index];
+					values.add(constraint.getMix());
+					values.add(constraint.getSoftness());
+					values.add((float) constraint.getBendDirection());
+					values.add(constraint.getCompress() ? 1.0f : 0.0f);
+					values.add(constraint.getStretch() ? 1.0f : 0.0f);
+					break;
+				}
+				case Property_TransformConstraint: {
+					TransformConstraint &constraint = *scratch.getTransformConstraints()[index];
+					values.add(constraint.getMixRotate());
+					values.add(constraint.getMixX());
+					values.add(constraint.getMixY());
+					values.add(constraint.getMixScaleX());
+					values.add(constraint.getMixScaleY());
+					values.add(constraint.getMixShearY());
+					break;
+				}
+				case Property_PathConstraintPosition:
+					values.add(scratch.getPathConstraints()[index]->getPosition());
+					break;
+				case Property_PathConstraintSpacing:
+					values.add(scratch.getPathConstraints()[index]->getSpacing());
+					break;
+				case Property_PathConstraintMix: {
+					PathConstraint &constraint = *scratch.getPathConstraints()[index];
+					values.add(constraint.getMixRotate());
+					values.add(constraint.getMixX());
+					values.add(constraint.getMixY());
+					break;
+				}
+				case Property_Sequence:
+					values.add((float) slots[index]->getSequenceIndex());
+					break;
+				default:
+					// Events are not part of the pose.
+					continue;
+			}
+			pose._operations.add(type);
+			pose._operations.add(index);
+		}
+	}
+
+	if (_world) {
+		scratch.updateWorldTransform();
+		pose._world.setSize(bones.size() * 6, 0);
+		float *world = pose._world.buffer();
+		for (size_t i = 0, n = bones.size(); i < n; i++, world += 6) {
+			Bone &bone = *bones[i];
+			world[0] = bone._a;
+			world[1] = bone._b;
+			world[2] = bone._c;
+			world[3] = bone._d;
+			world[4] = bone._worldX;
+			world[5] = bone._worldY;
+		}
+	}
+
+	// The skin may be deleted before the next miss, so the scratch skeleton must not keep it or its attachments.
+	for (size_t i = 0, n = slots.size(); i < n; i++)
+		slots[i]->setAttachment(NULL);
+	scratch.setSkin(NULL);
+}
+
+void PoseCache::applyPose(Pose &pose, Skeleton &skeleton, bool world) {
+	Bone **bones = skeleton.getBones().buffer();
+	Slot **slots = skeleton.getSlots().buffer();
+	const int *operations = pose._operations.buffer();
+	const float *values = pose._values.buffer();
+	Attachment **attachments = pose._attachments.buffer();
+	for (size_t i = 0, n = pose._operations.size(); i < n; i += 2) {
+		int index = operations[i + 1];
+		switch (operations[i]) {
+			case Property_Rotate:
+				bones[index]->_rotation = *values++;
+				break;
+			case Property_X:
+				bones[index]->_x = *values++;
+				break;
+			case Property_Y:
+				bones[index]->_y = *values++;
+				break;
+			case Property_ScaleX:
+				bones[index]->_scaleX = *values++;
+				break;
+			case Property_ScaleY:
+				bones[index]->_scaleY = *values++;
+				break;
+			case Property_ShearX:
+				bones[index]->_shearX = *values++;
+				break;
+			case Property_ShearY:
+				bones[index]->_shearY = *values++;
+				break;
+			case Property_Rgb: {
+				Color &color = slots[index]->getColor();
+				color.r = values[0];
+				color.g = values[1];
+				color.b = values[2];
+				values += 3;
+				break;
+			}
+			case Property_Alpha:
+				slots[index]->getColor().a = *values++;
+				break;
+			case Property_Rgb2: {
+				Color &color = slots[index]->getDarkColor();
+				color.r = values[0];
+				color.g = values[1];
+				color.b = values[2];
+				values += 3;
+				break;
+			}
+			case Property_Attachment:
+				slots[index]->setAttachment(*attachments++);
+				break;
+			case Property_Deform: {
+				Slot &slot = *slots[index];
+				size_t count = (size_t) values[0];
+				// Like DeformTimeline, the deform applies only while the slot shows the attachment it was computed for.
+				if (slot.getAttachment() == *attachments++) {
+					Vector<float> &deform = slot.getDeform();
+					deform.setSize(count, 0);
+					if (count > 0) memcpy(deform.buffer(), values + 1, count * sizeof(float));
+				}
+				values += count + 1;
+				break;
+			}
+			case Property_DrawOrder: {
+				Slot **drawOrder = skeleton.getDrawOrder().buffer();
+				for (size_t ii = 0, nn = pose._drawOrder.size(); ii < nn; ii++)
+					drawOrder[ii] = slots[pose._drawOrder[ii]];
+				break;
+			}
+			case Property_IkConstraint: {
+				IkConstraint &constraint = *skeleton.getIkConstraints()[index];
+				constraint.setMix(values[0]);
+				constraint.setSoftness(values[1]);
+				constraint.setBendDirection((int) values[2]);
+				constraint.setCompress(values[3] != 0);
+				constraint.setStretch(values[4] != 0);
+				values += 5;
+				break;
+			}
+			case Property_TransformConstraint: {
+				TransformConstraint &constraint = *skeleton.getTransformConstraints()[index];
+				constraint.setMixRotate(values[0]);
+				constraint.setMixX(values[1]);
+				constraint.setMixY(values[2]);
+				constraint.setMixScaleX(values[3]);
+				constraint.setMixScaleY(values[4]);
+				constraint.setMixShearY(values[5]);
+				values += 6;
+				break;
+			}
+			case Property_PathConstraintPosition:
+				skeleton.getPathConstraints()[index]->setPosition(*values++);
+				break;
+			case Property_PathConstraintSpacing:
+				skeleton.getPathConstraints()[index]->setSpacing(*values++);
+				break;
+			case Property_PathConstraintMix: {
+				PathConstraint &constraint = *skeleton.getPathConstraints()[index];
+				constraint.setMixRotate(values[0]);
+				constraint.setMixX(values[1]);
+				constraint.setMixY(values[2]);
+				values += 3;
+				break;
+			}
+			case Property_Sequence:
+				slots[index]->setSequenceIndex((int) *values++);
+				break;
+		}
+	}
+
+	if (!world || pose._world.size() == 0) return;
+	// The world transforms were computed with the skeleton at the origin and unscaled.
+	float sx = skeleton.getScaleX(), sy = skeleton.getScaleY() * (Bone::isYDown() ? -1 : 1);
+	float x = skeleton.getX(), y = skeleton.getY();
+	const float *worldValues = pose._world.buffer();
+	for (size_t i = 0, n = skeleton.getBones().size(); i < n; i++, worldValues += 6) {
+		Bone &bone = *bones[i];
+		bone._a = worldValues[0] * sx;
+		bone._b = worldValues[1] * sx;
+		bone._c = worldValues[2] * sy;
+		bone._d = worldValues[3] * sy;
+		bone._worldX = worldValues[4] * sx + x;
+		bone._worldY = worldValues[5] * sy + y;
+	}
+	// The world transforms were set without updateWorldTransform(), so the tracker must compare them itself.
+	ChangeTracker *tracker = skeleton.getChangeTracker();
+	if (tracker) {
+		tracker->updateVersions(skeleton, true);
+		tracker->invalidate();
+	}
+}
@@ -50,6 +50,11 @@ RotateTimeline::RotateTimeline(size_t frameCount, size_t bezierCount, int boneIn
 
 void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						   MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void RotateTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+								 MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -70,7 +75,7 @@ void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		return;
 	}
 
-	float r = getCurveValue(time);
+	float r = getCurveValue(time, cursor);
 	switch (blend) {
 		case MixBlend_Setup:
 			bone->_rotation = bone->_data._rotation + r * alpha;
@@ -53,6 +53,11 @@ ScaleTimeline::~ScaleTimeline() {}
 
 void ScaleTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						  MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void ScaleTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+								MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 
@@ -75,7 +80,7 @@ void ScaleTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	}
 
 	float x, y;
-	int i = Animation::search(_frames, time, CurveTimeline2::ENTRIES);
+	int i = Animation::search(_frames, time, CurveTimeline2::ENTRIES, cursor);
 	int curveType = (int) _curves[i / CurveTimeline2::ENTRIES];
 	switch (curveType) {
 		case CurveTimeline::LINEAR: {
@@ -166,6 +171,11 @@ ScaleXTimeline::~ScaleXTimeline() {}
 
 void ScaleXTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						   MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void ScaleXTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+								 MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 
@@ -185,7 +195,7 @@ void ScaleXTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		return;
 	}
 
-	float x = getCurveValue(time) * bone->_data._scaleX;
+	float x = getCurveValue(time, cursor) * bone->_data._scaleX;
 	if (alpha == 1) {
 		if (blend == MixBlend_Add)
 			bone->_scaleX += x - bone->_data._scaleX;
@@ -239,6 +249,11 @@ ScaleYTimeline::~ScaleYTimeline() {}
 
 void ScaleYTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						   MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void ScaleYTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+								 MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 
@@ -258,7 +273,7 @@ void ScaleYTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		return;
 	}
 
-	float y = getCurveValue(time) * bone->_data._scaleY;
+	float y = getCurveValue(time, cursor) * bone->_data._scaleY;
 	if (alpha == 1) {
 		if (blend == MixBlend_Add)
 			bone->_scaleY += y - bone->_data._scaleY;
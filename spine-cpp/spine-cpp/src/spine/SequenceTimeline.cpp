@@ -63,6 +63,11 @@ void SequenceTimeline::setFrame(int frame, float time, SequenceMode mode, int in
 
 void SequenceTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
 							 float alpha, MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void SequenceTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
+								   float alpha, MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(alpha);
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -81,7 +86,7 @@ void SequenceTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vec
 		return;
 	}
 
-	int i = Animation::search(frames, time, ENTRIES);
+	int i = Animation::search(frames, time, ENTRIES, cursor);
 	float before = frames[i];
 	int modeAndIndex = (int) frames[i + MODE];
 	float delay = frames[i + DELAY];
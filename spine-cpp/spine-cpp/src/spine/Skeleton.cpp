@@ -31,9 +31,11 @@
 
 #include <spine/Attachment.h>
 #include <spine/Bone.h>
+#include <spine/ChangeTracker.h>
 #include <spine/IkConstraint.h>
 #include <spine/PathConstraint.h>
 #include <spine/SkeletonData.h>
+#include <spine/SkeletonPose.h>
 #include <spine/Skin.h>
 #include <spine/Slot.h>
 #include <spine/TransformConstraint.h>
@@ -59,7 +61,10 @@ Skeleton::Skeleton(SkeletonData *skeletonData) : _data(skeletonData),
 												 _scaleX(1),
 												 _scaleY(1),
 												 _x(0),
-												 _y(0) {
+												 _y(0),
+												 _pose(NULL),
+												 _changeTracker(NULL),
+												 _constraintOrderSerial(0) {
 	_bones.ensureCapacity(_data->getBones().size());
 	for (size_t i = 0; i < _data->getBones().size(); ++i) {
 		BoneData *data = _data->getBones()[i];
@@ -124,9 +129,19 @@ Skeleton::~Skeleton() {
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
+	delete _pose;
+	delete _changeTracker;
 }
 
 void Skeleton::updateCache() {
+	// A stored order is used only if the constraint order was not computed again since it was stored.
+	_constraintOrderSerial = _data->getConstraintOrder(_constraintOrder, _constraintsByOrder);
+	if (_skin && _skin->_updateOrderData == _data && _skin->_updateOrderSerial == _constraintOrderSerial &&
+		restoreUpdateOrder(*_skin)) {
+		if (_changeTracker) _changeTracker->build(*this);
+		return;
+	}
+
 	_updateCache.clear();
 
 	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
@@ -147,47 +162,164 @@ void Skeleton::updateCache() {
 		}
 	}
 
-	size_t ikCount = _ikConstraints.size();
-	size_t transformCount = _transformConstraints.size();
-	size_t pathCount = _pathConstraints.size();
+	// The constraints are sorted in the order precomputed by the skeleton data. The skin's constraints are marked by
+	// their order, so checking whether a constraint is in the skin doesn't search it.
+	Vector<int> &constraintOrder = _constraintOrder;
+	Vector<ConstraintData *> &constraintsByOrder = _constraintsByOrder;
+	_skinConstraints.setSize((constraintsByOrder.size() + 31) >> 5, 0);
+	for (size_t i = 0, n = _skinConstraints.size(); i < n; i++)
+		_skinConstraints[i] = 0;
+	if (_skin) {
+		Vector<ConstraintData *> &skinConstraints = _skin->_constraints;
+		for (size_t i = 0, n = skinConstraints.size(); i < n; i++) {
+			size_t order = skinConstraints[i]->getOrder();
+			if (order < constraintsByOrder.size() && constraintsByOrder[order] == skinConstraints[i])
+				_skinConstraints[order >> 5] |= 1u << (order & 31);
+		}
+	}
+	for (size_t i = 0, n = constraintOrder.size(); i < n; i += 2) {
+		int index = constraintOrder[i + 1];
+		switch (constraintOrder[i]) {
+			case SkeletonData::ConstraintIk:
+				sortIkConstraint(_ikConstraints[index]);
+				break;
+			case SkeletonData::ConstraintTransform:
+				sortTransformConstraint(_transformConstraints[index]);
+				break;
+			default:
+				sortPathConstraint(_pathConstraints[index]);
+		}
+	}
 
-	size_t constraintCount = ikCount + transformCount + pathCount;
+	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
+		sortBone(_bones[i]);
+	}
 
-	size_t i = 0;
-continue_outer:
-	for (; i < constraintCount; ++i) {
-		for (size_t ii = 0; ii < ikCount; ++ii) {
-			IkConstraint *constraint = _ikConstraints[ii];
-			if (constraint->getData().getOrder() == i) {
-				sortIkConstraint(constraint);
-				i++;
-				goto continue_outer;
-			}
-		}
+	updateProgram();
+	if (_changeTracker) _changeTracker->build(*this);
+}
 
-		for (size_t ii = 0; ii < transformCount; ++ii) {
-			TransformConstraint *constraint = _transformConstraints[ii];
-			if (constraint->getData().getOrder() == i) {
-				sortTransformConstraint(constraint);
-				i++;
-				goto continue_outer;
-			}
+void Skeleton::updateProgram() {
+	size_t n = _updateCache.size();
+	_updateProgram.clear();
+	_updateProgram.ensureCapacity(n * 2 + 2);
+	_updateProgramCache.clearAndAddAll(_updateCache);
+	int runStart = -1;
+	for (size_t i = 0; i < n; i++) {
+		Updatable *updatable = _updateCache[i];
+		const RTTI &rtti = updatable->getRTTI();
+		if (rtti.isExactly(Bone::rtti)) {
+			Bone *bone = static_cast<Bone *>(updatable);
+			int index = bone->_data.getIndex();
+			if (bone->_parent && bone->_data.getTransformMode() == TransformMode_Normal) {
+				if (runStart == -1) {
+					runStart = (int) _updateProgram.size();
+					_updateProgram.add(UpdateBoneRun);
+					_updateProgram.add(0);
+				}
+				_updateProgram[runStart + 1]++;
+			} else
+				runStart = -1;
+			_updateProgram.add(UpdateBone);
+			_updateProgram.add(index);
+			continue;
+		}
+		runStart = -1;
+		if (rtti.isExactly(IkConstraint::rtti)) {
+			_updateProgram.add(UpdateIkConstraint);
+			_updateProgram.add(_ikConstraints.indexOf(static_cast<IkConstraint *>(updatable)));
+		} else if (rtti.isExactly(TransformConstraint::rtti)) {
+			_updateProgram.add(UpdateTransformConstraint);
+			_updateProgram.add(_transformConstraints.indexOf(static_cast<TransformConstraint *>(updatable)));
+		} else if (rtti.isExactly(PathConstraint::rtti)) {
+			_updateProgram.add(UpdatePathConstraint);
+			_updateProgram.add(_pathConstraints.indexOf(static_cast<PathConstraint *>(updatable)));
+		} else {
+			_updateProgram.add(UpdateOther);
+			_updateProgram.add((int) i);
 		}
+	}
+}
 
-		for (size_t ii = 0; ii < pathCount; ++ii) {
-			PathConstraint *constraint = _pathConstraints[ii];
-			if (constraint->getData().getOrder() == i) {
-				sortPathConstraint(constraint);
-				i++;
-				goto continue_outer;
+void Skeleton::storeUpdateOrder(Skin &skin) {
+	for (size_t i = 0, n = _updateProgram.size(); i < n; i += 2)
+		if (_updateProgram[i] == UpdateOther) return;
+
+	skin._updateOrder.clearAndAddAll(_updateProgram);
+	Vector<bool> &active = skin._updateOrderActive;
+	active.clear();
+	active.ensureCapacity(_bones.size() + _ikConstraints.size() + _transformConstraints.size() + _pathConstraints.size());
+	for (size_t i = 0, n = _bones.size(); i < n; i++)
+		active.add(_bones[i]->_active);
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; i++)
+		active.add(_ikConstraints[i]->_active);
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; i++)
+		active.add(_transformConstraints[i]->_active);
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; i++)
+		active.add(_pathConstraints[i]->_active);
+	skin._updateOrderData = _data;
+	skin._updateOrderSerial = _constraintOrderSerial;
+}
+
+bool Skeleton::restoreUpdateOrder(Skin &skin) {
+	// The stored order sorted the bones of the path attachments in the skins, so a path constraint whose target slot
+	// shows any other path attachment must be sorted again.
+	Vector<bool> &active = skin._updateOrderActive;
+	size_t pathStart = active.size() - _pathConstraints.size();
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; i++) {
+		if (!active[pathStart + i]) continue;
+		Slot *slot = _pathConstraints[i]->_target;
+		Attachment *attachment = slot->_attachment;
+		if (attachment == NULL || !attachment->getRTTI().instanceOf(PathAttachment::rtti)) continue;
+		size_t slotIndex = slot->_data.getIndex();
+		bool found = false;
+		for (int ii = -1, nn = (int) _data->_skins.size(); ii < nn && !found; ii++) {
+			Vector<Skin::AttachmentMap::Entry> *entries = (ii == -1 ? &skin : _data->_skins[ii])->getSlotAttachments(slotIndex);
+			if (entries == NULL) continue;
+			for (size_t iii = 0, nnn = entries->size(); iii < nnn; iii++) {
+				if ((*entries)[iii]._attachment == attachment) {
+					found = true;
+					break;
+				}
 			}
 		}
+		if (!found) return false;
 	}
 
-	size_t n = _bones.size();
-	for (i = 0; i < n; ++i) {
-		sortBone(_bones[i]);
+	size_t activeIndex = 0;
+	for (size_t i = 0, n = _bones.size(); i < n; i++)
+		_bones[i]->_active = active[activeIndex++];
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; i++)
+		_ikConstraints[i]->_active = active[activeIndex++];
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; i++)
+		_transformConstraints[i]->_active = active[activeIndex++];
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; i++)
+		_pathConstraints[i]->_active = active[activeIndex++];
+
+	Vector<int> &program = skin._updateOrder;
+	_updateProgram.clearAndAddAll(program);
+	_updateCache.clear();
+	for (size_t i = 0, n = program.size(); i < n; i += 2) {
+		int index = program[i + 1];
+		switch (program[i]) {
+			case UpdateBone:
+				_updateCache.add(_bones[index]);
+				break;
+			case UpdateIkConstraint:
+				_updateCache.add(_ikConstraints[index]);
+				break;
+			case UpdateTransformConstraint:
+				_updateCache.add(_transformConstraints[index]);
+				break;
+			case UpdatePathConstraint:
+				_updateCache.add(_pathConstraints[index]);
+				break;
+			default:
+				break;
+		}
 	}
+	_updateProgramCache.clearAndAddAll(_updateCache);
+	return true;
 }
 
 void Skeleton::printUpdateCache() {
@@ -205,7 +337,24 @@ void Skeleton::printUpdateCache() {
 	}
 }
 
+void Skeleton::checkUpdateProgram() {
+	size_t n = _updateCache.size();
+	bool changed = n != _updateProgramCache.size();
+	Updatable **updateCache = _updateCache.buffer(), **programCache = _updateProgramCache.buffer();
+	for (size_t i = 0; i < n && !changed; i++)
+		changed = updateCache[i] != programCache[i];
+	if (!changed) return;
+	updateProgram();
+	if (_changeTracker) _changeTracker->build(*this);
+}
+
 void Skeleton::updateWorldTransform() {
+	checkUpdateProgram();
+	if (_changeTracker) {
+		_changeTracker->updateWorldTransform(*this);
+		return;
+	}
+
 	for (size_t i = 0, n = _bones.size(); i < n; i++) {
 		Bone *bone = _bones[i];
 		bone->_ax = bone->_x;
@@ -217,8 +366,66 @@ void Skeleton::updateWorldTransform() {
 		bone->_ashearY = bone->_shearY;
 	}
 
-	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
-		_updateCache[i]->update();
+	runUpdateProgram();
+}
+
+inline void Skeleton::updateNormalBone(Bone &bone) {
+	Bone &parent = *bone._parent;
+	float pa = parent._a, pb = parent._b, pc = parent._c, pd = parent._d;
+	float x = bone._ax, y = bone._ay;
+	bone._worldX = pa * x + pb * y + parent._worldX;
+	bone._worldY = pc * x + pd * y + parent._worldY;
+
+	float sinX, cosX, sinY, cosY;
+	MathUtil::sinCosDeg(bone._arotation + bone._ashearX, sinX, cosX);
+	MathUtil::sinCosDeg(bone._arotation + 90 + bone._ashearY, sinY, cosY);
+	float la = cosX * bone._ascaleX;
+	float lb = cosY * bone._ascaleY;
+	float lc = sinX * bone._ascaleX;
+	float ld = sinY * bone._ascaleY;
+	bone._a = pa * la + pb * lc;
+	bone._b = pa * lb + pb * ld;
+	bone._c = pc * la + pd * lc;
+	bone._d = pc * lb + pd * ld;
+}
+
+void Skeleton::runUpdateProgram() {
+	// The bones and constraints are updated by their concrete types, so the calls aren't virtual. Without a pose block,
+	// runs of bones use the scalar sinCosDeg(), not the array variant, so the results are the same as Bone::update().
+	Bone **bones = _bones.buffer();
+	const int *program = _updateProgram.buffer();
+	for (size_t i = 0, n = _updateProgram.size(); i < n; i += 2) {
+		int index = program[i + 1];
+		switch (program[i]) {
+			case UpdateBone: {
+				Bone &bone = *bones[index];
+				bone.updateWorldTransform(bone._ax, bone._ay, bone._arotation, bone._ascaleX, bone._ascaleY,
+										  bone._ashearX, bone._ashearY);
+				break;
+			}
+			case UpdateBoneRun: {
+				const int *run = program + i + 3;
+				if (_pose)
+					_pose->updateWorldTransforms(run, index);
+				else {
+					for (int ii = 0; ii < index; ii++, run += 2)
+						updateNormalBone(*bones[*run]);
+				}
+				i += index << 1;
+				break;
+			}
+			case UpdateIkConstraint:
+				_ikConstraints[index]->IkConstraint::update();
+				break;
+			case UpdateTransformConstraint:
+				_transformConstraints[index]->TransformConstraint::update();
+				break;
+			case UpdatePathConstraint:
+				_pathConstraints[index]->PathConstraint::update();
+				break;
+			default:
+				_updateCache[index]->update();
+		}
 	}
 }
 
@@ -245,6 +452,12 @@ void Skeleton::updateWorldTransform(Bone *parent) {
 		Updatable *updatable = _updateCache[i];
 		if (updatable != rb) updatable->update();
 	}
+
+	// The parent transform isn't tracked, so the next tracked update computes everything.
+	if (_changeTracker) {
+		_changeTracker->updateVersions(*this, true);
+		_changeTracker->invalidate();
+	}
 }
 
 void Skeleton::setToSetupPose() {
@@ -330,7 +543,7 @@ void Skeleton::setSkin(Skin *newSkin) {
 				Slot &slot = *slotP;
 				const String &name = slot._data.getAttachmentName();
 				if (name.length() > 0) {
-					Attachment *attachment = newSkin->getAttachment(i, name);
+					Attachment *attachment = newSkin->getAttachment(i, name, slot._data.getAttachmentNameHash());
 					if (attachment != NULL) {
 						slot.setAttachment(attachment);
 					}
@@ -349,15 +562,21 @@ Attachment *Skeleton::getAttachment(const String &slotName, const String &attach
 
 Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName) {
 	if (attachmentName.isEmpty()) return NULL;
+	return getAttachment(slotIndex, attachmentName, attachmentName.hash());
+}
+
+Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName, size_t hash) {
+	if (attachmentName.isEmpty()) return NULL;
 
 	if (_skin != NULL) {
-		Attachment *attachment = _skin->getAttachment(slotIndex, attachmentName);
+		Attachment *attachment = _skin->getAttachment(slotIndex, attachmentName, hash);
 		if (attachment != NULL) {
 			return attachment;
 		}
 	}
 
-	return _data->getDefaultSkin() != NULL ? _data->getDefaultSkin()->getAttachment(slotIndex, attachmentName) : NULL;
+	return _data->getDefaultSkin() != NULL ? _data->getDefaultSkin()->getAttachment(slotIndex, attachmentName, hash)
+										   : NULL;
 }
 
 void Skeleton::setAttachment(const String &slotName, const String &attachmentName) {
@@ -551,9 +770,38 @@ void Skeleton::setScaleY(float inValue) {
 	_scaleY = inValue;
 }
 
+void Skeleton::setUseSkeletonPose(bool inValue) {
+	if (inValue == (_pose != NULL)) return;
+	if (inValue) {
+		_pose = new (__FILE__, __LINE__) SkeletonPose(*this);
+	} else {
+		delete _pose;
+		_pose = NULL;
+	}
+}
+
+SkeletonPose *Skeleton::getSkeletonPose() {
+	return _pose;
+}
+
+void Skeleton::setUseChangeTracking(bool inValue) {
+	if (inValue == (_changeTracker != NULL)) return;
+	if (inValue) {
+		_changeTracker = new (__FILE__, __LINE__) ChangeTracker();
+		_changeTracker->build(*this);
+	} else {
+		delete _changeTracker;
+		_changeTracker = NULL;
+	}
+}
+
+ChangeTracker *Skeleton::getChangeTracker() {
+	return _changeTracker;
+}
+
 void Skeleton::sortIkConstraint(IkConstraint *constraint) {
-	constraint->_active = constraint->_target->_active && (!constraint->_data.isSkinRequired() ||
-														   (_skin && _skin->_constraints.contains(&constraint->_data)));
+	constraint->_active = constraint->_target->_active &&
+						  (!constraint->_data.isSkinRequired() || isSkinConstraint(constraint->_data));
 	if (!constraint->_active) return;
 
 	Bone *target = constraint->getTarget();
@@ -578,9 +826,8 @@ void Skeleton::sortIkConstraint(IkConstraint *constraint) {
 }
 
 void Skeleton::sortPathConstraint(PathConstraint *constraint) {
-	constraint->_active = constraint->_target->_bone._active && (!constraint->_data.isSkinRequired() || (_skin &&
-																										 _skin->_constraints.contains(
-																												 &constraint->_data)));
+	constraint->_active = constraint->_target->_bone._active &&
+						  (!constraint->_data.isSkinRequired() || isSkinConstraint(constraint->_data));
 	if (!constraint->_active) return;
 
 	Slot *slot = constraint->getTarget();
@@ -611,8 +858,8 @@ void Skeleton::sortPathConstraint(PathConstraint *constraint) {
 }
 
 void Skeleton::sortTransformConstraint(TransformConstraint *constraint) {
-	constraint->_active = constraint->_target->_active && (!constraint->_data.isSkinRequired() ||
-														   (_skin && _skin->_constraints.contains(&constraint->_data)));
+	constraint->_active = constraint->_target->_active &&
+						  (!constraint->_data.isSkinRequired() || isSkinConstraint(constraint->_data));
 	if (!constraint->_active) return;
 
 	sortBone(constraint->getTarget());
@@ -640,15 +887,15 @@ void Skeleton::sortTransformConstraint(TransformConstraint *constraint) {
 }
 
 void Skeleton::sortPathConstraintAttachment(Skin *skin, size_t slotIndex, Bone &slotBone) {
-	Skin::AttachmentMap::Entries attachments = skin->getAttachments();
+	Vector<Skin::AttachmentMap::Entry> *attachments = skin->getSlotAttachments(slotIndex);
+	if (!attachments) return;
+	for (size_t i = 0, n = attachments->size(); i < n; i++)
+		sortPathConstraintAttachment((*attachments)[i]._attachment, slotBone);
+}
 
-	while (attachments.hasNext()) {
-		Skin::AttachmentMap::Entry entry = attachments.next();
-		if (entry._slotIndex == slotIndex) {
-			Attachment *value = entry._attachment;
-			sortPathConstraintAttachment(value, slotBone);
-		}
-	}
+bool Skeleton::isSkinConstraint(ConstraintData &data) {
+	size_t order = data.getOrder();
+	return (order >> 5) < _skinConstraints.size() && (_skinConstraints[order >> 5] & (1u << (order & 31))) != 0;
 }
 
 void Skeleton::sortPathConstraintAttachment(Attachment *attachment, Bone &slotBone) {
@@ -30,6 +30,7 @@
 #include <spine/SkeletonBinary.h>
 
 #include <spine/Animation.h>
+#include <spine/AnimationLoader.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
@@ -71,21 +72,169 @@
 #include <spine/SequenceTimeline.h>
 #include <spine/Version.h>
 
+#include <new>
+
+#ifndef SPINE_NO_THREADS
+#include <atomic>
+#include <mutex>
+#endif
+
 using namespace spine;
 
+#ifndef SPINE_NO_THREADS
+typedef std::atomic<bool> LoadedFlag;
+#define SPINE_LOADER_LOCK() std::lock_guard<std::mutex> lock(_mutex)
+#else
+typedef bool LoadedFlag;
+#define SPINE_LOADER_LOCK()
+#endif
+
+namespace spine {
+	/// Decodes the animations of a skeleton binary on first use, from the bytes following each animation's name.
+	class BinaryAnimationLoader : public AnimationLoader {
+	public:
+		BinaryAnimationLoader(SkeletonData *skeletonData, const unsigned char *binary, size_t length,
+							  Vector<size_t> &offsets, float scale, bool compress, bool copy)
+			: _skeletonData(skeletonData), _length(length), _offsets(offsets), _ownsBinary(copy) {
+			_decoder._scale = scale;
+			_decoder._compressAnimations = compress;
+			if (copy) {
+				unsigned char *data = SpineExtension::alloc<unsigned char>(length, __FILE__, __LINE__);
+				memcpy(data, binary, length);
+				binary = data;
+			}
+			_binary = binary;
+			_loaded = SpineExtension::calloc<LoadedFlag>(offsets.size(), __FILE__, __LINE__);
+			for (size_t i = 0; i < offsets.size(); i++) {
+				new (_loaded + i) LoadedFlag(false);
+				Animation *animation = skeletonData->getAnimations()[i];
+				animation->_loader = this;
+				animation->_loaderIndex = (int) i;
+			}
+		}
+
+		virtual ~BinaryAnimationLoader() {
+			SpineExtension::free(_loaded, __FILE__, __LINE__);
+			if (_ownsBinary) SpineExtension::free(_binary, __FILE__, __LINE__);
+		}
+
+		virtual bool load(Animation &animation, int index) override {
+			if (isLoaded(index)) return true;
+			SPINE_LOADER_LOCK();
+			if (isLoaded(index)) return true;
+
+			// Timelines are allocated outside of any arena, so they can be evicted.
+			Arena *arena = Arena::setCurrent(NULL);
+			Vector<Timeline *> timelines;
+			SkeletonBinary::DataInput input;
+			input.cursor = _binary + _offsets[index];
+			input.end = _binary + _length;
+			input.inPlace = false;
+			if (!_decoder.readTimelines(&input, _skeletonData, timelines)) {
+				Arena::setCurrent(arena);
+				_error = _decoder.getError();
+				return false;
+			}
+			float duration = 0;
+			for (size_t i = 0; i < timelines.size(); i++)
+				duration = MathUtil::max(duration, timelines[i]->getDuration());
+			animation.setTimelines(timelines, duration);
+			animation.computePropertyIndices(*_skeletonData);
+			Arena::setCurrent(arena);
+#ifndef SPINE_NO_THREADS
+			_loaded[index].store(true, std::memory_order_release);
+#else
+			_loaded[index] = true;
+#endif
+			return true;
+		}
+
+		virtual void evict(Animation &animation, int index) override {
+			SPINE_LOADER_LOCK();
+			if (!isLoaded(index)) return;
+			ContainerUtil::cleanUpVectorOfPointers(animation._timelines);
+			animation._timelineIds.clear();
+			animation._timelineTypes.clear();
+			animation._propertyIndices.clear();
+			animation._propertyOffsets.clear();
+			animation._propertyBits.clear();
+			animation._propertySkeletonData = NULL;
+			animation._duration = 0;
+#ifndef SPINE_NO_THREADS
+			_loaded[index].store(false, std::memory_order_relaxed);
+#else
+			_loaded[index] = false;
+#endif
+		}
+
+		virtual String getError() override {
+			SPINE_LOADER_LOCK();
+			return _error;
+		}
+
+		virtual bool isLoaded(int index) override {
+#ifndef SPINE_NO_THREADS
+			return _loaded[index].load(std::memory_order_acquire);
+#else
+			return _loaded[index];
+#endif
+		}
+
+	private:
+		SkeletonBinary _decoder;
+		String _error;
+		SkeletonData *_skeletonData;
+		const unsigned char *_binary;
+		size_t _length;
+		Vector<size_t> _offsets;
+		LoadedFlag *_loaded;
+		bool _ownsBinary;
+#ifndef SPINE_NO_THREADS
+		std::mutex _mutex;
+#endif
+	};
+}
+
+namespace {
+	void unmapFile(void *data, size_t length) {
+		SpineExtension::unmapFile((char *) data, (int) length);
+	}
+
+	inline float decodeFloat(const unsigned char *bytes) {
+		union {
+			unsigned int intValue;
+			float floatValue;
+		} intToFloat;
+		intToFloat.intValue = ((unsigned int) bytes[0] << 24) | ((unsigned int) bytes[1] << 16) |
+							  ((unsigned int) bytes[2] << 8) | bytes[3];
+		return intToFloat.floatValue;
+	}
+}
+
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
 															new (__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)),
-													_error(), _scale(1), _ownsLoader(true) {
+													_error(), _scale(1), _ownsLoader(true), _useArena(false),
+													_useMappedFile(false), _lazyAnimations(false), _skinningLayout(false),
+													_compressAnimations(false) {
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(
 																							  attachmentLoader),
 																					  _error(),
 																					  _scale(1),
-																					  _ownsLoader(ownsLoader) {
+																					  _ownsLoader(ownsLoader),
+																					  _useArena(false),
+																					  _useMappedFile(false),
+																					  _lazyAnimations(false), _skinningLayout(false),
+																					  _compressAnimations(false) {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonBinary::SkeletonBinary() : _attachmentLoader(NULL), _error(), _scale(1), _ownsLoader(false), _useArena(false),
+								   _useMappedFile(false), _lazyAnimations(false), _skinningLayout(false),
+								   _compressAnimations(false) {
+}
+
 SkeletonBinary::~SkeletonBinary() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 	_linkedMeshes.clear();
@@ -94,16 +243,50 @@ SkeletonBinary::~SkeletonBinary() {
 }
 
 SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, const int length) {
+	return readSkeletonData(binary, length, false);
+}
+
+SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, int length, bool mapped) {
+	if (!_useArena && !mapped) return loadSkeletonData(binary, length, false);
+
+	Arena *previous = Arena::setCurrent(NULL);
+	Arena *arena = new (__FILE__, __LINE__) Arena();
+	// The arena owns the mapping, so strings used in place are never freed and live as long as the SkeletonData. Only the
+	// current arena ignores frees, so a mapped file is always loaded into the arena.
+	if (mapped) arena->adopt((void *) binary, (size_t) length, unmapFile);
+	Arena::setCurrent(arena);
+	SkeletonData *skeletonData = loadSkeletonData(binary, length, mapped);
+
+	// Loader state is freed into the arena while it is current, and the error that outlives it is moved out of it.
+	if (!skeletonData) ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
+	Arena *loading = Arena::setCurrent(previous);
+	String error(_error);
+	Arena::setCurrent(loading);
+	_error.own(error);
+	Arena::setCurrent(previous);
+
+	if (skeletonData)
+		skeletonData->_arena.arena = arena;
+	else
+		delete arena;
+	return skeletonData;
+}
+
+SkeletonData *SkeletonBinary::loadSkeletonData(const unsigned char *binary, const int length, bool inPlace) {
 	bool nonessential;
 	SkeletonData *skeletonData;
 
 	DataInput *input = new (__FILE__, __LINE__) DataInput();
 	input->cursor = binary;
 	input->end = binary + length;
+	input->inPlace = inPlace;
 
 	_linkedMeshes.clear();
 
+	// The skeleton data is allocated outside the arena, which it owns.
+	Arena *arena = Arena::setCurrent(NULL);
 	skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	Arena::setCurrent(arena);
 
 	char buffer[16] = {0};
 	int lowHash = readInt(input);
@@ -122,6 +305,8 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		char errorMsg[255];
 		sprintf(errorMsg, "Skeleton version %s does not match runtime version %s", skeletonData->_version.buffer(), SPINE_VERSION_STRING);
 		setError(errorMsg, "");
+		delete input;
+		delete skeletonData;
 		return NULL;
 	}
 
@@ -183,6 +368,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 			slotData->setHasDarkColor(true);
 		}
 		slotData->_attachmentName = readStringRef(input, skeletonData);
+		slotData->_attachmentNameHash = slotData->_attachmentName.hash();
 		slotData->_blendMode = static_cast<BlendMode>(readVarint(input, true));
 		skeletonData->_slots[i] = slotData;
 	}
@@ -332,6 +518,27 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	/* Animations. */
 	int animationsCount = readVarint(input, true);
 	skeletonData->_animations.setSize(animationsCount, 0);
+	if (_lazyAnimations) {
+		// Only the names are read. The timelines are decoded on first use, starting at the offsets recorded here.
+		const unsigned char *start = input->cursor;
+		Vector<size_t> offsets;
+		offsets.ensureCapacity(animationsCount);
+		for (int i = 0; i < animationsCount; ++i) {
+			String name(readString(input), true);
+			Vector<Timeline *> timelines;
+			skeletonData->_animations[i] = new (__FILE__, __LINE__) Animation(name, timelines, 0);
+			offsets.add((size_t) (input->cursor - start));
+			if (!skipAnimation(input, skeletonData)) {
+				delete input;
+				delete skeletonData;
+				return NULL;
+			}
+		}
+		skeletonData->_animationLoader = new (__FILE__, __LINE__) BinaryAnimationLoader(
+				skeletonData, start, (size_t) (input->cursor - start), offsets, _scale, _compressAnimations, !inPlace);
+		delete input;
+		return skeletonData;
+	}
 	for (int i = 0; i < animationsCount; ++i) {
 		String name(readString(input), true);
 		Animation *animation = readAnimation(name, input, skeletonData);
@@ -348,8 +555,12 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 }
 
 SkeletonData *SkeletonBinary::readSkeletonDataFile(const String &path) {
-	int length;
+	int length = 0;
 	SkeletonData *skeletonData;
+	if (_useMappedFile) {
+		char *mapping = SpineExtension::mapFile(path, &length);
+		if (mapping) return readSkeletonData((unsigned char *) mapping, length, true);
+	}
 	const char *binary = SpineExtension::readFile(path.buffer(), &length);
 	if (length == 0 || !binary) {
 		setError("Unable to read skeleton file: ", path.buffer());
@@ -370,9 +581,17 @@ void SkeletonBinary::setError(const char *value1, const char *value2) {
 }
 
 char *SkeletonBinary::readString(DataInput *input) {
+	unsigned char *start = (unsigned char *) input->cursor;
 	int length = readVarint(input, true);
 	char *string;
 	if (length == 0) return NULL;
+	if (input->inPlace) {
+		// Moving the characters over the length, which takes at least one byte, leaves room for the terminator.
+		memmove(start, input->cursor, length - 1);
+		start[length - 1] = '\0';
+		input->cursor += length - 1;
+		return (char *) start;
+	}
 	string = SpineExtension::alloc<char>(length, __FILE__, __LINE__);
 	memcpy(string, input->cursor, length - 1);
 	input->cursor += length - 1;
@@ -386,12 +605,21 @@ char *SkeletonBinary::readStringRef(DataInput *input, SkeletonData *skeletonData
 }
 
 float SkeletonBinary::readFloat(DataInput *input) {
-	union {
-		int intValue;
-		float floatValue;
-	} intToFloat;
-	intToFloat.intValue = readInt(input);
-	return intToFloat.floatValue;
+	float value = decodeFloat(input->cursor);
+	input->cursor += 4;
+	return value;
+}
+
+void SkeletonBinary::readFloats(DataInput *input, float *values, int n, float scale) {
+	const unsigned char *bytes = input->cursor;
+	if (scale == 1) {
+		for (int i = 0; i < n; ++i)
+			values[i] = decodeFloat(bytes + (i << 2));
+	} else {
+		for (int i = 0; i < n; ++i)
+			values[i] = decodeFloat(bytes + (i << 2)) * scale;
+	}
+	input->cursor += n << 2;
 }
 
 unsigned char SkeletonBinary::readByte(DataInput *input) {
@@ -596,6 +824,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			mesh->_bones.addAll(bones);
 			mesh->_vertices.addAll(vertices);
 			mesh->setWorldVerticesLength(vertexCount << 1);
+			if (_skinningLayout) mesh->buildSkinningLayout();
 			mesh->_triangles.addAll(triangles);
 			mesh->_regionUVs.addAll(uvs);
 			if (sequence == NULL) mesh->updateRegion();
@@ -640,7 +869,9 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 
 			LinkedMesh *linkedMesh = new (__FILE__, __LINE__) LinkedMesh(mesh, String(skinName), slotIndex,
 																		 String(parent), inheritTimelines);
+			Arena *arena = Arena::setCurrent(NULL);
 			_linkedMeshes.add(linkedMesh);
+			Arena::setCurrent(arena);
 			return mesh;
 		}
 		case AttachmentType_Path: {
@@ -728,17 +959,7 @@ void SkeletonBinary::readVertices(DataInput *input, Vector<float> &vertices, Vec
 
 void SkeletonBinary::readFloatArray(DataInput *input, int n, float scale, Vector<float> &array) {
 	array.setSize(n, 0);
-
-	int i;
-	if (scale == 1) {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input);
-		}
-	} else {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input) * scale;
-		}
-	}
+	readFloats(input, array.buffer(), n, scale);
 }
 
 void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &array) {
@@ -755,11 +976,10 @@ void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &ar
 void SkeletonBinary::setBezier(DataInput *input, CurveTimeline *timeline, int bezier, int frame, int value, float time1,
 							   float time2,
 							   float value1, float value2, float scale) {
-	float cx1 = readFloat(input);
-	float cy1 = readFloat(input);
-	float cx2 = readFloat(input);
-	float cy2 = readFloat(input);
-	timeline->setBezier(bezier, frame, value, time1, value1, cx1, cy1 * scale, cx2, cy2 * scale, time2, value2);
+	float curve[4];
+	readFloats(input, curve, 4, 1);
+	timeline->setBezier(bezier, frame, value, time1, value1, curve[0], curve[1] * scale, curve[2], curve[3] * scale,
+						time2, value2);
 }
 
 Timeline *SkeletonBinary::readTimeline(DataInput *input, CurveTimeline1 *timeline, float scale) {
@@ -810,6 +1030,17 @@ Timeline *SkeletonBinary::readTimeline2(DataInput *input, CurveTimeline2 *timeli
 
 Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData) {
 	Vector<Timeline *> timelines;
+	if (!readTimelines(input, skeletonData, timelines)) return NULL;
+	float duration = 0;
+	for (int i = 0, n = (int) timelines.size(); i < n; i++) {
+		duration = MathUtil::max(duration, (timelines[i])->getDuration());
+	}
+	Animation *animation = new (__FILE__, __LINE__) Animation(String(name), timelines, duration);
+	animation->indexProperties(*skeletonData);
+	return animation;
+}
+
+bool SkeletonBinary::readTimelines(DataInput *input, SkeletonData *skeletonData, Vector<Timeline *> &timelines) {
 	float scale = _scale;
 	int numTimelines = readVarint(input, true);
 	SP_UNUSED(numTimelines);
@@ -1027,7 +1258,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
-					return NULL;
+					return false;
 				}
 			}
 		}
@@ -1089,7 +1320,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
-					return NULL;
+					return false;
 				}
 			}
 			timelines.add(timeline);
@@ -1247,7 +1478,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				if (!baseAttachment) {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Attachment not found: ", attachmentName);
-					return NULL;
+					return false;
 				}
 				VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
 				unsigned int timelineType = readByte(input);
@@ -1279,14 +1510,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 							} else {
 								deform.setSize(deformLength, 0);
 								size_t start = (size_t) readVarint(input, true);
-								end += start;
-								if (scale == 1) {
-									for (size_t v = start; v < end; ++v)
-										deform[v] = readFloat(input);
-								} else {
-									for (size_t v = start; v < end; ++v)
-										deform[v] = readFloat(input) * scale;
-								}
+								readFloats(input, deform.buffer() + start, (int) end, scale);
 
 								if (!weighted) {
 									for (size_t v = 0, vn = deform.size(); v < vn; ++v)
@@ -1393,9 +1617,173 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 		timelines.add(timeline);
 	}
 
-	float duration = 0;
-	for (int i = 0, n = (int) timelines.size(); i < n; i++) {
-		duration = MathUtil::max(duration, (timelines[i])->getDuration());
+	if (_compressAnimations) {
+		for (size_t i = 0; i < timelines.size(); i++)
+			timelines[i]->compress();
+	}
+	return true;
+}
+
+void SkeletonBinary::skipCurveTimeline(DataInput *input, int frameCount, int frameSize, int curveCount) {
+	input->cursor += frameSize;
+	for (int frame = 1; frame < frameCount; frame++) {
+		input->cursor += frameSize;
+		if (readSByte(input) == CURVE_BEZIER) input->cursor += curveCount << 4;
+	}
+}
+
+bool SkeletonBinary::skipAnimation(DataInput *input, SkeletonData *skeletonData) {
+	readVarint(input, true);
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int slotIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == SLOT_ATTACHMENT) {
+				for (int frame = 0; frame < frameCount; ++frame) {
+					input->cursor += 4;
+					readVarint(input, true);
+				}
+				continue;
+			}
+			readVarint(input, true);
+			switch (timelineType) {
+				case SLOT_RGBA:
+					skipCurveTimeline(input, frameCount, 8, 4);
+					break;
+				case SLOT_RGB:
+					skipCurveTimeline(input, frameCount, 7, 3);
+					break;
+				case SLOT_RGBA2:
+					skipCurveTimeline(input, frameCount, 11, 7);
+					break;
+				case SLOT_RGB2:
+					skipCurveTimeline(input, frameCount, 10, 6);
+					break;
+				case SLOT_ALPHA:
+					skipCurveTimeline(input, frameCount, 5, 1);
+					break;
+				default:
+					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
+					return false;
+			}
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int boneIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			readVarint(input, true);
+			switch (timelineType) {
+				case BONE_ROTATE:
+				case BONE_TRANSLATEX:
+				case BONE_TRANSLATEY:
+				case BONE_SCALEX:
+				case BONE_SCALEY:
+				case BONE_SHEARX:
+				case BONE_SHEARY:
+					skipCurveTimeline(input, frameCount, 8, 1);
+					break;
+				case BONE_TRANSLATE:
+				case BONE_SCALE:
+				case BONE_SHEAR:
+					skipCurveTimeline(input, frameCount, 12, 2);
+					break;
+				default:
+					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
+					return false;
+			}
+		}
+	}
+
+	// IK timelines, where each frame ends with its bend direction, compress and stretch.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		input->cursor += 12;
+		for (int frame = 0;; frame++) {
+			input->cursor += 3;
+			if (frame == frameCount - 1) break;
+			input->cursor += 12;
+			if (readSByte(input) == CURVE_BEZIER) input->cursor += 32;
+		}
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		skipCurveTimeline(input, frameCount, 28, 6);
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int type = readSByte(input);
+			int frameCount = readVarint(input, true);
+			readVarint(input, true);
+			if (type == PATH_MIX)
+				skipCurveTimeline(input, frameCount, 16, 3);
+			else
+				skipCurveTimeline(input, frameCount, 8, 1);
+		}
+	}
+
+	// Deform timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				readVarint(input, true);
+				unsigned int timelineType = readByte(input);
+				int frameCount = readVarint(input, true);
+				if (timelineType == ATTACHMENT_DEFORM) {
+					readVarint(input, true);
+					input->cursor += 4;
+					for (int frame = 0;; ++frame) {
+						int end = readVarint(input, true);
+						if (end != 0) {
+							readVarint(input, true);
+							input->cursor += end << 2;
+						}
+						if (frame == frameCount - 1) break;
+						input->cursor += 4;
+						if (readSByte(input) == CURVE_BEZIER) input->cursor += 16;
+					}
+				} else if (timelineType == ATTACHMENT_SEQUENCE)
+					input->cursor += frameCount * 12;
+			}
+		}
+	}
+
+	// Draw order timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		input->cursor += 4;
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			readVarint(input, true);
+		}
+	}
+
+	// Event timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		input->cursor += 4;
+		EventData *eventData = skeletonData->_events[readVarint(input, true)];
+		readVarint(input, false);
+		input->cursor += 4;
+		if (readBoolean(input)) {
+			int length = readVarint(input, true);
+			if (length > 0) input->cursor += length - 1;
+		}
+		if (!eventData->_audioPath.isEmpty()) input->cursor += 8;
 	}
-	return new (__FILE__, __LINE__) Animation(String(name), timelines, duration);
+	return true;
 }
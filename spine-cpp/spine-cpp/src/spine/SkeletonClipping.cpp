@@ -29,18 +29,38 @@
 
 #include <spine/SkeletonClipping.h>
 
+#include <spine/Bone.h>
 #include <spine/ClippingAttachment.h>
+#include <spine/ContainerUtil.h>
 #include <spine/Slot.h>
 
 using namespace spine;
 
-SkeletonClipping::SkeletonClipping() : _clipAttachment(NULL) {
+namespace spine {
+	/// The convex decomposition of the vertices of a clipping attachment. Each polygon is clockwise and repeats its first
+	/// vertex at the end. It is rebuilt if the vertices differ from the ones it was built from, which also covers an
+	/// attachment deleted and another allocated at its address.
+	class SkeletonClipping::Convex : public SpineObject {
+	public:
+		Vector<float> _vertices;
+		Vector<Vector<float> > _polygons;
+	};
+}
+
+SkeletonClipping::SkeletonClipping() : _clipAttachment(NULL), _clippingRectangle(false) {
 	_clipOutput.ensureCapacity(128);
 	_clippedVertices.ensureCapacity(128);
 	_clippedTriangles.ensureCapacity(128);
 	_clippedUVs.ensureCapacity(128);
 }
 
+SkeletonClipping::~SkeletonClipping() {
+	ContainerUtil::cleanUpVectorOfPointers(_transformedPolygonPool);
+	HashMap<long long, Convex *>::Entries entries = _convexes.getEntries();
+	while (entries.hasNext())
+		delete entries.next().value;
+}
+
 size_t SkeletonClipping::clipStart(Slot &slot, ClippingAttachment *clip) {
 	if (_clipAttachment != NULL) {
 		return 0;
@@ -48,23 +68,127 @@ size_t SkeletonClipping::clipStart(Slot &slot, ClippingAttachment *clip) {
 
 	_clipAttachment = clip;
 
-	int n = (int) clip->getWorldVerticesLength();
-	_clippingPolygon.setSize(n, 0);
-	clip->computeWorldVertices(slot, 0, n, _clippingPolygon, 0, 2);
-	makeClockwise(_clippingPolygon);
-	_clippingPolygons = &_triangulator.decompose(_clippingPolygon, _triangulator.triangulate(_clippingPolygon));
-
-	for (size_t i = 0; i < _clippingPolygons->size(); ++i) {
-		Vector<float> *polygonP = (*_clippingPolygons)[i];
-		Vector<float> &polygon = *polygonP;
-		makeClockwise(polygon);
-		polygon.add(polygon[0]);
-		polygon.add(polygon[1]);
+	if (!transformConvexPolygons(slot, clip)) {
+		int n = (int) clip->getWorldVerticesLength();
+		_clippingPolygon.setSize(n, 0);
+		clip->computeWorldVertices(slot, 0, n, _clippingPolygon, 0, 2);
+		makeClockwise(_clippingPolygon);
+		_clippingPolygons = &_triangulator.decompose(_clippingPolygon, _triangulator.triangulate(_clippingPolygon));
+
+		for (size_t i = 0; i < _clippingPolygons->size(); ++i) {
+			Vector<float> *polygonP = (*_clippingPolygons)[i];
+			Vector<float> &polygon = *polygonP;
+			makeClockwise(polygon);
+			polygon.add(polygon[0]);
+			polygon.add(polygon[1]);
+		}
 	}
+	updateClippingBounds();
 
 	return (*_clippingPolygons).size();
 }
 
+void SkeletonClipping::updateClippingBounds() {
+	Vector<Vector<float> *> &polygons = *_clippingPolygons;
+	size_t polygonsCount = polygons.size();
+	_clippingBounds.setSize(polygonsCount << 2, 0);
+	for (size_t p = 0; p < polygonsCount; p++) {
+		Vector<float> &polygon = *polygons[p];
+		float minX = polygon[0], minY = polygon[1], maxX = minX, maxY = minY;
+		for (size_t i = 2, n = polygon.size(); i < n; i += 2) {
+			float x = polygon[i], y = polygon[i + 1];
+			if (x < minX) minX = x;
+			else if (x > maxX)
+				maxX = x;
+			if (y < minY) minY = y;
+			else if (y > maxY)
+				maxY = y;
+		}
+		float *bounds = &_clippingBounds[p << 2];
+		bounds[0] = minX;
+		bounds[1] = minY;
+		bounds[2] = maxX;
+		bounds[3] = maxY;
+	}
+
+	// A single polygon of 4 vertices with axis aligned edges, which repeats its first vertex at the end.
+	_clippingRectangle = false;
+	if (polygonsCount == 1 && polygons[0]->size() == 10) {
+		Vector<float> &polygon = *polygons[0];
+		_clippingRectangle = true;
+		for (size_t i = 0; i < 8; i += 2) {
+			if (polygon[i] != polygon[i + 2] && polygon[i + 1] != polygon[i + 3]) {
+				_clippingRectangle = false;
+				break;
+			}
+		}
+	}
+}
+
+bool SkeletonClipping::transformConvexPolygons(Slot &slot, ClippingAttachment *clip) {
+	// An affine transform keeps a convex decomposition convex, so the cached one can be used unless the vertices are
+	// weighted or deformed, which changes the shape.
+	if (clip->getBones().size() > 0 || slot.getDeform().size() > 0) return false;
+	Bone &bone = slot.getBone();
+	float a = bone.getA(), b = bone.getB(), c = bone.getC(), d = bone.getD();
+	float determinant = a * d - b * c;
+	if (determinant == 0) return false;
+
+	long long key = (long long) (size_t) clip;
+	Convex *convex;
+	if (_convexes.containsKey(key))
+		convex = _convexes[key];
+	else {
+		convex = new (__FILE__, __LINE__) Convex();
+		_convexes.put(key, convex);
+	}
+	Vector<float> &vertices = clip->getVertices();
+	Vector<float> &convexVertices = convex->_vertices;
+	bool valid = vertices.size() == convexVertices.size() && vertices.size() > 0;
+	for (size_t i = 0, n = convexVertices.size(); valid && i < n; i++)
+		valid = vertices[i] == convexVertices[i];
+	if (!valid) {
+		convexVertices.clearAndAddAll(vertices);
+		_clippingPolygon.clearAndAddAll(vertices);
+		makeClockwise(_clippingPolygon);
+		Vector<Vector<float> *> &polygons = _triangulator.decompose(_clippingPolygon,
+																	  _triangulator.triangulate(_clippingPolygon));
+		Vector<Vector<float> > &convexPolygons = convex->_polygons;
+		convexPolygons.clear();
+		for (size_t i = 0; i < polygons.size(); ++i) {
+			Vector<float> &polygon = *polygons[i];
+			makeClockwise(polygon);
+			polygon.add(polygon[0]);
+			polygon.add(polygon[1]);
+			convexPolygons.add(polygon);
+		}
+	}
+
+	// Mirroring turns the clockwise polygons counterclockwise, so their vertices are reversed.
+	bool reverse = determinant < 0;
+	float worldX = bone.getWorldX(), worldY = bone.getWorldY();
+	Vector<Vector<float> > &convexPolygons = convex->_polygons;
+	size_t polygonsCount = convexPolygons.size();
+	for (size_t i = _transformedPolygonPool.size(); i < polygonsCount; ++i)
+		_transformedPolygonPool.add(new (__FILE__, __LINE__) Vector<float>());
+	_transformedPolygons.clear();
+	for (size_t i = 0; i < polygonsCount; ++i) {
+		Vector<float> &polygon = convexPolygons[i];
+		Vector<float> &transformed = *_transformedPolygonPool[i];
+		_transformedPolygons.add(&transformed);
+		size_t n = polygon.size();
+		transformed.setSize(n, 0);
+		for (size_t ii = 0; ii < n; ii += 2) {
+			float x = polygon[ii], y = polygon[ii + 1];
+			size_t index = reverse ? n - 2 - ii : ii;
+			transformed[index] = x * a + y * b + worldX;
+			transformed[index + 1] = x * c + y * d + worldY;
+		}
+	}
+	_clippingPolygons = &_transformedPolygons;
+	return true;
+}
+
 void SkeletonClipping::clipEnd(Slot &slot) {
 	if (_clipAttachment != NULL && _clipAttachment->_endSlot == &slot._data) {
 		clipEnd();
@@ -87,6 +211,54 @@ void SkeletonClipping::clipTriangles(Vector<float> &vertices, Vector<unsigned sh
 	clipTriangles(vertices.buffer(), triangles.buffer(), triangles.size(), uvs.buffer(), stride);
 }
 
+namespace {
+	/// Grows a buffer written through a cursor rather than added to, returning where to write count more items.
+	template<typename T>
+	inline T *reserve(Vector<T> &buffer, size_t used, size_t count) {
+		if (used + count > buffer.size()) buffer.setSize(MathUtil::max(buffer.size() << 1, used + count), 0);
+		return buffer.buffer() + used;
+	}
+
+	/// Returns 1 if the triangle is inside all edges of the convex, clockwise polygon, -1 if it is outside any edge and 0
+	/// if it crosses the polygon. Uses the same test for a point being inside an edge as SkeletonClipping::clip().
+	inline int classifyTriangle(float x1, float y1, float x2, float y2, float x3, float y3, Vector<float> &polygon) {
+		int result = 1;
+		for (size_t i = 0, n = polygon.size() - 2; i < n; i += 2) {
+			float edgeX2 = polygon[i + 2], edgeY2 = polygon[i + 3];
+			float deltaX = polygon[i] - edgeX2, deltaY = polygon[i + 1] - edgeY2;
+			int inside = (deltaX * (y1 - edgeY2) - deltaY * (x1 - edgeX2) > 0) +
+						 (deltaX * (y2 - edgeY2) - deltaY * (x2 - edgeX2) > 0) +
+						 (deltaX * (y3 - edgeY2) - deltaY * (x3 - edgeX2) > 0);
+			if (inside == 0) return -1;
+			if (inside != 3) result = 0;
+		}
+		return result;
+	}
+
+	/// Clips a polygon against one side of an axis aligned rectangle. Keeps the vertices whose coordinate on the axis is
+	/// greater than the value, or less if sign is -1. Returns the number of vertices written to output.
+	inline int clipSide(const float *input, int count, float *output, int axis, float value, float sign) {
+		int outputCount = 0;
+		for (int i = 0; i < count; i++) {
+			const float *a = input + (i << 1), *b = input + (i + 1 == count ? 0 : (i + 1) << 1);
+			float distanceA = (a[axis] - value) * sign, distanceB = (b[axis] - value) * sign;
+			if (distanceA > 0) {
+				output[outputCount << 1] = a[0];
+				output[(outputCount << 1) + 1] = a[1];
+				outputCount++;
+			}
+			if ((distanceA > 0) != (distanceB > 0)) {
+				float t = distanceA / (distanceA - distanceB);
+				float *point = output + (outputCount << 1);
+				point[axis] = value;
+				point[axis ^ 1] = a[axis ^ 1] + (b[axis ^ 1] - a[axis ^ 1]) * t;
+				outputCount++;
+			}
+		}
+		return outputCount;
+	}
+}
+
 void SkeletonClipping::clipTriangles(float *vertices, unsigned short *triangles,
 									 size_t trianglesLength, float *uvs, size_t stride) {
 	Vector<float> &clipOutput = _clipOutput;
@@ -94,15 +266,16 @@ void SkeletonClipping::clipTriangles(float *vertices, unsigned short *triangles,
 	Vector<unsigned short> &clippedTriangles = _clippedTriangles;
 	Vector<Vector<float> *> &polygons = *_clippingPolygons;
 	size_t polygonsCount = (*_clippingPolygons).size();
+	bool rectangle = _clippingRectangle;
+	float rectangleOutput[7 * 2];
 
-	size_t index = 0;
-	clippedVertices.clear();
-	_clippedUVs.clear();
-	clippedTriangles.clear();
+	// Sized for all triangles being inside, grown when clipping adds vertices and trimmed at the end.
+	size_t index = 0, verticesLength = 0, clippedTrianglesLength = 0;
+	clippedVertices.setSize(trianglesLength << 1, 0);
+	_clippedUVs.setSize(trianglesLength << 1, 0);
+	clippedTriangles.setSize(trianglesLength, 0);
 
-	size_t i = 0;
-continue_outer:
-	for (; i < trianglesLength; i += 3) {
+	for (size_t i = 0; i < trianglesLength; i += 3) {
 		int vertexOffset = triangles[i] * (int) stride;
 		float x1 = vertices[vertexOffset], y1 = vertices[vertexOffset + 1];
 		float u1 = uvs[vertexOffset], v1 = uvs[vertexOffset + 1];
@@ -115,68 +288,95 @@ continue_outer:
 		float x3 = vertices[vertexOffset], y3 = vertices[vertexOffset + 1];
 		float u3 = uvs[vertexOffset], v3 = uvs[vertexOffset + 1];
 
+		float minX = MathUtil::min(x1, MathUtil::min(x2, x3)), maxX = MathUtil::max(x1, MathUtil::max(x2, x3));
+		float minY = MathUtil::min(y1, MathUtil::min(y2, y3)), maxY = MathUtil::max(y1, MathUtil::max(y2, y3));
+
 		for (size_t p = 0; p < polygonsCount; p++) {
-			size_t s = clippedVertices.size();
-			if (clip(x1, y1, x2, y2, x3, y3, &(*polygons[p]), &clipOutput)) {
-				size_t clipOutputLength = clipOutput.size();
-				if (clipOutputLength == 0) continue;
+			// Triangles outside the polygon's bounds are dropped, those inside the polygon are kept whole.
+			float *bounds = &_clippingBounds[p << 2];
+			if (maxX <= bounds[0] || maxY <= bounds[1] || minX >= bounds[2] || minY >= bounds[3]) continue;
+			int side;
+			if (rectangle)
+				side = minX > bounds[0] && minY > bounds[1] && maxX < bounds[2] && maxY < bounds[3] ? 1 : 0;
+			else
+				side = classifyTriangle(x1, y1, x2, y2, x3, y3, *polygons[p]);
+			if (side < 0) continue;
+
+			if (side == 0) {
+				float *clipped;
+				size_t clipOutputLength;
+				if (rectangle) {
+					clipped = rectangleOutput;
+					clipOutputLength = clipRectangle(x1, y1, x2, y2, x3, y3, bounds, rectangleOutput) << 1;
+				} else {
+					clip(x1, y1, x2, y2, x3, y3, &(*polygons[p]), &clipOutput);
+					clipped = clipOutput.buffer();
+					clipOutputLength = clipOutput.size();
+				}
+				if (clipOutputLength < 6) continue;
 				float d0 = y2 - y3, d1 = x3 - x2, d2 = x1 - x3, d4 = y3 - y1;
 				float d = 1 / (d0 * d2 + d1 * (y1 - y3));
 
 				size_t clipOutputCount = clipOutputLength >> 1;
-				clippedVertices.setSize(s + clipOutputCount * 2, 0);
-				_clippedUVs.setSize(s + clipOutputCount * 2, 0);
+				float *clippedVertex = reserve(clippedVertices, verticesLength, clipOutputLength);
+				float *clippedUV = reserve(_clippedUVs, verticesLength, clipOutputLength);
 				for (size_t ii = 0; ii < clipOutputLength; ii += 2) {
-					float x = clipOutput[ii], y = clipOutput[ii + 1];
-					clippedVertices[s] = x;
-					clippedVertices[s + 1] = y;
+					float x = clipped[ii], y = clipped[ii + 1];
+					clippedVertex[ii] = x;
+					clippedVertex[ii + 1] = y;
 					float c0 = x - x3, c1 = y - y3;
 					float a = (d0 * c0 + d1 * c1) * d;
 					float b = (d4 * c0 + d2 * c1) * d;
 					float c = 1 - a - b;
-					_clippedUVs[s] = u1 * a + u2 * b + u3 * c;
-					_clippedUVs[s + 1] = v1 * a + v2 * b + v3 * c;
-					s += 2;
+					clippedUV[ii] = u1 * a + u2 * b + u3 * c;
+					clippedUV[ii + 1] = v1 * a + v2 * b + v3 * c;
 				}
+				verticesLength += clipOutputLength;
 
-				s = clippedTriangles.size();
-				clippedTriangles.setSize(s + 3 * (clipOutputCount - 2), 0);
+				unsigned short *clippedTriangle = reserve(clippedTriangles, clippedTrianglesLength,
+														  3 * (clipOutputCount - 2));
+				clippedTrianglesLength += 3 * (clipOutputCount - 2);
 				clipOutputCount--;
 				for (size_t ii = 1; ii < clipOutputCount; ii++) {
-					clippedTriangles[s] = (unsigned short) (index);
-					clippedTriangles[s + 1] = (unsigned short) (index + ii);
-					clippedTriangles[s + 2] = (unsigned short) (index + ii + 1);
-					s += 3;
+					clippedTriangle[0] = (unsigned short) (index);
+					clippedTriangle[1] = (unsigned short) (index + ii);
+					clippedTriangle[2] = (unsigned short) (index + ii + 1);
+					clippedTriangle += 3;
 				}
 				index += clipOutputCount + 1;
 			} else {
-				clippedVertices.setSize(s + 3 * 2, 0);
-				_clippedUVs.setSize(s + 3 * 2, 0);
-				clippedVertices[s] = x1;
-				clippedVertices[s + 1] = y1;
-				clippedVertices[s + 2] = x2;
-				clippedVertices[s + 3] = y2;
-				clippedVertices[s + 4] = x3;
-				clippedVertices[s + 5] = y3;
-
-				_clippedUVs[s] = u1;
-				_clippedUVs[s + 1] = v1;
-				_clippedUVs[s + 2] = u2;
-				_clippedUVs[s + 3] = v2;
-				_clippedUVs[s + 4] = u3;
-				_clippedUVs[s + 5] = v3;
-
-				s = clippedTriangles.size();
-				clippedTriangles.setSize(s + 3, 0);
-				clippedTriangles[s] = (unsigned short) index;
-				clippedTriangles[s + 1] = (unsigned short) (index + 1);
-				clippedTriangles[s + 2] = (unsigned short) (index + 2);
+				float *clippedVertex = reserve(clippedVertices, verticesLength, 6);
+				float *clippedUV = reserve(_clippedUVs, verticesLength, 6);
+				clippedVertex[0] = x1;
+				clippedVertex[1] = y1;
+				clippedVertex[2] = x2;
+				clippedVertex[3] = y2;
+				clippedVertex[4] = x3;
+				clippedVertex[5] = y3;
+
+				clippedUV[0] = u1;
+				clippedUV[1] = v1;
+				clippedUV[2] = u2;
+				clippedUV[3] = v2;
+				clippedUV[4] = u3;
+				clippedUV[5] = v3;
+				verticesLength += 6;
+
+				unsigned short *clippedTriangle = reserve(clippedTriangles, clippedTrianglesLength, 3);
+				clippedTriangle[0] = (unsigned short) index;
+				clippedTriangle[1] = (unsigned short) (index + 1);
+				clippedTriangle[2] = (unsigned short) (index + 2);
+				clippedTrianglesLength += 3;
 				index += 3;
-				i += 3;
-				goto continue_outer;
+				// The polygons don't overlap, so the triangle is outside all others.
+				break;
 			}
 		}
 	}
+
+	clippedVertices.setSize(verticesLength, 0);
+	_clippedUVs.setSize(verticesLength, 0);
+	clippedTriangles.setSize(clippedTrianglesLength, 0);
 }
 
 bool SkeletonClipping::isClipping() {
@@ -296,6 +496,16 @@ bool SkeletonClipping::clip(float x1, float y1, float x2, float y2, float x3, fl
 	return clipped;
 }
 
+int SkeletonClipping::clipRectangle(float x1, float y1, float x2, float y2, float x3, float y3, const float *bounds,
+									float *output) {
+	// Each side adds at most one vertex to the triangle.
+	float input[7 * 2] = {x1, y1, x2, y2, x3, y3}, scratch[7 * 2];
+	int count = clipSide(input, 3, scratch, 0, bounds[0], 1);
+	count = clipSide(scratch, count, input, 1, bounds[1], 1);
+	count = clipSide(input, count, scratch, 0, bounds[2], -1);
+	return clipSide(scratch, count, output, 1, bounds[3], -1);
+}
+
 void SkeletonClipping::makeClockwise(Vector<float> &polygon) {
 	size_t verticeslength = polygon.size();
 
@@ -30,6 +30,7 @@
 #include <spine/SkeletonData.h>
 
 #include <spine/Animation.h>
+#include <spine/AnimationLoader.h>
 #include <spine/BoneData.h>
 #include <spine/EventData.h>
 #include <spine/IkConstraintData.h>
@@ -40,8 +41,31 @@
 
 #include <spine/ContainerUtil.h>
 
+#ifndef SPINE_NO_THREADS
+#include <mutex>
+#endif
+
 using namespace spine;
 
+namespace {
+	// Guards the property indices of all skeleton data, which are assigned while animations are decoded, possibly lazily
+	// on several threads.
+#ifndef SPINE_NO_THREADS
+	std::mutex propertyIndicesMutex;
+#define SPINE_PROPERTY_LOCK() std::lock_guard<std::mutex> lock(propertyIndicesMutex)
+#else
+#define SPINE_PROPERTY_LOCK()
+#endif
+
+	// Guards the constraint order of all skeleton data, which is computed by the first skeleton to update its cache.
+#ifndef SPINE_NO_THREADS
+	std::mutex constraintOrderMutex;
+#define SPINE_CONSTRAINT_ORDER_LOCK() std::lock_guard<std::mutex> lock(constraintOrderMutex)
+#else
+#define SPINE_CONSTRAINT_ORDER_LOCK()
+#endif
+}
+
 SkeletonData::SkeletonData() : _name(),
 							   _defaultSkin(NULL),
 							   _x(0),
@@ -51,10 +75,14 @@ SkeletonData::SkeletonData() : _name(),
 							   _version(),
 							   _hash(),
 							   _fps(0),
-							   _imagesPath() {
+							   _imagesPath(),
+							   _animationLoader(NULL),
+							   _propertyIndices(),
+							   _constraintOrderSerial(0) {
 }
 
 SkeletonData::~SkeletonData() {
+	_arena.makeCurrent();
 	ContainerUtil::cleanUpVectorOfPointers(_bones);
 	ContainerUtil::cleanUpVectorOfPointers(_slots);
 	ContainerUtil::cleanUpVectorOfPointers(_skins);
@@ -63,6 +91,7 @@ SkeletonData::~SkeletonData() {
 
 	ContainerUtil::cleanUpVectorOfPointers(_events);
 	ContainerUtil::cleanUpVectorOfPointers(_animations);
+	delete _animationLoader;
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
@@ -88,7 +117,9 @@ spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	Animation *animation = ContainerUtil::findWithName(_animations, animationName);
+	if (animation) animation->load();
+	return animation;
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
@@ -216,6 +247,15 @@ void SkeletonData::setAudioPath(const String &inValue) {
 	_audioPath = inValue;
 }
 
+Arena *SkeletonData::getArena() {
+	return _arena.arena;
+}
+
+void SkeletonData::evictAnimations() {
+	for (size_t i = 0; i < _animations.size(); i++)
+		_animations[i]->evict();
+}
+
 float SkeletonData::getFps() {
 	return _fps;
 }
@@ -223,3 +263,80 @@ float SkeletonData::getFps() {
 void SkeletonData::setFps(float inValue) {
 	_fps = inValue;
 }
+
+int SkeletonData::getPropertyIndex(PropertyId id) {
+	SPINE_PROPERTY_LOCK();
+	if (_propertyIndices.containsKey(id)) return _propertyIndices[id];
+	int index = (int) _propertyIndices.size();
+	// Properties are added after loading, so the map is allocated outside of any arena.
+	Arena *arena = Arena::setCurrent(NULL);
+	_propertyIndices.put(id, index);
+	Arena::setCurrent(arena);
+	return index;
+}
+
+int SkeletonData::getPropertyCount() {
+	SPINE_PROPERTY_LOCK();
+	return (int) _propertyIndices.size();
+}
+
+ConstraintData *SkeletonData::getConstraint(size_t i, int &type, int &index) {
+	size_t ikCount = _ikConstraints.size(), transformCount = _transformConstraints.size();
+	if (i < ikCount) {
+		type = ConstraintIk;
+		index = (int) i;
+		return _ikConstraints[i];
+	}
+	if (i < ikCount + transformCount) {
+		type = ConstraintTransform;
+		index = (int) (i - ikCount);
+		return _transformConstraints[index];
+	}
+	type = ConstraintPath;
+	index = (int) (i - ikCount - transformCount);
+	return _pathConstraints[index];
+}
+
+int SkeletonData::getConstraintOrder(Vector<int> &constraintOrder, Vector<ConstraintData *> &constraintsByOrder) {
+	SPINE_CONSTRAINT_ORDER_LOCK();
+	size_t constraintCount = _ikConstraints.size() + _transformConstraints.size() + _pathConstraints.size();
+	int type, index;
+
+	// Computed again when a constraint was added or removed or its order changed, e.g. by ConstraintData::setOrder().
+	bool valid = _constraintOrderData.size() == constraintCount;
+	for (size_t i = 0; i < constraintCount && valid; i++) {
+		ConstraintData *data = getConstraint(i, type, index);
+		valid = _constraintOrderData[i] == data && _constraintOrderValues[i] == data->getOrder();
+	}
+	if (!valid) {
+		_constraintOrderSerial++;
+		_constraintOrderData.setSize(constraintCount, NULL);
+		_constraintOrderValues.setSize(constraintCount, 0);
+		_constraintsByOrder.setSize(constraintCount, NULL);
+		Vector<int> types, indices;
+		types.setSize(constraintCount, -1);
+		indices.setSize(constraintCount, 0);
+		for (size_t i = 0; i < constraintCount; i++)
+			_constraintsByOrder[i] = NULL;
+		for (size_t i = 0; i < constraintCount; i++) {
+			ConstraintData *data = getConstraint(i, type, index);
+			size_t order = data->getOrder();
+			_constraintOrderData[i] = data;
+			_constraintOrderValues[i] = order;
+			if (order >= constraintCount || types[order] != -1) continue;
+			types[order] = type;
+			indices[order] = index;
+			_constraintsByOrder[order] = data;
+		}
+		_constraintOrder.clear();
+		for (size_t i = 0; i < constraintCount; i++) {
+			if (types[i] == -1) continue;
+			_constraintOrder.add(types[i]);
+			_constraintOrder.add(indices[i]);
+		}
+	}
+
+	constraintOrder.clearAndAddAll(_constraintOrder);
+	constraintsByOrder.clearAndAddAll(_constraintsByOrder);
+	return _constraintOrderSerial;
+}
@@ -99,11 +99,12 @@ static void toColor(Color &color, const char *value, bool hasAlpha) {
 }
 
 SkeletonJson::SkeletonJson(Atlas *atlas) : _attachmentLoader(new (__FILE__, __LINE__) AtlasAttachmentLoader(atlas)),
-										   _scale(1), _ownsLoader(true) {}
+										   _scale(1), _ownsLoader(true), _useArena(false), _skinningLayout(false), _compressAnimations(false) {}
 
 SkeletonJson::SkeletonJson(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(attachmentLoader),
 																				  _scale(1),
-																				  _ownsLoader(ownsLoader) {
+																				  _ownsLoader(ownsLoader),
+																				  _useArena(false), _skinningLayout(false), _compressAnimations(false) {
 	assert(_attachmentLoader != NULL);
 }
 
@@ -122,14 +123,44 @@ SkeletonData *SkeletonJson::readSkeletonDataFile(const String &path) {
 		return NULL;
 	}
 
-	skeletonData = readSkeletonData(json);
+	// The file buffer is not terminated and is only needed during parsing, so the document is parsed in place.
+	char *text = SpineExtension::realloc((char *) json, length + 1, __FILE__, __LINE__);
+	text[length] = 0;
+	skeletonData = readSkeletonData(text, true);
 
-	SpineExtension::free(json, __FILE__, __LINE__);
+	SpineExtension::free(text, __FILE__, __LINE__);
 
 	return skeletonData;
 }
 
 SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
+	return readSkeletonData(json, false);
+}
+
+SkeletonData *SkeletonJson::readSkeletonData(const char *json, bool inPlace) {
+	if (!_useArena) return loadSkeletonData(json, inPlace);
+
+	Arena *previous = Arena::setCurrent(NULL);
+	Arena *arena = new (__FILE__, __LINE__) Arena();
+	Arena::setCurrent(arena);
+	SkeletonData *skeletonData = loadSkeletonData(json, inPlace);
+
+	// Loader state is freed into the arena while it is current, and the error that outlives it is moved out of it.
+	if (!skeletonData) ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
+	Arena *loading = Arena::setCurrent(previous);
+	String error(_error);
+	Arena::setCurrent(loading);
+	_error.own(error);
+	Arena::setCurrent(previous);
+
+	if (skeletonData)
+		skeletonData->_arena.arena = arena;
+	else
+		delete arena;
+	return skeletonData;
+}
+
+SkeletonData *SkeletonJson::loadSkeletonData(const char *json, bool inPlace) {
 	int i, ii;
 	SkeletonData *skeletonData;
 	Json *root, *skeleton, *bones, *boneMap, *ik, *transform, *path, *slots, *skins, *animations, *events;
@@ -137,14 +168,19 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 	_error = "";
 	_linkedMeshes.clear();
 
-	root = new (__FILE__, __LINE__) Json(json);
+	// The document is temporary and the skeleton data owns the arena, so both are allocated outside of it.
+	Arena *arena = Arena::setCurrent(NULL);
+	root = inPlace ? new (__FILE__, __LINE__) Json((char *) json, true) : new (__FILE__, __LINE__) Json(json);
+	Arena::setCurrent(arena);
 
 	if (!root) {
 		setError(NULL, "Invalid skeleton JSON: ", Json::getError());
 		return NULL;
 	}
 
+	Arena::setCurrent(NULL);
 	skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	Arena::setCurrent(arena);
 
 	skeleton = Json::getItem(root, "skeleton");
 	if (skeleton) {
@@ -153,7 +189,8 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		if (!skeletonData->_version.startsWith(SPINE_VERSION_STRING)) {
 			char errorMsg[255];
 			sprintf(errorMsg, "Skeleton version %s does not match runtime version %s", skeletonData->_version.buffer(), SPINE_VERSION_STRING);
-			setError(NULL, errorMsg, "");
+			setError(root, errorMsg, "");
+			delete skeletonData;
 			return NULL;
 		}
 		skeletonData->_x = Json::getFloat(skeleton, "x", 0);
@@ -615,6 +652,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 										mesh->_regionUVs[ii] = entry->_valueFloat;
 
 									readVertices(attachmentMap, mesh, verticesLength);
+									if (_skinningLayout) mesh->buildSkinningLayout();
 
 									if (mesh->_region != NULL) mesh->updateRegion();
 
@@ -637,7 +675,9 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 																								 slot->getIndex(),
 																								 String(entry->_valueString),
 																								 inheritTimelines);
+									Arena::setCurrent(NULL);
 									_linkedMeshes.add(linkedMesh);
+									Arena::setCurrent(arena);
 								}
 								break;
 							}
@@ -1424,7 +1464,10 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 	float duration = 0;
 	for (size_t i = 0; i < timelines.size(); i++)
 		duration = MathUtil::max(duration, timelines[i]->getDuration());
-	return new (__FILE__, __LINE__) Animation(String(root->_name), timelines, duration);
+	Animation *animation = new (__FILE__, __LINE__) Animation(String(root->_name), timelines, duration);
+	if (_compressAnimations) animation->compress();
+	animation->indexProperties(*skeletonData);
+	return animation;
 }
 
 void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachment, size_t verticesLength) {
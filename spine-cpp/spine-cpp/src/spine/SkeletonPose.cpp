@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/SkeletonPose.h>
+
+#include <spine/Bone.h>
+#include <spine/BoneData.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+
+using namespace spine;
+
+SkeletonPose::SkeletonPose(Skeleton &skeleton) : _bones(skeleton.getBones()), _run(0) {
+	size_t boneCount = _bones.size();
+	Vector<float> *channels[] = {&_ax, &_ay, &_arotation, &_ascaleX, &_ascaleY, &_ashearX, &_ashearY,
+								 &_a, &_b, &_c, &_d, &_worldX, &_worldY};
+	for (size_t i = 0; i < sizeof(channels) / sizeof(channels[0]); i++)
+		channels[i]->setSize(boneCount, 0);
+	_parents.setSize(boneCount, -1);
+	for (size_t i = 0; i < boneCount; i++) {
+		Bone *parent = _bones[i]->_parent;
+		if (parent) _parents[i] = parent->_data.getIndex();
+	}
+	_runs.setSize(boneCount, 0);
+	Vector<float> *scratch[] = {&_angles1, &_angles2, &_sin1, &_cos1, &_sin2, &_cos2};
+	for (size_t i = 0; i < sizeof(scratch) / sizeof(scratch[0]); i++)
+		scratch[i]->setSize(boneCount, 0);
+}
+
+SkeletonPose::~SkeletonPose() {
+}
+
+size_t SkeletonPose::getBoneCount() {
+	return _bones.size();
+}
+
+void SkeletonPose::updateWorldTransforms(const int *run, size_t count) {
+	Bone **bones = _bones.buffer();
+	const int *parents = _parents.buffer();
+	unsigned int *runs = _runs.buffer();
+	float *ax = _ax.buffer(), *ay = _ay.buffer(), *arotation = _arotation.buffer(), *ascaleX = _ascaleX.buffer();
+	float *ascaleY = _ascaleY.buffer(), *ashearX = _ashearX.buffer(), *ashearY = _ashearY.buffer();
+	float *a = _a.buffer(), *b = _b.buffer(), *c = _c.buffer(), *d = _d.buffer();
+	float *worldX = _worldX.buffer(), *worldY = _worldY.buffer();
+	float *angles1 = _angles1.buffer(), *angles2 = _angles2.buffer();
+	float *sin1 = _sin1.buffer(), *cos1 = _cos1.buffer(), *sin2 = _sin2.buffer(), *cos2 = _cos2.buffer();
+
+	// Constraints may have changed the applied transforms of the bones and the world transforms of parents outside of
+	// the run since the skeleton was posed, so both are gathered from the bones.
+	unsigned int current = ++_run;
+	for (size_t i = 0; i < count; i++) {
+		int index = run[i << 1], parent = parents[index];
+		Bone &bone = *bones[index];
+		ax[index] = bone._ax;
+		ay[index] = bone._ay;
+		arotation[index] = bone._arotation;
+		ascaleX[index] = bone._ascaleX;
+		ascaleY[index] = bone._ascaleY;
+		ashearX[index] = bone._ashearX;
+		ashearY[index] = bone._ashearY;
+		if (runs[parent] != current) {
+			Bone &parentBone = *bones[parent];
+			a[parent] = parentBone._a;
+			b[parent] = parentBone._b;
+			c[parent] = parentBone._c;
+			d[parent] = parentBone._d;
+			worldX[parent] = parentBone._worldX;
+			worldY[parent] = parentBone._worldY;
+			runs[parent] = current;
+		}
+		runs[index] = current;
+		angles1[i] = arotation[index] + ashearX[index];
+		angles2[i] = arotation[index] + 90 + ashearY[index];
+	}
+	MathUtil::sinCosDeg(angles1, sin1, cos1, count);
+	MathUtil::sinCosDeg(angles2, sin2, cos2, count);
+
+	// Parents must be updated before their children, so the matrix products are done in order. The world transforms are
+	// written back to the bones after the run, as constraints and attachments read them from there.
+	for (size_t i = 0; i < count; i++) {
+		int index = run[i << 1], parent = parents[index];
+		float pa = a[parent], pb = b[parent], pc = c[parent], pd = d[parent];
+		float x = ax[index], y = ay[index];
+		worldX[index] = pa * x + pb * y + worldX[parent];
+		worldY[index] = pc * x + pd * y + worldY[parent];
+
+		float la = cos1[i] * ascaleX[index], lb = cos2[i] * ascaleY[index];
+		float lc = sin1[i] * ascaleX[index], ld = sin2[i] * ascaleY[index];
+		a[index] = pa * la + pb * lc;
+		b[index] = pa * lb + pb * ld;
+		c[index] = pc * la + pd * lc;
+		d[index] = pc * lb + pd * ld;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		int index = run[i << 1];
+		Bone &bone = *bones[index];
+		bone._a = a[index];
+		bone._b = b[index];
+		bone._c = c[index];
+		bone._d = d[index];
+		bone._worldX = worldX[index];
+		bone._worldY = worldY[index];
+	}
+}
+
+Vector<float> &SkeletonPose::getAX() { return _ax; }
+
+Vector<float> &SkeletonPose::getAY() { return _ay; }
+
+Vector<float> &SkeletonPose::getARotation() { return _arotation; }
+
+Vector<float> &SkeletonPose::getAScaleX() { return _ascaleX; }
+
+Vector<float> &SkeletonPose::getAScaleY() { return _ascaleY; }
+
+Vector<float> &SkeletonPose::getAShearX() { return _ashearX; }
+
+Vector<float> &SkeletonPose::getAShearY() { return _ashearY; }
+
+Vector<float> &SkeletonPose::getA() { return _a; }
+
+Vector<float> &SkeletonPose::getB() { return _b; }
+
+Vector<float> &SkeletonPose::getC() { return _c; }
+
+Vector<float> &SkeletonPose::getD() { return _d; }
+
+Vector<float> &SkeletonPose::getWorldX() { return _worldX; }
+
+Vector<float> &SkeletonPose::getWorldY() { return _worldY; }
@@ -0,0 +1,313 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonRenderer.h>
+
+#include <spine/Atlas.h>
+#include <spine/Bone.h>
+#include <spine/BoneData.h>
+#include <spine/ChangeTracker.h>
+#include <spine/ClippingAttachment.h>
+#include <spine/ContainerUtil.h>
+#include <spine/MeshAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/Skeleton.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+
+using namespace spine;
+
+namespace {
+	// World vertices are computed straight into the vertex buffer, skipping the other fields of each vertex.
+	const size_t VERTEX_STRIDE = sizeof(RenderVertex) / sizeof(float);
+
+	const size_t MAX_16BIT_VERTICES = 65536;
+
+	inline unsigned int packColor(float r, float g, float b, float a) {
+		return (unsigned int) (r * 255) | (unsigned int) (g * 255) << 8 | (unsigned int) (b * 255) << 16 |
+			   (unsigned int) (a * 255) << 24;
+	}
+}
+
+SkeletonRenderer::SkeletonRenderer() : _use32BitIndices(false), _cacheTrackerId(-1) {
+	_quadIndices.add(0);
+	_quadIndices.add(1);
+	_quadIndices.add(2);
+	_quadIndices.add(2);
+	_quadIndices.add(3);
+	_quadIndices.add(0);
+}
+
+SkeletonRenderer::~SkeletonRenderer() {
+	ContainerUtil::cleanUpVectorOfPointers(_vertexCaches);
+}
+
+Vector<RenderCommand> &SkeletonRenderer::render(Skeleton &skeleton) {
+	_vertices.clear();
+	_indices.clear();
+	_indices32.clear();
+	_commands.clear();
+
+	// Versions of another tracker can't be compared with those the cached vertices were computed for.
+	ChangeTracker *tracker = skeleton.getChangeTracker();
+	if (tracker && tracker->getId() != _cacheTrackerId) {
+		for (size_t i = 0, n = _vertexCaches.size(); i < n; i++)
+			if (_vertexCaches[i]) _vertexCaches[i]->attachment = NULL;
+		if (_vertexCaches.size() < skeleton.getSlots().size()) _vertexCaches.setSize(skeleton.getSlots().size(), NULL);
+		_cacheTrackerId = tracker->getId();
+	}
+
+	Color &skeletonColor = skeleton.getColor();
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	RenderVertex vertex = {0, 0, 0, 0, 0, 0};
+	size_t commandFirstVertex = 0;
+	for (size_t i = 0, n = drawOrder.size(); i < n; ++i) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) {
+			_clipping.clipEnd(slot);
+			continue;
+		}
+
+		RegionAttachment *region = NULL;
+		MeshAttachment *mesh = NULL;
+		Color *attachmentColor;
+		size_t worldVerticesLength;
+		Vector<float> *uvs;
+		Vector<unsigned short> *indices;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			region = (RegionAttachment *) attachment;
+			attachmentColor = &region->getColor();
+			worldVerticesLength = 8;
+			uvs = &region->getUVs();
+			indices = &_quadIndices;
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			mesh = (MeshAttachment *) attachment;
+			attachmentColor = &mesh->getColor();
+			worldVerticesLength = mesh->getWorldVerticesLength();
+			uvs = &mesh->getUVs();
+			indices = &mesh->getTriangles();
+		} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+			_clipping.clipStart(slot, (ClippingAttachment *) attachment);
+			continue;
+		} else {
+			_clipping.clipEnd(slot);
+			continue;
+		}
+
+		if (attachmentColor->a == 0) {
+			_clipping.clipEnd(slot);
+			continue;
+		}
+
+		// Computing the world vertices also applies the attachment's sequence, which may change its renderer object.
+		size_t firstVertex = _vertices.size();
+		size_t verticesCount = worldVerticesLength >> 1;
+		bool clipping = _clipping.isClipping();
+		float *worldVertices;
+		size_t stride;
+		if (clipping) {
+			_worldVertices.setSize(worldVerticesLength, 0);
+			worldVertices = _worldVertices.buffer();
+			stride = 2;
+		} else {
+			_vertices.setSize(firstVertex + verticesCount, vertex);
+			worldVertices = &_vertices[firstVertex].x;
+			stride = VERTEX_STRIDE;
+		}
+		void *rendererObject;
+		if (region) {
+			region->computeWorldVertices(slot, worldVertices, 0, stride);
+			rendererObject = region->getRendererObject();
+		} else {
+			if (tracker)
+				computeWorldVertices(*tracker, slot, mesh, worldVertices, stride);
+			else
+				mesh->computeWorldVertices(slot, 0, worldVerticesLength, worldVertices, 0, stride);
+			rendererObject = mesh->getRendererObject();
+		}
+
+		if (clipping) {
+			_clipping.clipTriangles(_worldVertices, *indices, *uvs, 2);
+			Vector<float> &clippedVertices = _clipping.getClippedVertices();
+			verticesCount = clippedVertices.size() >> 1;
+			if (verticesCount == 0) {
+				_clipping.clipEnd(slot);
+				continue;
+			}
+			uvs = &_clipping.getClippedUVs();
+			indices = &_clipping.getClippedTriangles();
+			_vertices.setSize(firstVertex + verticesCount, vertex);
+			RenderVertex *vertices = &_vertices[firstVertex];
+			for (size_t ii = 0; ii < verticesCount; ii++) {
+				vertices[ii].x = clippedVertices[ii << 1];
+				vertices[ii].y = clippedVertices[(ii << 1) + 1];
+			}
+		}
+
+		Color &slotColor = slot.getColor();
+		unsigned int color = packColor(skeletonColor.r * slotColor.r * attachmentColor->r,
+									   skeletonColor.g * slotColor.g * attachmentColor->g,
+									   skeletonColor.b * slotColor.b * attachmentColor->b,
+									   skeletonColor.a * slotColor.a * attachmentColor->a);
+		unsigned int darkColor = 0xff000000;
+		if (slot.hasDarkColor()) {
+			Color &dark = slot.getDarkColor();
+			darkColor = packColor(dark.r, dark.g, dark.b, 1);
+		}
+		RenderVertex *vertices = &_vertices[firstVertex];
+		float *uv = uvs->buffer();
+		for (size_t ii = 0; ii < verticesCount; ii++, uv += 2) {
+			vertices[ii].u = uv[0];
+			vertices[ii].v = uv[1];
+			vertices[ii].color = color;
+			vertices[ii].darkColor = darkColor;
+		}
+
+		// Start a new command when the state changes, or when 16 bit indices could no longer address all its vertices.
+		void *texture = ((AtlasRegion *) rendererObject)->page->getRendererObject();
+		BlendMode blendMode = slot.getData().getBlendMode();
+		RenderCommand *command = _commands.size() ? &_commands[_commands.size() - 1] : NULL;
+		if (!command || command->texture != texture || command->blendMode != blendMode ||
+			(!_use32BitIndices && firstVertex + verticesCount - commandFirstVertex > MAX_16BIT_VERTICES)) {
+			RenderCommand newCommand = {NULL, 0, NULL, NULL, 0, texture, blendMode};
+			_commands.add(newCommand);
+			command = &_commands[_commands.size() - 1];
+			commandFirstVertex = firstVertex;
+		}
+
+		size_t indicesCount = indices->size();
+		unsigned short *slotIndices = indices->buffer();
+		unsigned int offset = (unsigned int) (firstVertex - commandFirstVertex);
+		if (_use32BitIndices) {
+			size_t firstIndex = _indices32.size();
+			_indices32.setSize(firstIndex + indicesCount, 0);
+			unsigned int *commandIndices = _indices32.buffer() + firstIndex;
+			for (size_t ii = 0; ii < indicesCount; ii++)
+				commandIndices[ii] = offset + slotIndices[ii];
+		} else {
+			size_t firstIndex = _indices.size();
+			_indices.setSize(firstIndex + indicesCount, 0);
+			unsigned short *commandIndices = _indices.buffer() + firstIndex;
+			for (size_t ii = 0; ii < indicesCount; ii++)
+				commandIndices[ii] = (unsigned short) (offset + slotIndices[ii]);
+		}
+		command->numVertices += (int) verticesCount;
+		command->numIndices += (int) indicesCount;
+
+		_clipping.clipEnd(slot);
+	}
+	_clipping.clipEnd();
+
+	// The buffers are final, so the commands can point into them.
+	RenderVertex *vertices = _vertices.buffer();
+	unsigned short *indices = _indices.buffer();
+	unsigned int *indices32 = _indices32.buffer();
+	for (size_t i = 0, n = _commands.size(); i < n; i++) {
+		RenderCommand &command = _commands[i];
+		command.vertices = vertices;
+		vertices += command.numVertices;
+		if (_use32BitIndices) {
+			command.indices32 = indices32;
+			indices32 += command.numIndices;
+		} else {
+			command.indices = indices;
+			indices += command.numIndices;
+		}
+	}
+	return _commands;
+}
+
+void SkeletonRenderer::computeWorldVertices(ChangeTracker &tracker, Slot &slot, MeshAttachment *mesh,
+											float *worldVertices, size_t stride) {
+	VertexCache *cache = _vertexCaches[slot.getData().getIndex()];
+	if (!cache) {
+		cache = new (__FILE__, __LINE__) VertexCache();
+		cache->attachment = NULL;
+		_vertexCaches[slot.getData().getIndex()] = cache;
+	}
+	if (cache->attachment != mesh) {
+		cache->attachment = mesh;
+		cache->bones.clear();
+		cache->worldVertices.clear();
+		Vector<size_t> &bones = mesh->getBones();
+		if (bones.size() == 0)
+			cache->bones.add(slot.getBone().getData().getIndex());
+		for (size_t i = 0, n = bones.size(); i < n; i += bones[i] + 1) {
+			for (size_t ii = i + 1, end = i + 1 + bones[i]; ii < end; ii++) {
+				if (!cache->bones.contains((int) bones[ii])) cache->bones.add((int) bones[ii]);
+			}
+		}
+		cache->versions.setSize(cache->bones.size(), 0);
+	}
+
+	Vector<float> &deform = slot.getDeform();
+	size_t worldVerticesLength = mesh->getWorldVerticesLength();
+	bool valid = cache->worldVertices.size() == worldVerticesLength && cache->deform.size() == deform.size();
+	// Each version is compared, a sum of them could stay the same when the bones changed.
+	unsigned int *versions = cache->versions.buffer();
+	for (size_t i = 0, n = cache->bones.size(); i < n; i++) {
+		unsigned int version = tracker.getWorldVersion(cache->bones[i]);
+		if (versions[i] != version) {
+			versions[i] = version;
+			valid = false;
+		}
+	}
+	for (size_t i = 0, n = deform.size(); i < n && valid; i++)
+		valid = cache->deform[i] == deform[i];
+
+	if (valid) {
+		// Computing the world vertices would have applied the sequence.
+		if (mesh->getSequence()) mesh->getSequence()->apply(&slot, mesh);
+		tracker._verticesReused += (int) worldVerticesLength >> 1;
+	} else {
+		cache->worldVertices.setSize(worldVerticesLength, 0);
+		mesh->computeWorldVertices(slot, 0, worldVerticesLength, cache->worldVertices, 0, 2);
+		cache->deform.clearAndAddAll(deform);
+		tracker._verticesComputed += (int) worldVerticesLength >> 1;
+	}
+
+	float *cached = cache->worldVertices.buffer();
+	for (size_t i = 0; i < worldVerticesLength; i += 2, worldVertices += stride) {
+		worldVertices[0] = cached[i];
+		worldVertices[1] = cached[i + 1];
+	}
+}
+
+Vector<RenderCommand> &SkeletonRenderer::getCommands() {
+	return _commands;
+}
+
+void SkeletonRenderer::setUse32BitIndices(bool use32BitIndices) {
+	_use32BitIndices = use32BitIndices;
+}
+
+bool SkeletonRenderer::getUse32BitIndices() {
+	return _use32BitIndices;
+}
@@ -38,8 +38,20 @@
 
 #include <assert.h>
 
+#ifndef SPINE_NO_THREADS
+#include <atomic>
+#endif
+
 using namespace spine;
 
+namespace {
+#ifndef SPINE_NO_THREADS
+	std::atomic<int> nextSkinId(0);
+#else
+	int nextSkinId = 0;
+#endif
+}
+
 Skin::AttachmentMap::AttachmentMap() {
 }
 
@@ -50,45 +62,99 @@ static void disposeAttachment(Attachment *attachment) {
 }
 
 void Skin::AttachmentMap::put(size_t slotIndex, const String &attachmentName, Attachment *attachment) {
-	if (slotIndex >= _buckets.size())
+	if (slotIndex >= _buckets.size()) {
 		_buckets.setSize(slotIndex + 1, Vector<Entry>());
+		_indices.setSize(slotIndex + 1, Vector<int>());
+	}
 	Vector<Entry> &bucket = _buckets[slotIndex];
-	int existing = findInBucket(bucket, attachmentName);
+	size_t hash = attachmentName.hash();
+	int existing = findInBucket(slotIndex, attachmentName, hash);
 	attachment->reference();
 	if (existing >= 0) {
 		disposeAttachment(bucket[existing]._attachment);
 		bucket[existing]._attachment = attachment;
 	} else {
 		bucket.add(Entry(slotIndex, attachmentName, attachment));
+		indexEntry(slotIndex);
 	}
 }
 
 Attachment *Skin::AttachmentMap::get(size_t slotIndex, const String &attachmentName) {
+	return get(slotIndex, attachmentName, attachmentName.hash());
+}
+
+Attachment *Skin::AttachmentMap::get(size_t slotIndex, const String &attachmentName, size_t hash) {
 	if (slotIndex >= _buckets.size()) return NULL;
-	int existing = findInBucket(_buckets[slotIndex], attachmentName);
+	int existing = findInBucket(slotIndex, attachmentName, hash);
 	return existing >= 0 ? _buckets[slotIndex][existing]._attachment : NULL;
 }
 
 void Skin::AttachmentMap::remove(size_t slotIndex, const String &attachmentName) {
 	if (slotIndex >= _buckets.size()) return;
-	int existing = findInBucket(_buckets[slotIndex], attachmentName);
+	int existing = findInBucket(slotIndex, attachmentName, attachmentName.hash());
 	if (existing >= 0) {
 		disposeAttachment(_buckets[slotIndex][existing]._attachment);
 		_buckets[slotIndex].removeAt(existing);
+		indexBucket(slotIndex);
+	}
+}
+
+int Skin::AttachmentMap::findInBucket(size_t slotIndex, const String &attachmentName, size_t hash) {
+	Vector<Entry> &bucket = _buckets[slotIndex];
+	Vector<int> &index = _indices[slotIndex];
+	// The hashes are compared first, so names are only compared when they are likely equal.
+	if (index.size() == 0) {
+		for (size_t i = 0; i < bucket.size(); i++)
+			if (bucket[i]._hash == hash && bucket[i]._name == attachmentName) return (int) i;
+		return -1;
+	}
+	size_t mask = index.size() - 1;
+	for (size_t i = hash & mask;; i = (i + 1) & mask) {
+		int entry = index[i] - 1;
+		if (entry < 0) return -1;
+		if (bucket[entry]._hash == hash && bucket[entry]._name == attachmentName) return entry;
+	}
+}
+
+void Skin::AttachmentMap::indexEntry(size_t slotIndex) {
+	Vector<Entry> &bucket = _buckets[slotIndex];
+	Vector<int> &index = _indices[slotIndex];
+	if (bucket.size() <= MaxLinearBucket) return;
+	// The table is kept at most half full.
+	if (bucket.size() * 2 > index.size()) {
+		indexBucket(slotIndex);
+		return;
 	}
+	size_t mask = index.size() - 1, entry = bucket.size() - 1;
+	size_t i = bucket[entry]._hash & mask;
+	while (index[i] != 0)
+		i = (i + 1) & mask;
+	index[i] = (int) entry + 1;
 }
 
-int Skin::AttachmentMap::findInBucket(Vector<Entry> &bucket, const String &attachmentName) {
-	for (size_t i = 0; i < bucket.size(); i++)
-		if (bucket[i]._name == attachmentName) return (int) i;
-	return -1;
+void Skin::AttachmentMap::indexBucket(size_t slotIndex) {
+	Vector<Entry> &bucket = _buckets[slotIndex];
+	Vector<int> &index = _indices[slotIndex];
+	index.clear();
+	if (bucket.size() <= MaxLinearBucket) return;
+	size_t size = 16;
+	while (size < bucket.size() * 4)
+		size <<= 1;
+	index.setSize(size, 0);
+	size_t mask = size - 1;
+	for (size_t entry = 0; entry < bucket.size(); entry++) {
+		size_t i = bucket[entry]._hash & mask;
+		while (index[i] != 0)
+			i = (i + 1) & mask;
+		index[i] = (int) entry + 1;
+	}
 }
 
 Skin::AttachmentMap::Entries Skin::AttachmentMap::getEntries() {
 	return Skin::AttachmentMap::Entries(_buckets);
 }
 
-Skin::Skin(const String &name) : _name(name), _attachments() {
+Skin::Skin(const String &name) : _name(name), _id(nextSkinId++), _attachments(), _updateOrderData(NULL), _updateOrderSerial(0) {
 	assert(_name.length() > 0);
 }
 
@@ -109,32 +175,42 @@ Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
 	return _attachments.get(slotIndex, name);
 }
 
+Attachment *Skin::getAttachment(size_t slotIndex, const String &name, size_t hash) {
+	return _attachments.get(slotIndex, name, hash);
+}
+
 void Skin::removeAttachment(size_t slotIndex, const String &name) {
 	_attachments.remove(slotIndex, name);
 }
 
 void Skin::findNamesForSlot(size_t slotIndex, Vector<String> &names) {
-	Skin::AttachmentMap::Entries entries = _attachments.getEntries();
-	while (entries.hasNext()) {
-		Skin::AttachmentMap::Entry &entry = entries.next();
-		if (entry._slotIndex == slotIndex) {
-			names.add(entry._name);
-		}
-	}
+	Vector<AttachmentMap::Entry> *entries = getSlotAttachments(slotIndex);
+	if (!entries) return;
+	for (size_t i = 0; i < entries->size(); i++)
+		names.add((*entries)[i]._name);
 }
 
 void Skin::findAttachmentsForSlot(size_t slotIndex, Vector<Attachment *> &attachments) {
-	Skin::AttachmentMap::Entries entries = _attachments.getEntries();
-	while (entries.hasNext()) {
-		Skin::AttachmentMap::Entry &entry = entries.next();
-		if (entry._slotIndex == slotIndex) attachments.add(entry._attachment);
-	}
+	Vector<AttachmentMap::Entry> *entries = getSlotAttachments(slotIndex);
+	if (!entries) return;
+	for (size_t i = 0; i < entries->size(); i++)
+		attachments.add((*entries)[i]._attachment);
+}
+
+Vector<Skin::AttachmentMap::Entry> *Skin::getSlotAttachments(size_t slotIndex) {
+	// The attachments are stored in a bucket per slot.
+	if (slotIndex >= _attachments._buckets.size()) return NULL;
+	return &_attachments._buckets[slotIndex];
 }
 
 const String &Skin::getName() {
 	return _name;
 }
 
+int Skin::getId() {
+	return _id;
+}
+
 Skin::AttachmentMap::Entries Skin::getAttachments() {
 	return _attachments.getEntries();
 }
@@ -148,13 +224,14 @@ void Skin::attachAll(Skeleton &skeleton, Skin &oldSkin) {
 		Slot *slot = slots[slotIndex];
 
 		if (slot->getAttachment() == entry._attachment) {
-			Attachment *attachment = getAttachment(slotIndex, entry._name);
+			Attachment *attachment = getAttachment(slotIndex, entry._name, entry._hash);
 			if (attachment) slot->setAttachment(attachment);
 		}
 	}
 }
 
 void Skin::addSkin(Skin *other) {
+	_updateOrderData = NULL;
 	for (size_t i = 0; i < other->getBones().size(); i++)
 		if (!_bones.contains(other->getBones()[i])) _bones.add(other->getBones()[i]);
 
@@ -164,12 +241,12 @@ void Skin::addSkin(Skin *other) {
 	AttachmentMap::Entries entries = other->getAttachments();
 	while (entries.hasNext()) {
 		AttachmentMap::Entry &entry = entries.next();
-		entry._attachment->reference();
 		setAttachment(entry._slotIndex, entry._name, entry._attachment);
 	}
 }
 
 void Skin::copySkin(Skin *other) {
+	_updateOrderData = NULL;
 	for (size_t i = 0; i < other->getBones().size(); i++)
 		if (!_bones.contains(other->getBones()[i])) _bones.add(other->getBones()[i]);
 
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkinCache.h>
+
+#include <spine/Skeleton.h>
+#include <spine/Skin.h>
+
+#ifndef SPINE_NO_THREADS
+#include <mutex>
+#endif
+
+using namespace spine;
+
+namespace {
+	// Guards the composites and scratch skeletons of all caches. It is held while a missing composite is built, which
+	// happens once per combination.
+#ifndef SPINE_NO_THREADS
+	std::mutex skinsMutex;
+#define SPINE_SKIN_CACHE_LOCK() std::lock_guard<std::mutex> lock(skinsMutex)
+#else
+#define SPINE_SKIN_CACHE_LOCK()
+#endif
+}
+
+SkinCache::SkinKey::SkinKey(Skin **skins, size_t count) : _skins(skins), _count(count), _hash((size_t) count) {
+	for (size_t i = 0; i < count; i++)
+		_hash = _hash * 31 + HashMapHasher<long long>::hash((long long) (size_t) skins[i]);
+}
+
+bool SkinCache::SkinKey::operator==(const SkinKey &other) const {
+	if (_hash != other._hash || _count != other._count) return false;
+	for (size_t i = 0; i < _count; i++)
+		if (_skins[i] != other._skins[i]) return false;
+	return true;
+}
+
+size_t SkinCache::SkinKey::hash() const {
+	return _hash;
+}
+
+SkinCache::SkinCache(SkeletonData *skeletonData) : _skeletonData(skeletonData), _scratchSkeleton(NULL), _hits(0),
+												   _misses(0) {
+}
+
+SkinCache::~SkinCache() {
+	clear();
+	if (_scratchSkeleton) delete _scratchSkeleton;
+}
+
+Skin *SkinCache::getSkin(Vector<Skin *> &skins) {
+	SkinKey key(skins.buffer(), skins.size());
+
+	SPINE_SKIN_CACHE_LOCK();
+	if (_composites.containsKey(key)) {
+		_hits++;
+		return _composites[key]->_skin;
+	}
+	_misses++;
+
+	String name;
+	for (size_t i = 0; i < skins.size(); i++) {
+		if (i > 0) name.append("+");
+		name.append(skins[i]->getName());
+	}
+	Composite *composite = new (__FILE__, __LINE__) Composite();
+	composite->_skins.addAll(skins);
+	composite->_skin = new (__FILE__, __LINE__) Skin(name.length() > 0 ? name : String("empty"));
+	for (size_t i = 0; i < skins.size(); i++)
+		composite->_skin->addSkin(skins[i]);
+
+	// Sort the update cache for the composite without changing the scratch skeleton's attachments, the stored order only
+	// depends on the skins.
+	if (!_scratchSkeleton) _scratchSkeleton = new (__FILE__, __LINE__) Skeleton(_skeletonData);
+	_scratchSkeleton->_skin = composite->_skin;
+	_scratchSkeleton->updateCache();
+	_scratchSkeleton->storeUpdateOrder(*composite->_skin);
+	_scratchSkeleton->_skin = NULL;
+
+	_composites.put(SkinKey(composite->_skins.buffer(), composite->_skins.size()), composite);
+	_compositeList.add(composite);
+	return composite->_skin;
+}
+
+void SkinCache::clear() {
+	SPINE_SKIN_CACHE_LOCK();
+	_composites.clear();
+	for (size_t i = 0; i < _compositeList.size(); i++) {
+		delete _compositeList[i]->_skin;
+		delete _compositeList[i];
+	}
+	_compositeList.clear();
+}
+
+SkeletonData *SkinCache::getSkeletonData() {
+	return _skeletonData;
+}
+
+size_t SkinCache::getSkinCount() {
+	return _compositeList.size();
+}
+
+int SkinCache::getHits() {
+	return _hits;
+}
+
+int SkinCache::getMisses() {
+	return _misses;
+}
@@ -56,7 +56,7 @@ void Slot::setToSetupPose() {
 	const String &attachmentName = _data.getAttachmentName();
 	if (attachmentName.length() > 0) {
 		_attachment = NULL;
-		setAttachment(_skeleton.getAttachment(_data.getIndex(), attachmentName));
+		setAttachment(_skeleton.getAttachment(_data.getIndex(), attachmentName, _data.getAttachmentNameHash()));
 	} else {
 		setAttachment(NULL);
 	}
@@ -40,6 +40,7 @@ SlotData::SlotData(int index, const String &name, BoneData &boneData) : _index(i
 																		_darkColor(0, 0, 0, 0),
 																		_hasDarkColor(false),
 																		_attachmentName(),
+																		_attachmentNameHash(_attachmentName.hash()),
 																		_blendMode(BlendMode_Normal) {
 	assert(_index >= 0);
 	assert(_name.length() > 0);
@@ -79,6 +80,11 @@ const String &SlotData::getAttachmentName() {
 
 void SlotData::setAttachmentName(const String &inValue) {
 	_attachmentName = inValue;
+	_attachmentNameHash = _attachmentName.hash();
+}
+
+size_t SlotData::getAttachmentNameHash() {
+	return _attachmentNameHash;
 }
 
 BlendMode SlotData::getBlendMode() {
@@ -43,6 +43,12 @@ namespace spine {
 	Timeline::~Timeline() {
 	}
 
+	void Timeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+							   MixBlend blend, MixDirection direction, int *cursor) {
+		SP_UNUSED(cursor);
+		apply(skeleton, lastTime, time, pEvents, alpha, blend, direction);
+	}
+
 	Vector<PropertyId> &Timeline::getPropertyIds() {
 		return _propertyIds;
 	}
@@ -63,6 +69,11 @@ namespace spine {
 		return _frames;
 	}
 
+	float Timeline::compress() {
+		_frames.shrinkToFit();
+		return 0;
+	}
+
 	size_t Timeline::getFrameEntries() {
 		return _frameEntries;
 	}
@@ -55,6 +55,11 @@ TransformConstraintTimeline::TransformConstraintTimeline(size_t frameCount, size
 
 void TransformConstraintTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
 										float alpha, MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void TransformConstraintTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
+											  float alpha, MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -88,7 +93,7 @@ void TransformConstraintTimeline::apply(Skeleton &skeleton, float lastTime, floa
 	}
 
 	float rotate, x, y, scaleX, scaleY, shearY;
-	int i = Animation::search(_frames, time, TransformConstraintTimeline::ENTRIES);
+	int i = Animation::search(_frames, time, TransformConstraintTimeline::ENTRIES, cursor);
 	int curveType = (int) _curves[i / TransformConstraintTimeline::ENTRIES];
 	switch (curveType) {
 		case TransformConstraintTimeline::LINEAR: {
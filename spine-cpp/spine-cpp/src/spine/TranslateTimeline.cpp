@@ -54,6 +54,11 @@ TranslateTimeline::~TranslateTimeline() {
 
 void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 							  MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void TranslateTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+									MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -77,7 +82,7 @@ void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 	}
 
 	float x = 0, y = 0;
-	int i = Animation::search(_frames, time, CurveTimeline2::ENTRIES);
+	int i = Animation::search(_frames, time, CurveTimeline2::ENTRIES, cursor);
 	int curveType = (int) _curves[i / CurveTimeline2::ENTRIES];
 	switch (curveType) {
 		case CurveTimeline::LINEAR: {
@@ -131,6 +136,11 @@ TranslateXTimeline::~TranslateXTimeline() {
 
 void TranslateXTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 							   MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void TranslateXTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+									 MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -151,7 +161,7 @@ void TranslateXTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 		return;
 	}
 
-	float x = getCurveValue(time);
+	float x = getCurveValue(time, cursor);
 	switch (blend) {
 		case MixBlend_Setup:
 			bone->_x = bone->_data._x + x * alpha;
@@ -179,6 +189,11 @@ TranslateYTimeline::~TranslateYTimeline() {
 
 void TranslateYTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 							   MixBlend blend, MixDirection direction) {
+	applyCursor(skeleton, lastTime, time, pEvents, alpha, blend, direction, NULL);
+}
+
+void TranslateYTimeline::applyCursor(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+									 MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -199,7 +214,7 @@ void TranslateYTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 		return;
 	}
 
-	float y = getCurveValue(time);
+	float y = getCurveValue(time, cursor);
 	switch (blend) {
 		case MixBlend_Setup:
 			bone->_y = bone->_data._y + y * alpha;
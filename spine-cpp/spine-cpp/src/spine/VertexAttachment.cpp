@@ -40,6 +40,8 @@ RTTI_IMPL(VertexAttachment, Attachment)
 
 VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0),
 														 _timelineAttachment(this), _id(getNextID()) {
+	for (int i = 0; i < MaxSkinningWidth; i++)
+		_skinCounts[i] = 0;
 }
 
 VertexAttachment::~VertexAttachment() {
@@ -58,6 +60,46 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 	computeWorldVertices(slot, start, count, worldVertices.buffer(), offset, stride);
 }
 
+namespace {
+	struct SkinningLayout {
+		const int *vertices, *deformStart;
+		const unsigned short *indices;
+		const float *xs, *ys, *weights;
+	};
+
+	/// Computes the world vertices of the layout vertices first to end, which all have Width bones. Reads the bone
+	/// matrices from a packed array of a, c, b, d, worldX, worldY per bone, so x and y are computed by the same vector
+	/// instructions where the compiler vectorizes. Returns the index of the next influence.
+	template<int Width>
+	size_t skin(const SkinningLayout &layout, size_t s, size_t first, size_t end, const float *matrices,
+				const float *deform, float *worldVertices, size_t offset, size_t stride) {
+		for (size_t i = first; i < end; i++, s += Width) {
+			float wx = 0, wy = 0;
+			for (int ii = 0; ii < Width; ii++) {
+				const float *matrix = matrices + layout.indices[s + ii] * 6;
+				float vx = layout.xs[s + ii], vy = layout.ys[s + ii], weight = layout.weights[s + ii];
+				if (deform) {
+					const float *offsets = deform + ((layout.deformStart[i] + ii) << 1);
+					vx += offsets[0];
+					vy += offsets[1];
+				}
+				wx += (vx * matrix[0] + vy * matrix[2] + matrix[4]) * weight;
+				wy += (vx * matrix[1] + vy * matrix[3] + matrix[5]) * weight;
+			}
+			size_t w = offset + layout.vertices[i] * stride;
+			worldVertices[w] = wx;
+			worldVertices[w + 1] = wy;
+		}
+		return s;
+	}
+
+	typedef size_t (*SkinFunction)(const SkinningLayout &layout, size_t s, size_t first, size_t end,
+								   const float *matrices, const float *deform, float *worldVertices, size_t offset,
+								   size_t stride);
+
+	const SkinFunction skinFunctions[] = {skin<1>, skin<2>, skin<3>, skin<4>, skin<5>, skin<6>, skin<7>, skin<8>};
+}
+
 void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
 											size_t stride) {
 	count = offset + (count >> 1) * stride;
@@ -81,6 +123,29 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 		return;
 	}
 
+	if (_skinWeights.size() > 0 && start == 0 && count == offset + (_worldVerticesLength >> 1) * stride) {
+		// Gather the matrices of the used bones so the fixed width loops read them from a packed array.
+		float matrices[MaxSkinningBones * 6];
+		Vector<Bone *> &skeletonBones = skeleton.getBones();
+		for (size_t i = 0, n = _skinBones.size(); i < n; i++) {
+			Bone &bone = *skeletonBones[_skinBones[i]];
+			float *matrix = matrices + i * 6;
+			matrix[0] = bone._a;
+			matrix[1] = bone._c;
+			matrix[2] = bone._b;
+			matrix[3] = bone._d;
+			matrix[4] = bone._worldX;
+			matrix[5] = bone._worldY;
+		}
+
+		SkinningLayout layout = {_skinVertices.buffer(), _skinDeform.buffer(), _skinIndices.buffer(), _skinX.buffer(),
+								 _skinY.buffer(), _skinWeights.buffer()};
+		const float *deform = deformArray->size() > 0 ? deformArray->buffer() : NULL;
+		for (size_t i = 0, s = 0, first = 0; i < MaxSkinningWidth; first += _skinCounts[i], i++)
+			s = skinFunctions[i](layout, s, first, first + _skinCounts[i], matrices, deform, worldVertices, offset, stride);
+		return;
+	}
+
 	int v = 0, skip = 0;
 	for (size_t i = 0; i < start; i += 2) {
 		int n = (int) bones[v];
@@ -164,4 +229,84 @@ void VertexAttachment::copyTo(VertexAttachment *other) {
 	other->_vertices.clearAndAddAll(this->_vertices);
 	other->_worldVerticesLength = this->_worldVerticesLength;
 	other->_timelineAttachment = this->_timelineAttachment;
+	copySkinningLayout(other);
+}
+
+void VertexAttachment::buildSkinningLayout() {
+	_skinBones.clear();
+	_skinVertices.clear();
+	_skinDeform.clear();
+	_skinIndices.clear();
+	_skinX.clear();
+	_skinY.clear();
+	_skinWeights.clear();
+	for (int i = 0; i < MaxSkinningWidth; i++)
+		_skinCounts[i] = 0;
+	if (_bones.size() == 0) return;
+
+	// Validate the bone counts and collect the used bones first, so no layout is left behind if it can't be built.
+	Vector<int> skinBones;
+	size_t counts[MaxSkinningWidth] = {0}, influences = 0;
+	for (size_t v = 0, n = _bones.size(); v < n;) {
+		size_t boneCount = _bones[v++];
+		if (boneCount == 0 || boneCount > MaxSkinningWidth) return;
+		counts[boneCount - 1]++;
+		influences += boneCount;
+		for (size_t end = v + boneCount; v < end; v++) {
+			int bone = (int) _bones[v];
+			if (!skinBones.contains(bone)) {
+				if (skinBones.size() == MaxSkinningBones) return;
+				skinBones.add(bone);
+			}
+		}
+	}
+
+	// Vertices are grouped by their number of bones, so each group is computed without padding or a variable loop.
+	_skinBones.clearAndAddAll(skinBones);
+	size_t vertexCount = 0;
+	for (int i = 0; i < MaxSkinningWidth; i++)
+		vertexCount += counts[i];
+	_skinVertices.setSize(vertexCount, 0);
+	_skinDeform.setSize(vertexCount, 0);
+	_skinIndices.setSize(influences, 0);
+	_skinX.setSize(influences, 0);
+	_skinY.setSize(influences, 0);
+	_skinWeights.setSize(influences, 0);
+	size_t groupVertex[MaxSkinningWidth], groupInfluence[MaxSkinningWidth];
+	for (size_t i = 0, vertex = 0, influence = 0; i < MaxSkinningWidth; i++) {
+		_skinCounts[i] = counts[i];
+		groupVertex[i] = vertex;
+		groupInfluence[i] = influence;
+		vertex += counts[i];
+		influence += counts[i] * (i + 1);
+	}
+	for (size_t v = 0, b = 0, vertex = 0, n = _bones.size(); v < n; vertex++) {
+		size_t boneCount = _bones[v++];
+		size_t i = groupVertex[boneCount - 1]++, s = groupInfluence[boneCount - 1];
+		groupInfluence[boneCount - 1] += boneCount;
+		_skinVertices[i] = (int) vertex;
+		_skinDeform[i] = (int) (b / 3);
+		for (size_t ii = 0; ii < boneCount; ii++, v++, b += 3, s++) {
+			_skinIndices[s] = (unsigned short) _skinBones.indexOf((int) _bones[v]);
+			_skinX[s] = _vertices[b];
+			_skinY[s] = _vertices[b + 1];
+			_skinWeights[s] = _vertices[b + 2];
+		}
+	}
+}
+
+bool VertexAttachment::hasSkinningLayout() {
+	return _skinWeights.size() > 0;
+}
+
+void VertexAttachment::copySkinningLayout(VertexAttachment *other) {
+	for (int i = 0; i < MaxSkinningWidth; i++)
+		other->_skinCounts[i] = _skinCounts[i];
+	other->_skinBones.clearAndAddAll(_skinBones);
+	other->_skinVertices.clearAndAddAll(_skinVertices);
+	other->_skinIndices.clearAndAddAll(_skinIndices);
+	other->_skinX.clearAndAddAll(_skinX);
+	other->_skinY.clearAndAddAll(_skinY);
+	other->_skinWeights.clearAndAddAll(_skinWeights);
+	other->_skinDeform.clearAndAddAll(_skinDeform);
 }
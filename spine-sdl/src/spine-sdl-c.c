@@ -65,12 +65,37 @@ void spSkeletonDrawable_update(spSkeletonDrawable *self, float delta) {
 	spSkeleton_updateWorldTransform(self->skeleton);
 }
 
+static SDL_BlendMode _toSdlBlendMode(spBlendMode blendMode) {
+	switch (blendMode) {
+		case SP_BLEND_MODE_MULTIPLY:
+			return SDL_BLENDMODE_MOD;
+		case SP_BLEND_MODE_ADDITIVE:
+			return SDL_BLENDMODE_ADD;
+		default:
+			return SDL_BLENDMODE_BLEND;
+	}
+}
+
+static void _spSkeletonDrawable_flush(spSkeletonDrawable *self, struct SDL_Renderer *renderer, SDL_Texture *texture, SDL_BlendMode blendMode) {
+	if (self->sdlIndices->size == 0) return;
+	SDL_SetTextureBlendMode(texture, blendMode);
+	SDL_RenderGeometry(renderer, texture, self->sdlVertices->items, self->sdlVertices->size, self->sdlIndices->items,
+					   self->sdlIndices->size);
+	spSdlVertexArray_clear(self->sdlVertices);
+	spIntArray_clear(self->sdlIndices);
+}
+
 void spSkeletonDrawable_draw(spSkeletonDrawable *self, struct SDL_Renderer *renderer) {
 	static unsigned short quadIndices[] = {0, 1, 2, 2, 3, 0};
 	spSkeleton *skeleton = self->skeleton;
 	spSkeletonClipping *clipper = self->clipper;
 	SDL_Texture *texture;
 	SDL_Vertex sdlVertex;
+	// Consecutive slots with the same texture and blend mode are drawn with a single call.
+	SDL_Texture *batchTexture = NULL;
+	SDL_BlendMode batchBlendMode = SDL_BLENDMODE_BLEND;
+	spSdlVertexArray_clear(self->sdlVertices);
+	spIntArray_clear(self->sdlIndices);
 	for (int i = 0; i < skeleton->slotsCount; ++i) {
 		spSlot *slot = skeleton->drawOrder[i];
 		spAttachment *attachment = slot->attachment;
@@ -148,7 +173,14 @@ void spSkeletonDrawable_draw(spSkeletonDrawable *self, struct SDL_Renderer *rend
 			indicesCount = clipper->clippedTriangles->size;
 		}
 
-		spSdlVertexArray_clear(self->sdlVertices);
+		SDL_BlendMode blendMode = _toSdlBlendMode(slot->data->blendMode);
+		if (texture != batchTexture || blendMode != batchBlendMode) {
+			_spSkeletonDrawable_flush(self, renderer, batchTexture, batchBlendMode);
+			batchTexture = texture;
+			batchBlendMode = blendMode;
+		}
+
+		int firstVertex = self->sdlVertices->size;
 		for (int ii = 0; ii < verticesCount << 1; ii += 2) {
 			sdlVertex.position.x = vertices->items[ii];
 			sdlVertex.position.y = vertices->items[ii + 1];
@@ -156,29 +188,12 @@ void spSkeletonDrawable_draw(spSkeletonDrawable *self, struct SDL_Renderer *rend
 			sdlVertex.tex_coord.y = uvs[ii + 1];
 			spSdlVertexArray_add(self->sdlVertices, sdlVertex);
 		}
-		spIntArray_clear(self->sdlIndices);
 		for (int ii = 0; ii < (int) indicesCount; ii++)
-			spIntArray_add(self->sdlIndices, indices[ii]);
-
-		switch (slot->data->blendMode) {
-			case SP_BLEND_MODE_NORMAL:
-				SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-				break;
-			case SP_BLEND_MODE_MULTIPLY:
-				SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_MOD);
-				break;
-			case SP_BLEND_MODE_ADDITIVE:
-				SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_ADD);
-				break;
-			case SP_BLEND_MODE_SCREEN:
-				SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-				break;
-		}
+			spIntArray_add(self->sdlIndices, firstVertex + indices[ii]);
 
-		SDL_RenderGeometry(renderer, texture, self->sdlVertices->items, self->sdlVertices->size, self->sdlIndices->items,
-						   indicesCount);
 		spSkeletonClipping_clipEnd(clipper, slot);
 	}
+	_spSkeletonDrawable_flush(self, renderer, batchTexture, batchBlendMode);
 	spSkeletonClipping_clipEnd2(clipper);
 }
 
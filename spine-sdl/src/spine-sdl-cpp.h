@@ -49,10 +49,7 @@ namespace spine {
 
 	private:
 		bool ownsAnimationStateData;
-		SkeletonClipping clipper;
-		Vector<float> worldVertices;
-		Vector<SDL_Vertex> sdlVertices;
-		Vector<int> sdlIndices;
+		SkeletonRenderer skeletonRenderer;
 	};
 
 	class SDLTextureLoader : public spine::TextureLoader {